@@ -60,6 +60,10 @@ function(find_package_esl)
     find_custom_package(esl https://github.com/SLukasDE/esl master)
 endfunction()
 
+function(find_package_GTest) # GTest::gtest
+    find_custom_package(GTest https://github.com/google/googletest v1.14.0)
+endfunction()
+
 
 function(find_package_ODBC) # ODBC::ODBC
     # Default, try 'find_package'. VCPKG or Conan may be used, if enabled
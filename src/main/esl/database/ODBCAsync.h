@@ -0,0 +1,129 @@
+#ifndef ESL_DATABASE_ODBCASYNC_H_
+#define ESL_DATABASE_ODBCASYNC_H_
+
+/* Requires the CMake option ODBC4ESL_COROUTINES, the header is empty otherwise */
+#if defined(ODBC4ESL_COROUTINES) && __cplusplus >= 202002L && __has_include(<coroutine>)
+
+#include <esl/database/Field.h>
+#include <esl/database/ODBCConnection.h>
+#include <esl/database/ODBCDeadline.h>
+#include <esl/database/ODBCExecutor.h>
+#include <esl/database/ODBCPreparedStatement.h>
+#include <esl/database/ODBCProjection.h>
+#include <esl/database/ODBCResultSet.h>
+
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace esl {
+inline namespace v1_6 {
+namespace database {
+
+/* Awaitable of a blocking call that is submitted as job to an ODBCExecutor with the affinity key of the caller.
+ * The awaiting coroutine is suspended, so the thread of the caller (e.g. of an event loop) is not blocked.
+ * It is resumed by the completion of the job, i.e. on the thread that calls ODBCExecutor::runCompletions().
+ * An exception of the call is thrown by co_await. The deadline of the awaiting thread (see ODBCDeadline) applies to the call as well.
+ * Statements and result sets belong to the connection of the worker of the affinity key, so they must be awaited with the same key. */
+template<typename Result>
+class ODBCAwaitable {
+public:
+	ODBCAwaitable(ODBCExecutor& aExecutor, std::size_t aAffinity, std::function<Result(ODBCConnection&)> aCall)
+	: executor(aExecutor),
+	  affinity(aAffinity),
+	  call(std::move(aCall)),
+	  hasDeadline(ODBCDeadline::get(deadline))
+	{ }
+
+	bool await_ready() const noexcept {
+		return false;
+	}
+
+	void await_suspend(std::coroutine_handle<> handle) {
+		executor.submit(affinity, [this](ODBCConnection& connection) {
+			if(hasDeadline) {
+				ODBCDeadline callDeadline(deadline);
+				result.emplace(call(connection));
+			}
+			else {
+				result.emplace(call(connection));
+			}
+		}, [this, handle](std::exception_ptr aException) {
+			exception = aException;
+			handle.resume();
+		});
+	}
+
+	Result await_resume() {
+		if(exception) {
+			std::rethrow_exception(exception);
+		}
+		return std::move(*result);
+	}
+
+private:
+	ODBCExecutor& executor;
+	std::size_t affinity;
+	std::function<Result(ODBCConnection&)> call;
+	std::chrono::steady_clock::time_point deadline;
+	bool hasDeadline;
+	std::optional<Result> result;
+	std::exception_ptr exception;
+};
+
+/* co_await prepareAsync(executor, affinity, sql) prepares the statement on the connection of the worker of the affinity key */
+inline ODBCAwaitable<std::unique_ptr<ODBCPreparedStatement>> prepareAsync(ODBCExecutor& executor, std::size_t affinity, std::string sql) {
+	return ODBCAwaitable<std::unique_ptr<ODBCPreparedStatement>>(executor, affinity, [sql = std::move(sql)](ODBCConnection& connection) {
+		return connection.prepareODBC(sql);
+	});
+}
+
+/* co_await executeAsync(executor, affinity, statement, fields) executes the prepared statement like ODBCPreparedStatement::executeODBC() */
+inline ODBCAwaitable<std::unique_ptr<ODBCResultSet>> executeAsync(ODBCExecutor& executor, std::size_t affinity, ODBCPreparedStatement& statement, std::vector<Field> fields) {
+	return ODBCAwaitable<std::unique_ptr<ODBCResultSet>>(executor, affinity, [&statement, fields = std::move(fields)](ODBCConnection&) {
+		return statement.executeODBC(fields);
+	});
+}
+
+inline ODBCAwaitable<std::unique_ptr<ODBCResultSet>> executeAsync(ODBCExecutor& executor, std::size_t affinity, ODBCPreparedStatement& statement, std::vector<Field> fields, ODBCProjection projection) {
+	return ODBCAwaitable<std::unique_ptr<ODBCResultSet>>(executor, affinity, [&statement, fields = std::move(fields), projection = std::move(projection)](ODBCConnection&) {
+		return statement.executeODBC(fields, projection);
+	});
+}
+
+/* co_await fetchBatchAsync(executor, affinity, resultSet, rows, maximumRows) fetches up to maximumRows rows with one suspension,
+ * so a coroutine is not resumed per row. The rows and their fields are reused, rows is resized to the
+ * number of fetched rows. Fewer rows than maximumRows means there are no more rows. */
+inline ODBCAwaitable<std::size_t> fetchBatchAsync(ODBCExecutor& executor, std::size_t affinity, ODBCResultSet& resultSet, std::vector<std::vector<Field>>& rows, std::size_t maximumRows) {
+	return ODBCAwaitable<std::size_t>(executor, affinity, [&resultSet, &rows, maximumRows](ODBCConnection&) {
+		const std::size_t columnCount = resultSet.getColumns().size();
+		std::size_t count = 0;
+
+		rows.resize(maximumRows);
+		while(count < maximumRows) {
+			rows[count].resize(columnCount);
+			if(!resultSet.fetch(rows[count])) {
+				break;
+			}
+			++count;
+		}
+		rows.resize(count);
+
+		return count;
+	});
+}
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace esl */
+
+#endif /* ODBC4ESL_COROUTINES */
+
+#endif /* ESL_DATABASE_ODBCASYNC_H_ */
@@ -0,0 +1,136 @@
+#include <esl/database/ODBCCallCounters.h>
+
+#include <odbc4esl/database/CallCounters.h>
+#include <odbc4esl/database/Connection.h>
+
+#include <locale>
+#include <sstream>
+#include <stdexcept>
+
+namespace esl {
+inline namespace v1_6 {
+namespace database {
+
+constexpr std::size_t ODBCCallCounters::functionCount;
+
+ODBCCallCounters::Counter& ODBCCallCounters::Counters::operator[](Function function) noexcept {
+	return counters[static_cast<std::size_t>(function)];
+}
+
+const ODBCCallCounters::Counter& ODBCCallCounters::Counters::operator[](Function function) const noexcept {
+	return counters[static_cast<std::size_t>(function)];
+}
+
+std::uint64_t ODBCCallCounters::Counters::getTotalCalls() const noexcept {
+	std::uint64_t totalCalls = 0;
+	for(const auto& counter : counters) {
+		totalCalls += counter.calls;
+	}
+	return totalCalls;
+}
+
+std::string ODBCCallCounters::Counters::toString() const {
+	std::ostringstream stream;
+	stream.imbue(std::locale::classic());
+
+	for(std::size_t i = 0; i < functionCount; ++i) {
+		if(counters[i].calls == 0) {
+			continue;
+		}
+		stream << getFunctionName(static_cast<Function>(i)) << ": " << counters[i].calls << " calls, "
+				<< (static_cast<double>(counters[i].nanoseconds) / 1000000000.0) << " s\n";
+	}
+
+	return stream.str();
+}
+
+const char* ODBCCallCounters::getFunctionName(Function function) noexcept {
+	switch(function) {
+	case Function::allocHandle:
+		return "SQLAllocHandle";
+	case Function::freeHandle:
+		return "SQLFreeHandle";
+	case Function::freeStmt:
+		return "SQLFreeStmt";
+	case Function::setEnvAttr:
+		return "SQLSetEnvAttr";
+	case Function::setConnectAttr:
+		return "SQLSetConnectAttr";
+	case Function::driverConnect:
+		return "SQLDriverConnect";
+	case Function::endTran:
+		return "SQLEndTran";
+	case Function::disconnect:
+		return "SQLDisconnect";
+	case Function::getDiagRec:
+		return "SQLGetDiagRec";
+	case Function::prepare:
+		return "SQLPrepare";
+	case Function::numResultCols:
+		return "SQLNumResultCols";
+	case Function::numParams:
+		return "SQLNumParams";
+	case Function::describeCol:
+		return "SQLDescribeCol";
+	case Function::colAttribute:
+		return "SQLColAttribute";
+	case Function::describeParam:
+		return "SQLDescribeParam";
+	case Function::bindParameter:
+		return "SQLBindParameter";
+	case Function::bindCol:
+		return "SQLBindCol";
+	case Function::getData:
+		return "SQLGetData";
+	case Function::execute:
+		return "SQLExecute";
+	case Function::fetch:
+		return "SQLFetch";
+	case Function::moreResults:
+		return "SQLMoreResults";
+	case Function::execDirect:
+		return "SQLExecDirect";
+	case Function::setStmtAttr:
+		return "SQLSetStmtAttr";
+	case Function::cancel:
+		return "SQLCancel";
+	case Function::count:
+		break;
+	}
+	return "unknown";
+}
+
+bool ODBCCallCounters::isEnabled() noexcept {
+	return odbc4esl::database::CallCounters::isEnabled();
+}
+
+void ODBCCallCounters::setEnabled(bool enabled) noexcept {
+	odbc4esl::database::CallCounters::setEnabled(enabled);
+}
+
+ODBCCallCounters::Counters ODBCCallCounters::getThreadCounters() {
+	return odbc4esl::database::CallCounters::getThreadCounters();
+}
+
+void ODBCCallCounters::resetThreadCounters() {
+	odbc4esl::database::CallCounters::resetThreadCounters();
+}
+
+ODBCCallCounters::Counters ODBCCallCounters::getGlobalCounters() {
+	return odbc4esl::database::CallCounters::getGlobalCounters();
+}
+
+ODBCCallCounters::Counters ODBCCallCounters::getConnectionCounters(const Connection& connection) {
+	const odbc4esl::database::Connection* odbcConnection = dynamic_cast<const odbc4esl::database::Connection*>(&connection);
+	if(!odbcConnection) {
+		throw std::runtime_error("Connection is not an ODBC connection");
+	}
+
+	Counters counters;
+	odbcConnection->getCallCounters().getCounters(counters);
+	return counters;
+}
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace esl */
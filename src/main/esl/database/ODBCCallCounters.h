@@ -0,0 +1,91 @@
+#ifndef ESL_DATABASE_ODBCCALLCOUNTERS_H_
+#define ESL_DATABASE_ODBCCALLCOUNTERS_H_
+
+#include <esl/database/Connection.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace esl {
+inline namespace v1_6 {
+namespace database {
+
+/* Number of calls and time spent per ODBC function. Counting is disabled by default.
+ * Thread counters can be used to see the ODBC calls of a single logical query, e.g.
+ * resetThreadCounters(), execute and fetch the query, getThreadCounters(). */
+class ODBCCallCounters {
+public:
+	enum class Function {
+		allocHandle,
+		freeHandle,
+		freeStmt,
+		setEnvAttr,
+		setConnectAttr,
+		driverConnect,
+		endTran,
+		disconnect,
+		getDiagRec,
+		prepare,
+		numResultCols,
+		numParams,
+		describeCol,
+		colAttribute,
+		describeParam,
+		bindParameter,
+		bindCol,
+		getData,
+		execute,
+		fetch,
+		moreResults,
+		execDirect,
+		setStmtAttr,
+		cancel,
+
+		/* number of functions, has to be the last enumerator */
+		count
+	};
+
+	static constexpr std::size_t functionCount = static_cast<std::size_t>(Function::count);
+
+	struct Counter {
+		std::uint64_t calls = 0;
+		std::uint64_t nanoseconds = 0;
+	};
+
+	struct Counters {
+		std::array<Counter, functionCount> counters;
+
+		Counter& operator[](Function function) noexcept;
+		const Counter& operator[](Function function) const noexcept;
+
+		std::uint64_t getTotalCalls() const noexcept;
+
+		/* one line per function that has been called at least once, e.g. "SQLFetch: 12 calls, 0.000034 s" */
+		std::string toString() const;
+	};
+
+	/* ODBC function name, e.g. "SQLFetch" */
+	static const char* getFunctionName(Function function) noexcept;
+
+	static bool isEnabled() noexcept;
+	static void setEnabled(bool enabled) noexcept;
+
+	/* counters of the calling thread since the last call of resetThreadCounters() */
+	static Counters getThreadCounters();
+	static void resetThreadCounters();
+
+	/* counters of all threads since process start */
+	static Counters getGlobalCounters();
+
+	/* counters of all calls made for the connection and its statements.
+	 * Throws std::runtime_error if the connection is not an ODBC connection. */
+	static Counters getConnectionCounters(const Connection& connection);
+};
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace esl */
+
+#endif /* ESL_DATABASE_ODBCCALLCOUNTERS_H_ */
@@ -0,0 +1,34 @@
+#ifndef ESL_DATABASE_ODBCCONNECTION_H_
+#define ESL_DATABASE_ODBCCONNECTION_H_
+
+#include <esl/database/Connection.h>
+#include <esl/database/Field.h>
+#include <esl/database/ODBCPreparedBulkStatement.h>
+#include <esl/database/ODBCPreparedStatement.h>
+#include <esl/database/ODBCResultSet.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace esl {
+inline namespace v1_6 {
+namespace database {
+
+/* Connections created by ODBCConnectionFactory implement this interface to provide ODBC specific extensions. */
+class ODBCConnection : public Connection {
+public:
+	virtual std::unique_ptr<ODBCPreparedStatement> prepareODBC(const std::string& sql) const = 0;
+	virtual std::unique_ptr<ODBCPreparedBulkStatement> prepareBulkODBC(const std::string& sql) const = 0;
+
+	/* Executes a one-shot statement by SQLExecDirect without preparing and describing it first.
+	 * Parameter types are taken from the given fields. Result columns are described only if there is a result set.
+	 * Returns nullptr if the execution has no result set. */
+	virtual std::unique_ptr<ODBCResultSet> executeDirect(const std::string& sql, const std::vector<Field>& parameterValues = std::vector<Field>()) const = 0;
+};
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace esl */
+
+#endif /* ESL_DATABASE_ODBCCONNECTION_H_ */
@@ -1,5 +1,6 @@
 #include <esl/database/ODBCConnectionFactory.h>
 
+#include <odbc4esl/database/Connection.h>
 #include <odbc4esl/database/ConnectionFactory.h>
 
 #include <stdexcept>
@@ -8,9 +9,25 @@ namespace esl {
 inline namespace v1_6 {
 namespace database {
 
+namespace {
+bool toBool(const std::pair<std::string, std::string>& setting) {
+	if(setting.second == "true") {
+		return true;
+	}
+	if(setting.second == "false") {
+		return false;
+	}
+	throw std::runtime_error("Invalid value \"" + setting.second + "\" for parameter key \"" + setting.first + "\" at ODBCConnectionFactory");
+}
+}
+
 ODBCConnectionFactory::Settings::Settings(const std::vector<std::pair<std::string, std::string>>& settings) {
 	bool hasDefaultBufferSize = false;
 	bool hasMaximumBufferSize = false;
+	bool hasStatementHandlePoolSize = false;
+	bool hasSlowStatementThreshold = false;
+	bool hasSlowStatementCaptureParams = false;
+	bool hasSlowStatementRedactParams = false;
 
 	for(const auto& setting : settings) {
 		if(setting.first == "connection-string" || setting.first == "connectionString") {
@@ -36,6 +53,61 @@ ODBCConnectionFactory::Settings::Settings(const std::vector<std::pair<std::strin
 			hasMaximumBufferSize = true;
 			maximumBufferSize = std::stoi(setting.second);
 		}
+		else if(setting.first == "statement-handle-pool-size") {
+			if(hasStatementHandlePoolSize) {
+				throw std::runtime_error("Multiple definition of parameter key \"" + setting.first + "\" at ODBCConnectionFactory");
+			}
+			hasStatementHandlePoolSize = true;
+			statementHandlePoolSize = std::stoi(setting.second);
+		}
+		else if(setting.first == "success-with-info-log-interval") {
+			if(hasSuccessWithInfoLogInterval) {
+				throw std::runtime_error("Multiple definition of parameter key \"" + setting.first + "\" at ODBCConnectionFactory");
+			}
+			hasSuccessWithInfoLogInterval = true;
+			successWithInfoLogInterval = std::stoi(setting.second);
+		}
+		else if(setting.first == "success-with-info-muted-state") {
+			if(setting.second.empty()) {
+				throw std::runtime_error("Invalid value \"\" for parameter key \"" + setting.first + "\" at ODBCConnectionFactory");
+			}
+			successWithInfoMutedStates.insert(setting.second);
+		}
+		else if(setting.first == "metrics") {
+			if(hasMetricsEnabled) {
+				throw std::runtime_error("Multiple definition of parameter key \"" + setting.first + "\" at ODBCConnectionFactory");
+			}
+			hasMetricsEnabled = true;
+			metricsEnabled = toBool(setting);
+		}
+		else if(setting.first == "call-counters") {
+			if(hasCallCounters) {
+				throw std::runtime_error("Multiple definition of parameter key \"" + setting.first + "\" at ODBCConnectionFactory");
+			}
+			hasCallCounters = true;
+			callCounters = toBool(setting);
+		}
+		else if(setting.first == "slow-statement-threshold-ms") {
+			if(hasSlowStatementThreshold) {
+				throw std::runtime_error("Multiple definition of parameter key \"" + setting.first + "\" at ODBCConnectionFactory");
+			}
+			hasSlowStatementThreshold = true;
+			slowStatementThreshold = std::stoi(setting.second);
+		}
+		else if(setting.first == "slow-statement-capture-params") {
+			if(hasSlowStatementCaptureParams) {
+				throw std::runtime_error("Multiple definition of parameter key \"" + setting.first + "\" at ODBCConnectionFactory");
+			}
+			hasSlowStatementCaptureParams = true;
+			slowStatementCaptureParams = toBool(setting);
+		}
+		else if(setting.first == "slow-statement-redact-params") {
+			if(hasSlowStatementRedactParams) {
+				throw std::runtime_error("Multiple definition of parameter key \"" + setting.first + "\" at ODBCConnectionFactory");
+			}
+			hasSlowStatementRedactParams = true;
+			slowStatementRedactParams = toBool(setting);
+		}
 		else {
 			throw std::runtime_error("Key \"" + setting.first + "\" is unknown");
 		}
@@ -58,6 +130,10 @@ std::unique_ptr<Connection> ODBCConnectionFactory::createConnection() {
 	return connectionFactory->createConnection();
 }
 
+std::unique_ptr<ODBCConnection> ODBCConnectionFactory::createODBCConnection() {
+	return std::unique_ptr<ODBCConnection>(new odbc4esl::database::Connection(static_cast<const odbc4esl::database::ConnectionFactory&>(*connectionFactory)));
+}
+
 } /* namespace database */
 } /* inline namespace v1_6 */
 } /* namespace esl */
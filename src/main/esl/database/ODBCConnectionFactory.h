@@ -3,8 +3,10 @@
 
 #include <esl/database/Connection.h>
 #include <esl/database/ConnectionFactory.h>
+#include <esl/database/ODBCConnection.h>
 
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -21,6 +23,26 @@ public:
 		std::string connectionString;
 		std::size_t defaultBufferSize = 65536;
 		std::size_t maximumBufferSize = 65536;
+		std::size_t statementHandlePoolSize = 8;
+
+		/* SQL_SUCCESS_WITH_INFO diagnostics are logged as summary at most once per interval (milliseconds).
+		 * The interval is process wide, so it is applied only if it has been given explicitly. */
+		std::size_t successWithInfoLogInterval = 60000;
+		bool hasSuccessWithInfoLogInterval = false;
+		std::set<std::string> successWithInfoMutedStates;
+
+		/* per statement latency histograms and counters, see ODBCMetrics. Process wide, applied only if given explicitly. */
+		bool metricsEnabled = true;
+		bool hasMetricsEnabled = false;
+
+		/* count and time every ODBC function call, see ODBCCallCounters. Process wide, applied only if given explicitly. */
+		bool callCounters = false;
+		bool hasCallCounters = false;
+
+		/* statements exceeding the threshold (milliseconds, 0 disables) for execute or execute and drain are logged */
+		std::size_t slowStatementThreshold = 0;
+		bool slowStatementCaptureParams = false;
+		bool slowStatementRedactParams = false;
 	};
 
 	ODBCConnectionFactory(const Settings& settings);
@@ -28,6 +50,7 @@ public:
 	static std::unique_ptr<ConnectionFactory> create(const std::vector<std::pair<std::string, std::string>>& settings);
 
     std::unique_ptr<Connection> createConnection() override;
+    std::unique_ptr<ODBCConnection> createODBCConnection();
 
 private:
 	std::unique_ptr<ConnectionFactory> connectionFactory;
@@ -0,0 +1,36 @@
+#include <esl/database/ODBCDeadline.h>
+
+namespace esl {
+inline namespace v1_6 {
+namespace database {
+
+namespace {
+thread_local const ODBCDeadline* currentDeadline = nullptr;
+}
+
+ODBCDeadline::ODBCDeadline(std::chrono::steady_clock::time_point aDeadline)
+: previous(currentDeadline),
+  deadline(previous && previous->deadline < aDeadline ? previous->deadline : aDeadline)
+{
+	currentDeadline = this;
+}
+
+ODBCDeadline::ODBCDeadline(std::chrono::milliseconds timeout)
+: ODBCDeadline(std::chrono::steady_clock::now() + timeout)
+{ }
+
+ODBCDeadline::~ODBCDeadline() {
+	currentDeadline = previous;
+}
+
+bool ODBCDeadline::get(std::chrono::steady_clock::time_point& deadline) noexcept {
+	if(!currentDeadline) {
+		return false;
+	}
+	deadline = currentDeadline->deadline;
+	return true;
+}
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace esl */
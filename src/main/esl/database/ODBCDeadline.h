@@ -0,0 +1,35 @@
+#ifndef ESL_DATABASE_ODBCDEADLINE_H_
+#define ESL_DATABASE_ODBCDEADLINE_H_
+
+#include <chrono>
+
+namespace esl {
+inline namespace v1_6 {
+namespace database {
+
+/* Deadline for the ODBC calls of the current thread while the object exists, e.g. for a request.
+ * Statements are executed with the remaining time as query timeout, rounded up to seconds.
+ * Executions, fetches and commits throw an exception if the deadline has passed before they start.
+ * A nested deadline cannot extend the deadline of an outer one. */
+class ODBCDeadline {
+public:
+	explicit ODBCDeadline(std::chrono::steady_clock::time_point deadline);
+	explicit ODBCDeadline(std::chrono::milliseconds timeout);
+	~ODBCDeadline();
+
+	ODBCDeadline(const ODBCDeadline&) = delete;
+	ODBCDeadline& operator=(const ODBCDeadline&) = delete;
+
+	/* Returns false if the current thread has no deadline */
+	static bool get(std::chrono::steady_clock::time_point& deadline) noexcept;
+
+private:
+	const ODBCDeadline* previous;
+	std::chrono::steady_clock::time_point deadline;
+};
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace esl */
+
+#endif /* ESL_DATABASE_ODBCDEADLINE_H_ */
@@ -0,0 +1,130 @@
+#ifndef ESL_DATABASE_ODBCDECODER_H_
+#define ESL_DATABASE_ODBCDECODER_H_
+
+#include <esl/database/Column.h>
+#include <esl/database/ODBCRowLayout.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#if __cplusplus >= 201703L
+#include <optional>
+#endif
+
+namespace esl {
+inline namespace v1_6 {
+namespace database {
+
+/* Decoder of a single column value into a C++ type. accepts() is checked once per column,
+ * so decode() reads the bound value of an ODBCResultSet without dispatching on the column type.
+ * Numbers can be decoded from character columns, they are parsed without allocations.
+ * decode() returns false if the value is NULL. */
+template<typename T>
+struct ODBCDecoder;
+
+template<>
+struct ODBCDecoder<std::int64_t> {
+	static constexpr bool nullable = false;
+
+	static bool accepts(ODBCRowColumn::Type type) noexcept {
+		return type == ODBCRowColumn::Type::integer || type == ODBCRowColumn::Type::character;
+	}
+
+	template<typename ResultSet>
+	static bool decode(ResultSet& resultSet, std::size_t column, std::int64_t& value) {
+		return resultSet.getInteger(column, value);
+	}
+};
+
+template<>
+struct ODBCDecoder<double> {
+	static constexpr bool nullable = false;
+
+	static bool accepts(ODBCRowColumn::Type /*type*/) noexcept {
+		return true;
+	}
+
+	template<typename ResultSet>
+	static bool decode(ResultSet& resultSet, std::size_t column, double& value) {
+		return resultSet.getDouble(column, value);
+	}
+};
+
+template<>
+struct ODBCDecoder<std::string> {
+	static constexpr bool nullable = false;
+
+	static bool accepts(ODBCRowColumn::Type type) noexcept {
+		return type == ODBCRowColumn::Type::character;
+	}
+
+	template<typename ResultSet>
+	static bool decode(ResultSet& resultSet, std::size_t column, std::string& value) {
+		return resultSet.getString(column, value);
+	}
+};
+
+#if __cplusplus >= 201703L
+template<typename T>
+struct ODBCDecoder<std::optional<T>> {
+	static constexpr bool nullable = true;
+
+	static bool accepts(ODBCRowColumn::Type type) noexcept {
+		return ODBCDecoder<T>::accepts(type);
+	}
+
+	template<typename ResultSet>
+	static bool decode(ResultSet& resultSet, std::size_t column, std::optional<T>& value) {
+		/* a contained value is reused, e.g. to keep the capacity of a string */
+		if(!ODBCDecoder<T>::decode(resultSet, column, value ? *value : value.emplace())) {
+			value.reset();
+		}
+		return true;
+	}
+};
+#endif
+
+/* Checks and decodes all elements of a std::tuple, one ODBCDecoder per element */
+template<typename Tuple, std::size_t Index = 0, bool End = (Index == std::tuple_size<Tuple>::value)>
+struct ODBCTupleDecoder {
+	using Element = typename std::tuple_element<Index, Tuple>::type;
+
+	/* Throws std::runtime_error if the tuple does not match the columns */
+	static void check(const std::vector<Column>& columns) {
+		if(Index == 0 && columns.size() < std::tuple_size<Tuple>::value) {
+			throw std::runtime_error("Tuple has " + std::to_string(std::tuple_size<Tuple>::value) + " elements, but there are " + std::to_string(columns.size()) + " columns.");
+		}
+		if(!ODBCDecoder<Element>::accepts(ODBCRowColumn::getType(columns[Index].getType()))) {
+			throw std::runtime_error("Tuple element " + std::to_string(Index) + " does not match the type of column \"" + columns[Index].getName() + "\".");
+		}
+		ODBCTupleDecoder<Tuple, Index+1>::check(columns);
+	}
+
+	template<typename ResultSet>
+	static void decode(ResultSet& resultSet, Tuple& row) {
+		if(!ODBCDecoder<Element>::decode(resultSet, Index, std::get<Index>(row)) && !ODBCDecoder<Element>::nullable) {
+			throw std::runtime_error("Column \"" + resultSet.getColumns()[Index].getName() + "\" is NULL, but tuple element " + std::to_string(Index) + " is not optional.");
+		}
+		ODBCTupleDecoder<Tuple, Index+1>::decode(resultSet, row);
+	}
+};
+
+template<typename Tuple, std::size_t Index>
+struct ODBCTupleDecoder<Tuple, Index, true> {
+	static void check(const std::vector<Column>& /*columns*/) {
+	}
+
+	template<typename ResultSet>
+	static void decode(ResultSet& /*resultSet*/, Tuple& /*row*/) {
+	}
+};
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace esl */
+
+#endif /* ESL_DATABASE_ODBCDECODER_H_ */
@@ -0,0 +1,19 @@
+#include <esl/database/ODBCExecutor.h>
+
+#include <odbc4esl/database/Executor.h>
+
+namespace esl {
+inline namespace v1_6 {
+namespace database {
+
+std::unique_ptr<ODBCExecutor> ODBCExecutor::create(ODBCConnectionFactory& connectionFactory, const Settings& settings) {
+	return std::unique_ptr<ODBCExecutor>(new odbc4esl::database::Executor(connectionFactory, settings));
+}
+
+std::unique_ptr<ODBCExecutor> ODBCExecutor::create(ODBCConnectionFactory& connectionFactory) {
+	return create(connectionFactory, Settings());
+}
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace esl */
@@ -0,0 +1,58 @@
+#ifndef ESL_DATABASE_ODBCEXECUTOR_H_
+#define ESL_DATABASE_ODBCEXECUTOR_H_
+
+#include <esl/database/ODBCConnection.h>
+#include <esl/database/ODBCConnectionFactory.h>
+
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+
+namespace esl {
+inline namespace v1_6 {
+namespace database {
+
+/* Runs blocking ODBC calls on worker threads for event loops, without a thread per request.
+ * Every worker owns one connection, jobs get the connection of the worker that runs them.
+ * Completions are queued and run by the event loop thread itself: the completion file descriptor becomes
+ * readable if completions are pending, so it can be added to epoll, poll or select, and runCompletions() runs them.
+ * The file descriptor is an eventfd on Linux and a pipe on other POSIX systems. */
+class ODBCExecutor {
+public:
+	struct Settings {
+		std::size_t workerCount = 4;
+	};
+
+	/* Jobs may throw exceptions, they are passed to the completion. Otherwise the completion gets nullptr. */
+	using Job = std::function<void(ODBCConnection& connection)>;
+	using Completion = std::function<void(std::exception_ptr exception)>;
+
+	/* The connections of the workers are created by the factory before create() returns */
+	static std::unique_ptr<ODBCExecutor> create(ODBCConnectionFactory& connectionFactory, const Settings& settings);
+	static std::unique_ptr<ODBCExecutor> create(ODBCConnectionFactory& connectionFactory);
+
+	/* The destructor runs the remaining jobs and joins the workers. Pending completions are not run anymore. */
+	virtual ~ODBCExecutor() = default;
+
+	/* Runs the job on the worker of the affinity key, e.g. of a session, so it gets the same connection as the previous
+	 * jobs of the key, e.g. to reuse prepared statements or to continue a transaction. Jobs of a key are run in order. */
+	virtual void submit(std::size_t affinity, Job job, Completion completion) = 0;
+
+	/* Runs the job on any worker. Jobs are distributed round robin and idle workers steal them from busy ones. */
+	virtual void submit(Job job, Completion completion) = 0;
+
+	virtual std::size_t getWorkerCount() const noexcept = 0;
+
+	virtual int getCompletionFd() const noexcept = 0;
+
+	/* Runs the pending completions on the calling thread and returns their number.
+	 * If a completion throws an exception, the remaining completions stay pending. */
+	virtual std::size_t runCompletions() = 0;
+};
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace esl */
+
+#endif /* ESL_DATABASE_ODBCEXECUTOR_H_ */
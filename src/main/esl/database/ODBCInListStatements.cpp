@@ -0,0 +1,15 @@
+#include <esl/database/ODBCInListStatements.h>
+
+#include <odbc4esl/database/InListStatements.h>
+
+namespace esl {
+inline namespace v1_6 {
+namespace database {
+
+std::unique_ptr<ODBCInListStatements> ODBCInListStatements::create(const ODBCConnection& connection, const std::string& sql, std::size_t maximumSize, Padding padding) {
+	return std::unique_ptr<ODBCInListStatements>(new odbc4esl::database::InListStatements(connection, sql, maximumSize, padding));
+}
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace esl */
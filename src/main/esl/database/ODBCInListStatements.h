@@ -0,0 +1,55 @@
+#ifndef ESL_DATABASE_ODBCINLISTSTATEMENTS_H_
+#define ESL_DATABASE_ODBCINLISTSTATEMENTS_H_
+
+#include <esl/database/Field.h>
+#include <esl/database/ODBCConnection.h>
+#include <esl/database/ODBCPreparedStatement.h>
+#include <esl/database/ODBCResultSet.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace esl {
+inline namespace v1_6 {
+namespace database {
+
+/* Prepared statements of a statement with an IN list of variable length.
+ * The size of the list is rounded up to a power of two and the remaining values are padded,
+ * so there is one prepared statement per bucket instead of one per list size.
+ * The statement contains the IN list with a single parameter, e.g. "SELECT id FROM person WHERE tenant = ? AND id IN (?)".
+ * Statements are prepared when they are used the first time. Like prepared statements, the object is not thread safe. */
+class ODBCInListStatements {
+public:
+	enum class Padding {
+		/* the last value is repeated, this fits any column type */
+		repeatLast,
+
+		/* NULL never matches, so it fits columns where NULL values must not be found */
+		null
+	};
+
+	/* Lists with more than maximumSize values are rejected, the largest bucket has maximumSize values.
+	 * Throws std::runtime_error if the statement has no IN list "IN (?)". */
+	static std::unique_ptr<ODBCInListStatements> create(const ODBCConnection& connection, const std::string& sql, std::size_t maximumSize = 1024, Padding padding = Padding::repeatLast);
+
+	virtual ~ODBCInListStatements() = default;
+
+	/* Number of values the list of the given size is padded to */
+	virtual std::size_t getBucketSize(std::size_t size) const = 0;
+
+	/* Fields for the statement of the bucket: parameters with the padded values inserted at the position of the IN list.
+	 * An empty list is padded with NULL, so it matches no row. */
+	virtual void createFields(const std::vector<Field>& parameters, const std::vector<Field>& values, std::vector<Field>& fields) const = 0;
+
+	virtual ODBCPreparedStatement& getStatement(std::size_t size) = 0;
+
+	virtual std::unique_ptr<ODBCResultSet> executeODBC(const std::vector<Field>& parameters, const std::vector<Field>& values) = 0;
+};
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace esl */
+
+#endif /* ESL_DATABASE_ODBCINLISTSTATEMENTS_H_ */
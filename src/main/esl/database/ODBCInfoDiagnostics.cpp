@@ -0,0 +1,35 @@
+#include <esl/database/ODBCInfoDiagnostics.h>
+
+#include <odbc4esl/database/InfoDiagnostics.h>
+
+namespace esl {
+inline namespace v1_6 {
+namespace database {
+
+std::vector<ODBCInfoDiagnostics::Counter> ODBCInfoDiagnostics::getCounters() {
+	return odbc4esl::database::InfoDiagnostics::getInfoDiagnostics().getCounters();
+}
+
+void ODBCInfoDiagnostics::resetCounters() {
+	odbc4esl::database::InfoDiagnostics::getInfoDiagnostics().resetCounters();
+}
+
+void ODBCInfoDiagnostics::mute(const std::string& state) {
+	odbc4esl::database::InfoDiagnostics::getInfoDiagnostics().mute(state);
+}
+
+void ODBCInfoDiagnostics::unmute(const std::string& state) {
+	odbc4esl::database::InfoDiagnostics::getInfoDiagnostics().unmute(state);
+}
+
+void ODBCInfoDiagnostics::setLogInterval(std::chrono::milliseconds logInterval) {
+	odbc4esl::database::InfoDiagnostics::getInfoDiagnostics().setLogInterval(logInterval);
+}
+
+void ODBCInfoDiagnostics::logSummary() {
+	odbc4esl::database::InfoDiagnostics::getInfoDiagnostics().logSummary();
+}
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace esl */
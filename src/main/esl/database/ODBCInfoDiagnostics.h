@@ -0,0 +1,45 @@
+#ifndef ESL_DATABASE_ODBCINFODIAGNOSTICS_H_
+#define ESL_DATABASE_ODBCINFODIAGNOSTICS_H_
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace esl {
+inline namespace v1_6 {
+namespace database {
+
+/* Process wide counters of SQL_SUCCESS_WITH_INFO diagnostics, aggregated per SQLSTATE and ODBC function.
+ * Details are logged only for the first occurrence, afterwards a summary is logged at most once per log interval.
+ * Up to 7 SQLSTATEs are counted per function, further SQLSTATEs are counted together as state "other". */
+class ODBCInfoDiagnostics {
+public:
+	struct Counter {
+		std::string operation;
+		std::string state;
+		std::uint64_t count = 0;
+
+		/* occurrences that have been logged, in detail or by a summary */
+		std::uint64_t reportedCount = 0;
+	};
+
+	static std::vector<Counter> getCounters();
+	static void resetCounters();
+
+	/* Muted SQLSTATEs are still counted but never logged. Throws std::runtime_error if 16 SQLSTATEs are muted already. */
+	static void mute(const std::string& state);
+	static void unmute(const std::string& state);
+
+	static void setLogInterval(std::chrono::milliseconds logInterval);
+
+	/* A summary is logged by the next occurrence after the log interval, so the last occurrences before a quiet period
+	 * are logged only by this function. It is called by the destructor of ODBCConnectionFactory. */
+	static void logSummary();
+};
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace esl */
+
+#endif /* ESL_DATABASE_ODBCINFODIAGNOSTICS_H_ */
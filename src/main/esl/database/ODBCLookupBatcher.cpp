@@ -0,0 +1,19 @@
+#include <esl/database/ODBCLookupBatcher.h>
+
+#include <odbc4esl/database/LookupBatcher.h>
+
+namespace esl {
+inline namespace v1_6 {
+namespace database {
+
+std::unique_ptr<ODBCLookupBatcher> ODBCLookupBatcher::create(std::unique_ptr<ODBCConnection> connection, const std::string& sql, std::size_t keyColumn, const Settings& settings) {
+	return std::unique_ptr<ODBCLookupBatcher>(new odbc4esl::database::LookupBatcher(std::move(connection), sql, keyColumn, settings));
+}
+
+std::unique_ptr<ODBCLookupBatcher> ODBCLookupBatcher::create(std::unique_ptr<ODBCConnection> connection, const std::string& sql, std::size_t keyColumn) {
+	return create(std::move(connection), sql, keyColumn, Settings());
+}
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace esl */
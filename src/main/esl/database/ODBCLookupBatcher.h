@@ -0,0 +1,45 @@
+#ifndef ESL_DATABASE_ODBCLOOKUPBATCHER_H_
+#define ESL_DATABASE_ODBCLOOKUPBATCHER_H_
+
+#include <esl/database/Field.h>
+#include <esl/database/ODBCConnection.h>
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace esl {
+inline namespace v1_6 {
+namespace database {
+
+/* Coalesces point lookups of concurrent threads into one query with an IN list.
+ * The first caller of a batch waits until the batch is full or its delay has passed and executes it for all callers,
+ * so there is no background thread. Each size of the IN list is rounded up to a power of two and prepared once.
+ * The statement must contain the IN list with a single parameter, e.g. "SELECT id, name FROM person WHERE id IN (?)".
+ * Keys are compared with the values of the key column by their string representation without trailing blanks,
+ * so keys match the blank padded values of CHAR(n) columns. Therefore keys that differ only by trailing blanks are the same key. */
+class ODBCLookupBatcher {
+public:
+	struct Settings {
+		std::size_t maximumBatchSize = 64;
+		std::chrono::microseconds maximumDelay = std::chrono::microseconds(500);
+	};
+
+	/* The connection is used only by the batcher and must not be used by anything else */
+	static std::unique_ptr<ODBCLookupBatcher> create(std::unique_ptr<ODBCConnection> connection, const std::string& sql, std::size_t keyColumn, const Settings& settings);
+	static std::unique_ptr<ODBCLookupBatcher> create(std::unique_ptr<ODBCConnection> connection, const std::string& sql, std::size_t keyColumn);
+
+	virtual ~ODBCLookupBatcher() = default;
+
+	/* Returns all rows of the key, blocks until the batch containing the key has been executed.
+	 * If the batch fails, its exception is thrown to every caller of the batch. */
+	virtual std::vector<std::vector<Field>> lookup(const Field& key) = 0;
+};
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace esl */
+
+#endif /* ESL_DATABASE_ODBCLOOKUPBATCHER_H_ */
@@ -0,0 +1,261 @@
+#include <esl/database/ODBCMetrics.h>
+
+#include <odbc4esl/database/Metrics.h>
+
+#include <locale>
+#include <sstream>
+
+namespace esl {
+inline namespace v1_6 {
+namespace database {
+
+namespace {
+void writeLabel(std::ostream& stream, const std::string& value) {
+	for(char c : value) {
+		switch(c) {
+		case '\\':
+			stream << "\\\\";
+			break;
+		case '"':
+			stream << "\\\"";
+			break;
+		case '\n':
+			stream << "\\n";
+			break;
+		default:
+			stream << c;
+			break;
+		}
+	}
+}
+
+void writeHistogram(std::ostream& stream, const char* name, const std::string& fingerprint, const ODBCMetrics::Histogram& histogram) {
+	std::uint64_t count = 0;
+	for(std::size_t i = 0; i < histogram.buckets.size(); ++i) {
+		count += histogram.buckets[i];
+
+		stream << name << "_bucket{";
+		if(!fingerprint.empty()) {
+			stream << "statement=\"";
+			writeLabel(stream, fingerprint);
+			stream << "\",";
+		}
+		stream << "le=\"";
+		if(ODBCMetrics::Histogram::getUpperBound(i) == 0) {
+			stream << "+Inf";
+		}
+		else {
+			stream << (static_cast<double>(ODBCMetrics::Histogram::getUpperBound(i)) / 1000000.0);
+		}
+		stream << "\"} " << count << "\n";
+	}
+
+	stream << name << "_sum";
+	if(!fingerprint.empty()) {
+		stream << "{statement=\"";
+		writeLabel(stream, fingerprint);
+		stream << "\"}";
+	}
+	stream << " " << (static_cast<double>(histogram.sumNanoseconds) / 1000000000.0) << "\n";
+
+	stream << name << "_count";
+	if(!fingerprint.empty()) {
+		stream << "{statement=\"";
+		writeLabel(stream, fingerprint);
+		stream << "\"}";
+	}
+	stream << " " << histogram.count << "\n";
+}
+
+void writeJSONString(std::ostream& stream, const std::string& value) {
+	static const char hex[] = "0123456789abcdef";
+
+	stream << '"';
+	for(char c : value) {
+		switch(c) {
+		case '\\':
+			stream << "\\\\";
+			break;
+		case '"':
+			stream << "\\\"";
+			break;
+		case '\n':
+			stream << "\\n";
+			break;
+		case '\r':
+			stream << "\\r";
+			break;
+		case '\t':
+			stream << "\\t";
+			break;
+		default:
+			if(static_cast<unsigned char>(c) < 0x20) {
+				stream << "\\u00" << hex[(c >> 4) & 0x0f] << hex[c & 0x0f];
+			}
+			else {
+				stream << c;
+			}
+			break;
+		}
+	}
+	stream << '"';
+}
+
+void writeJSONHistogram(std::ostream& stream, const char* name, const ODBCMetrics::Histogram& histogram) {
+	stream << "\"" << name << "\":{\"count\":" << histogram.count
+			<< ",\"sumNanoseconds\":" << histogram.sumNanoseconds
+			<< ",\"p50Microseconds\":" << histogram.getQuantile(0.5)
+			<< ",\"p99Microseconds\":" << histogram.getQuantile(0.99)
+			<< ",\"buckets\":[";
+	for(std::size_t i = 0; i < histogram.buckets.size(); ++i) {
+		if(i > 0) {
+			stream << ",";
+		}
+		stream << histogram.buckets[i];
+	}
+	stream << "]}";
+}
+
+template<typename T>
+void writeCounter(std::ostream& stream, const char* name, const std::string& fingerprint, T value) {
+	stream << name << "{statement=\"";
+	writeLabel(stream, fingerprint);
+	stream << "\"} " << value << "\n";
+}
+}
+
+constexpr std::size_t ODBCMetrics::Histogram::bucketCount;
+constexpr std::size_t ODBCMetrics::maximumStatements;
+constexpr const char* ODBCMetrics::otherFingerprint;
+
+std::uint64_t ODBCMetrics::Histogram::getUpperBound(std::size_t bucket) noexcept {
+	if(bucket+1 >= bucketCount) {
+		return 0;
+	}
+	return static_cast<std::uint64_t>(1) << bucket;
+}
+
+std::uint64_t ODBCMetrics::Histogram::getQuantile(double quantile) const noexcept {
+	if(count == 0) {
+		return 0;
+	}
+
+	std::uint64_t rank = static_cast<std::uint64_t>(quantile * static_cast<double>(count));
+	if(rank >= count) {
+		rank = count - 1;
+	}
+
+	std::uint64_t accumulated = 0;
+	for(std::size_t i = 0; i < buckets.size(); ++i) {
+		accumulated += buckets[i];
+		if(accumulated > rank) {
+			return getUpperBound(i);
+		}
+	}
+	return 0;
+}
+
+ODBCMetrics::Snapshot ODBCMetrics::getSnapshot() {
+	return odbc4esl::database::Metrics::getMetrics().getSnapshot();
+}
+
+std::string ODBCMetrics::getText(const Snapshot& snapshot) {
+	std::ostringstream stream;
+	stream.imbue(std::locale::classic());
+
+	stream << "# TYPE odbc4esl_statement_prepare_seconds histogram\n";
+	for(const auto& statement : snapshot.statements) {
+		writeHistogram(stream, "odbc4esl_statement_prepare_seconds", statement.fingerprint, statement.prepare);
+	}
+	stream << "# TYPE odbc4esl_statement_execute_seconds histogram\n";
+	for(const auto& statement : snapshot.statements) {
+		writeHistogram(stream, "odbc4esl_statement_execute_seconds", statement.fingerprint, statement.execute);
+	}
+	stream << "# TYPE odbc4esl_statement_first_row_seconds histogram\n";
+	for(const auto& statement : snapshot.statements) {
+		writeHistogram(stream, "odbc4esl_statement_first_row_seconds", statement.fingerprint, statement.firstRow);
+	}
+	stream << "# TYPE odbc4esl_statement_drain_seconds histogram\n";
+	for(const auto& statement : snapshot.statements) {
+		writeHistogram(stream, "odbc4esl_statement_drain_seconds", statement.fingerprint, statement.drain);
+	}
+	stream << "# TYPE odbc4esl_statement_rows_total counter\n";
+	for(const auto& statement : snapshot.statements) {
+		writeCounter(stream, "odbc4esl_statement_rows_total", statement.fingerprint, statement.rows);
+	}
+	stream << "# TYPE odbc4esl_statement_bytes_total counter\n";
+	for(const auto& statement : snapshot.statements) {
+		writeCounter(stream, "odbc4esl_statement_bytes_total", statement.fingerprint, statement.bytes);
+	}
+	stream << "# TYPE odbc4esl_statement_errors_total counter\n";
+	for(const auto& statement : snapshot.statements) {
+		writeCounter(stream, "odbc4esl_statement_errors_total", statement.fingerprint, statement.errors);
+	}
+
+	stream << "# TYPE odbc4esl_commit_seconds histogram\n";
+	writeHistogram(stream, "odbc4esl_commit_seconds", "", snapshot.commit);
+	stream << "# TYPE odbc4esl_rollback_seconds histogram\n";
+	writeHistogram(stream, "odbc4esl_rollback_seconds", "", snapshot.rollback);
+	stream << "# TYPE odbc4esl_transaction_errors_total counter\n";
+	stream << "odbc4esl_transaction_errors_total " << snapshot.transactionErrors << "\n";
+
+	return stream.str();
+}
+
+std::string ODBCMetrics::getText() {
+	return getText(getSnapshot());
+}
+
+std::string ODBCMetrics::getJSON(const Snapshot& snapshot) {
+	std::ostringstream stream;
+	stream.imbue(std::locale::classic());
+
+	stream << "{\"statements\":[";
+	for(std::size_t i = 0; i < snapshot.statements.size(); ++i) {
+		const Statement& statement = snapshot.statements[i];
+
+		if(i > 0) {
+			stream << ",";
+		}
+		stream << "{\"fingerprint\":";
+		writeJSONString(stream, statement.fingerprint);
+		stream << ",";
+		writeJSONHistogram(stream, "prepare", statement.prepare);
+		stream << ",";
+		writeJSONHistogram(stream, "execute", statement.execute);
+		stream << ",";
+		writeJSONHistogram(stream, "firstRow", statement.firstRow);
+		stream << ",";
+		writeJSONHistogram(stream, "drain", statement.drain);
+		stream << ",\"rows\":" << statement.rows
+				<< ",\"bytes\":" << statement.bytes
+				<< ",\"errors\":" << statement.errors << "}";
+	}
+	stream << "],";
+	writeJSONHistogram(stream, "commit", snapshot.commit);
+	stream << ",";
+	writeJSONHistogram(stream, "rollback", snapshot.rollback);
+	stream << ",\"transactionErrors\":" << snapshot.transactionErrors << "}";
+
+	return stream.str();
+}
+
+std::string ODBCMetrics::getJSON() {
+	return getJSON(getSnapshot());
+}
+
+void ODBCMetrics::reset() {
+	odbc4esl::database::Metrics::getMetrics().reset();
+}
+
+bool ODBCMetrics::isEnabled() noexcept {
+	return odbc4esl::database::Metrics::getMetrics().isEnabled();
+}
+
+void ODBCMetrics::setEnabled(bool enabled) noexcept {
+	odbc4esl::database::Metrics::getMetrics().setEnabled(enabled);
+}
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace esl */
@@ -0,0 +1,78 @@
+#ifndef ESL_DATABASE_ODBCMETRICS_H_
+#define ESL_DATABASE_ODBCMETRICS_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace esl {
+inline namespace v1_6 {
+namespace database {
+
+/* Process wide latency and throughput metrics of all ODBC statements, keyed by a normalized SQL fingerprint. */
+class ODBCMetrics {
+public:
+	struct Histogram {
+		/* Bucket i counts durations below 2^i microseconds that did not fit into bucket i-1.
+		 * The last bucket counts all remaining durations. */
+		static constexpr std::size_t bucketCount = 32;
+
+		std::vector<std::uint64_t> buckets;
+		std::uint64_t count = 0;
+		std::uint64_t sumNanoseconds = 0;
+
+		/* upper bound of bucket in microseconds, 0 for the last bucket that has no upper bound */
+		static std::uint64_t getUpperBound(std::size_t bucket) noexcept;
+
+		/* estimated quantile (0.0 - 1.0) in microseconds as upper bound of the bucket containing it,
+		 * 0 if the histogram is empty or the quantile falls into the last bucket */
+		std::uint64_t getQuantile(double quantile) const noexcept;
+	};
+
+	struct Statement {
+		std::string fingerprint;
+
+		Histogram prepare;
+		Histogram execute;
+		Histogram firstRow;
+		Histogram drain;
+
+		std::uint64_t rows = 0;
+		std::uint64_t bytes = 0;
+		std::uint64_t errors = 0;
+	};
+
+	/* Metrics are kept for at most maximumStatements fingerprints, so SQL with inlined values that are not
+	 * normalized cannot grow the map without bound. Further fingerprints are aggregated in otherFingerprint. */
+	static constexpr std::size_t maximumStatements = 1000;
+	static constexpr const char* otherFingerprint = "other";
+
+	struct Snapshot {
+		std::vector<Statement> statements;
+
+		Histogram commit;
+		Histogram rollback;
+		std::uint64_t transactionErrors = 0;
+	};
+
+	static Snapshot getSnapshot();
+
+	/* Snapshot in Prometheus text exposition format */
+	static std::string getText(const Snapshot& snapshot);
+	static std::string getText();
+
+	/* Snapshot as JSON document, e.g. to compare runs of a benchmark before and after an upgrade */
+	static std::string getJSON(const Snapshot& snapshot);
+	static std::string getJSON();
+
+	static void reset();
+
+	static bool isEnabled() noexcept;
+	static void setEnabled(bool enabled) noexcept;
+};
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace esl */
+
+#endif /* ESL_DATABASE_ODBCMETRICS_H_ */
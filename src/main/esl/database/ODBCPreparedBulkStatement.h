@@ -0,0 +1,26 @@
+#ifndef ESL_DATABASE_ODBCPREPAREDBULKSTATEMENT_H_
+#define ESL_DATABASE_ODBCPREPAREDBULKSTATEMENT_H_
+
+#include <esl/database/Field.h>
+#include <esl/database/ODBCStatus.h>
+#include <esl/database/PreparedBulkStatement.h>
+
+#include <vector>
+
+namespace esl {
+inline namespace v1_6 {
+namespace database {
+
+/* Prepared bulk statement binding with ODBC specific extensions. It can be wrapped into an esl::database::PreparedBulkStatement. */
+class ODBCPreparedBulkStatement : public PreparedBulkStatement::Binding {
+public:
+	/* Executes the statement without throwing an exception if the execution fails.
+	 * No stacktrace is captured and the diagnostic message is only set if withMessage is true. */
+	virtual ODBCStatus tryExecute(const std::vector<Field>& fields, bool withMessage) = 0;
+};
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace esl */
+
+#endif /* ESL_DATABASE_ODBCPREPAREDBULKSTATEMENT_H_ */
@@ -0,0 +1,121 @@
+#ifndef ESL_DATABASE_ODBCPREPAREDSTATEMENT_H_
+#define ESL_DATABASE_ODBCPREPAREDSTATEMENT_H_
+
+#include <esl/database/Field.h>
+#include <esl/database/ODBCProjection.h>
+#include <esl/database/ODBCResultSet.h>
+#include <esl/database/ODBCRow.h>
+#include <esl/database/ODBCRowFetcher.h>
+#include <esl/database/ODBCRowLayout.h>
+#include <esl/database/ODBCStatus.h>
+#include <esl/database/PreparedStatement.h>
+#include <esl/database/ResultSet.h>
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace esl {
+inline namespace v1_6 {
+namespace database {
+
+/* Prepared statement binding with ODBC specific extensions. It can be wrapped into an esl::database::PreparedStatement. */
+class ODBCPreparedStatement : public PreparedStatement::Binding {
+public:
+	/* Query timeout (SQL_ATTR_QUERY_TIMEOUT) of the following executions, 0 means no timeout.
+	 * It is limited further by the remaining time of an ODBCDeadline. */
+	virtual void setQueryTimeout(std::chrono::seconds queryTimeout) = 0;
+
+	/* Cancels a running execution by SQLCancel, so it fails with SQLSTATE HY008. It is called by another thread.
+	 * After the execution returned a result set, it has to be cancelled by ODBCResultSet::cancel(). */
+	virtual void cancel() = 0;
+
+	/* Executes the statement without throwing an exception if the execution fails.
+	 * No stacktrace is captured and the diagnostic message is only set if withMessage is true.
+	 * resultSet is set only if the execution was successful and the statement returns a result set. */
+	virtual ODBCStatus tryExecute(const std::vector<Field>& fields, ResultSet& resultSet, bool withMessage) = 0;
+
+	ODBCStatus tryExecute(const std::vector<Field>& fields, bool withMessage = false) {
+		ResultSet resultSet;
+		return tryExecute(fields, resultSet, withMessage);
+	}
+
+	/* Executes the statement and returns its first result set, that allows to iterate over further result sets.
+	 * Returns nullptr if the execution has no result set. */
+	virtual std::unique_ptr<ODBCResultSet> executeODBC(const std::vector<Field>& fields) = 0;
+
+	/* Same as executeODBC(fields), but only the result columns of the projection are bound and decoded.
+	 * The projection applies to the first result set only. */
+	virtual std::unique_ptr<ODBCResultSet> executeODBC(const std::vector<Field>& fields, const ODBCProjection& projection) = 0;
+
+	/* Executes the statement and returns a fetcher for row-wise binding of its first result set into rows of rowSize bytes.
+	 * The row columns are bound to the first result columns in the same order.
+	 * Throws an exception if the execution has no result set or it has less columns than the row. */
+	virtual std::unique_ptr<ODBCRowFetcher> executeRows(const std::vector<Field>& fields, std::size_t rowSize, const std::vector<ODBCRowColumn>& rowColumns) = 0;
+
+	template<typename Row>
+	std::unique_ptr<ODBCRowFetcher> executeRows(const std::vector<Field>& fields) {
+		return executeRows(fields, sizeof(Row), ODBCRowLayout<Row>::getColumns());
+	}
+
+	/* Executes the statement, reads its first row into row and closes the cursor in one call.
+	 * The result columns stay bound to the statement over executions, so no result set is created per call.
+	 * row must have one field per result column. Returns false if there is no row. */
+	bool queryOne(const std::vector<Field>& fields, std::vector<Field>& row) {
+		return queryRow(fields, &readFields, &row);
+	}
+
+	/* Same as queryOne(), but the row is read into a std::tuple like ODBCResultSet::fetchAs() */
+	template<typename Tuple>
+	bool queryOne(const std::vector<Field>& fields, Tuple& row) {
+		return queryRow(fields, &readTuple<Tuple>, &row);
+	}
+
+	/* Reads the first column of the first row by ODBCDecoder<T>.
+	 * Returns false if there is no row or if the value is NULL and T is not std::optional. */
+	template<typename T>
+	bool queryScalar(const std::vector<Field>& fields, T& value) {
+		return queryRow(fields, &readScalar<T>, &value);
+	}
+
+	/* Checks a tuple for ODBCResultSet::fetchAs() against the described result columns right after prepare.
+	 * Throws std::runtime_error if it does not match. */
+	template<typename Tuple>
+	void checkResultColumns() const {
+		ODBCTupleDecoder<Tuple>::check(getResultColumns());
+	}
+
+protected:
+	/* Executes the statement, calls read with the first row and context and closes the cursor.
+	 * Returns false if there is no row, otherwise the result of read. */
+	virtual bool queryRow(const std::vector<Field>& fields, bool (*read)(ODBCRow& row, void* context), void* context) = 0;
+
+private:
+	static bool readFields(ODBCRow& row, void* context) {
+		row.getFields(*static_cast<std::vector<Field>*>(context));
+		return true;
+	}
+
+	template<typename Tuple>
+	static bool readTuple(ODBCRow& row, void* context) {
+		ODBCTupleDecoder<Tuple>::check(row.getColumns());
+		ODBCTupleDecoder<Tuple>::decode(row, *static_cast<Tuple*>(context));
+		return true;
+	}
+
+	template<typename T>
+	static bool readScalar(ODBCRow& row, void* context) {
+		if(row.getColumns().empty() || !ODBCDecoder<T>::accepts(ODBCRowColumn::getType(row.getColumns()[0].getType()))) {
+			throw std::runtime_error("Scalar type does not match the first result column.");
+		}
+		return ODBCDecoder<T>::decode(row, 0, *static_cast<T*>(context));
+	}
+};
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace esl */
+
+#endif /* ESL_DATABASE_ODBCPREPAREDSTATEMENT_H_ */
@@ -0,0 +1,52 @@
+#ifndef ESL_DATABASE_ODBCPROJECTION_H_
+#define ESL_DATABASE_ODBCPROJECTION_H_
+
+#include <esl/database/Column.h>
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace esl {
+inline namespace v1_6 {
+namespace database {
+
+/* Result columns a caller reads. Other columns are neither bound nor transferred,
+ * fetch() sets their fields to NULL and the typed getters throw an exception for them. */
+struct ODBCProjection {
+	/* Selects the result columns with the given names */
+	static ODBCProjection select(const std::vector<Column>& resultColumns, const std::vector<std::string>& names) {
+		ODBCProjection projection;
+
+		for(const auto& name : names) {
+			std::size_t index = 0;
+			while(index < resultColumns.size() && resultColumns[index].getName() != name) {
+				++index;
+			}
+			if(index == resultColumns.size()) {
+				throw std::runtime_error("Result has no column \"" + name + "\".");
+			}
+			projection.columns.push_back(index);
+		}
+
+		return projection;
+	}
+
+	/* indices of the selected result columns, all columns are selected if it is empty */
+	std::vector<std::size_t> columns;
+
+	/* Columns are not bound, a value is read by SQLGetData when it is accessed the first time after a fetch.
+	 * Values are read in ascending column order, so accessing a column reads the selected columns in front of it as well. */
+	bool lazy = false;
+
+	/* Maximum number of bytes the driver returns for character and binary columns (SQL_ATTR_MAX_LENGTH), 0 means no limit.
+	 * Longer values are truncated without notice, so it fits columns that are read only partially, e.g. for a preview. */
+	std::size_t maximumLength = 0;
+};
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace esl */
+
+#endif /* ESL_DATABASE_ODBCPROJECTION_H_ */
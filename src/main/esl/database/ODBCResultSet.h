@@ -0,0 +1,70 @@
+#ifndef ESL_DATABASE_ODBCRESULTSET_H_
+#define ESL_DATABASE_ODBCRESULTSET_H_
+
+#include <esl/database/Column.h>
+#include <esl/database/ODBCDecoder.h>
+#include <esl/database/ResultSet.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace esl {
+inline namespace v1_6 {
+namespace database {
+
+/* Result set binding with ODBC specific extensions. It can be wrapped into an esl::database::ResultSet. */
+class ODBCResultSet : public ResultSet::Binding {
+public:
+	ODBCResultSet(const std::vector<Column>& columns)
+	: ResultSet::Binding(columns)
+	{ }
+
+	/* Moves to the next result set of the same execution, e.g. of a stored procedure or a batch of statements.
+	 * Remaining rows of this result set are discarded and this object must not be used anymore afterwards.
+	 * Results without columns (e.g. row counts of UPDATE statements) are skipped.
+	 * Returns nullptr if there is no further result set. */
+	virtual std::unique_ptr<ODBCResultSet> nextResultSet() = 0;
+
+	/* Moves to the next row without converting its values into fields. Returns false if there are no more rows. */
+	virtual bool fetchRow() = 0;
+
+	/* Cancels a running fetch or further fetches by SQLCancel from another thread */
+	virtual void cancel() = 0;
+
+	/* Values of the current row, read without dispatching on the column type. They return false if the value is NULL.
+	 * getString() requires a character column, see ODBCRowColumn::getType(). getInteger() and getDouble() parse
+	 * the value of character columns and throw an exception if it is not a number. */
+	virtual bool getInteger(std::size_t column, std::int64_t& value) = 0;
+	virtual bool getDouble(std::size_t column, double& value) = 0;
+	virtual bool getString(std::size_t column, std::string& value) = 0;
+
+	/* Fetches the next row into a std::tuple, e.g. std::tuple<std::int64_t, double, std::string, std::optional<std::string>>.
+	 * The tuple is checked against the columns once, then every element is read by its ODBCDecoder.
+	 * Returns false if there are no more rows. */
+	template<typename Tuple>
+	bool fetchAs(Tuple& row) {
+		static const char tupleKey = 0;
+		if(checkedTupleKey != &tupleKey) {
+			ODBCTupleDecoder<Tuple>::check(getColumns());
+			checkedTupleKey = &tupleKey;
+		}
+
+		if(!fetchRow()) {
+			return false;
+		}
+		ODBCTupleDecoder<Tuple>::decode(*this, row);
+		return true;
+	}
+
+private:
+	const void* checkedTupleKey = nullptr;
+};
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace esl */
+
+#endif /* ESL_DATABASE_ODBCRESULTSET_H_ */
@@ -0,0 +1,36 @@
+#ifndef ESL_DATABASE_ODBCROW_H_
+#define ESL_DATABASE_ODBCROW_H_
+
+#include <esl/database/Column.h>
+#include <esl/database/Field.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace esl {
+inline namespace v1_6 {
+namespace database {
+
+/* Values of a single fetched row, e.g. of ODBCPreparedStatement::queryOne().
+ * The getters work like the ones of ODBCResultSet and return false if the value is NULL. */
+class ODBCRow {
+public:
+	virtual ~ODBCRow() = default;
+
+	virtual const std::vector<Column>& getColumns() const = 0;
+
+	virtual bool getInteger(std::size_t column, std::int64_t& value) = 0;
+	virtual bool getDouble(std::size_t column, double& value) = 0;
+	virtual bool getString(std::size_t column, std::string& value) = 0;
+
+	/* Converts all values into fields, fields must have one element per column */
+	virtual void getFields(std::vector<Field>& fields) = 0;
+};
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace esl */
+
+#endif /* ESL_DATABASE_ODBCROW_H_ */
@@ -0,0 +1,55 @@
+#ifndef ESL_DATABASE_ODBCROWFETCHER_H_
+#define ESL_DATABASE_ODBCROWFETCHER_H_
+
+#include <esl/database/ODBCRowLayout.h>
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace esl {
+inline namespace v1_6 {
+namespace database {
+
+/* Fetches rows of a result set directly into caller provided rows by row-wise binding,
+ * without esl::database::Field and without copying values from intermediate buffers. */
+class ODBCRowFetcher {
+public:
+	virtual ~ODBCRowFetcher() = default;
+
+	/* Fetches up to rowCount rows into the array at rows. The rows must have the size and layout the fetcher has been created for.
+	 * Returns the number of fetched rows. It is 0 if there are no more rows. */
+	virtual std::size_t fetch(void* rows, std::size_t rowCount) = 0;
+
+	template<typename Row>
+	std::size_t fetch(Row* rows, std::size_t rowCount) {
+		static_assert(std::is_standard_layout<Row>::value, "row-wise binding requires a standard layout type");
+		static_assert(std::is_trivially_copyable<Row>::value, "row-wise binding requires a trivially copyable type");
+		return fetch(static_cast<void*>(rows), rowCount);
+	}
+
+	/* Appends all remaining rows to the vector, fetching batchSize rows at once. Returns the number of appended rows. */
+	template<typename Row>
+	std::size_t fetchAll(std::vector<Row>& rows, std::size_t batchSize = 256) {
+		std::size_t oldSize = rows.size();
+		std::size_t size = oldSize;
+
+		while(true) {
+			rows.resize(size + batchSize);
+			std::size_t fetched = fetch(rows.data() + size, batchSize);
+			size += fetched;
+			if(fetched < batchSize) {
+				break;
+			}
+		}
+		rows.resize(size);
+
+		return size - oldSize;
+	}
+};
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace esl */
+
+#endif /* ESL_DATABASE_ODBCROWFETCHER_H_ */
@@ -0,0 +1,108 @@
+#ifndef ESL_DATABASE_ODBCROWLAYOUT_H_
+#define ESL_DATABASE_ODBCROWLAYOUT_H_
+
+#include <esl/database/Column.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace esl {
+inline namespace v1_6 {
+namespace database {
+
+/* Length or indicator of a column value inside of a row. It has the size of SQLLEN.
+ * It is ODBCRowColumn::nullData if the value is NULL, otherwise the length of the value. */
+using ODBCRowIndicator = std::int64_t;
+
+/* Value type of a row member that can be bound by ODBCRowColumn. Supported are std::int64_t, double and char[N].
+ * Character arrays are zero terminated, so values longer than N-1 characters are truncated. */
+template<typename T>
+struct ODBCRowColumnType;
+
+/* Column of a row for row-wise binding. Columns of a layout are bound to the result columns in the same order. */
+struct ODBCRowColumn {
+	enum class Type {
+		integer,
+		floatingPoint,
+		character
+	};
+
+	static constexpr ODBCRowIndicator nullData = -1;
+
+	/* Type a result column of the given type is bound as */
+	static Type getType(Column::Type columnType) noexcept {
+		switch(columnType) {
+		case Column::Type::sqlBoolean:
+		case Column::Type::sqlInteger:
+		case Column::Type::sqlSmallInt:
+			return Type::integer;
+		case Column::Type::sqlDouble:
+		case Column::Type::sqlNumeric:
+		case Column::Type::sqlDecimal:
+		case Column::Type::sqlFloat:
+		case Column::Type::sqlReal:
+			return Type::floatingPoint;
+		default:
+			return Type::character;
+		}
+	}
+
+	template<typename T>
+	static ODBCRowColumn create(std::size_t valueOffset, std::size_t indicatorOffset) {
+		return ODBCRowColumn{ODBCRowColumnType<T>::type, valueOffset, sizeof(T), indicatorOffset};
+	}
+
+	Type type;
+	std::size_t valueOffset;
+	std::size_t valueSize;
+	std::size_t indicatorOffset;
+};
+
+template<>
+struct ODBCRowColumnType<std::int64_t> {
+	static constexpr ODBCRowColumn::Type type = ODBCRowColumn::Type::integer;
+};
+
+template<>
+struct ODBCRowColumnType<double> {
+	static constexpr ODBCRowColumn::Type type = ODBCRowColumn::Type::floatingPoint;
+};
+
+template<std::size_t N>
+struct ODBCRowColumnType<char[N]> {
+	static_assert(N > 1, "character array must have space for at least one character and the terminating zero");
+	static constexpr ODBCRowColumn::Type type = ODBCRowColumn::Type::character;
+};
+
+/* Row layout of a struct. It has to be specialized for every row type that should be fetched row-wise, e.g.
+ *
+ * struct Customer {
+ *     std::int64_t id;
+ *     esl::database::ODBCRowIndicator idIndicator;
+ *     char name[64];
+ *     esl::database::ODBCRowIndicator nameIndicator;
+ * };
+ *
+ * template<>
+ * struct esl::database::ODBCRowLayout<Customer> {
+ *     static const std::vector<esl::database::ODBCRowColumn>& getColumns() {
+ *         static const std::vector<esl::database::ODBCRowColumn> columns {
+ *             ODBC4ESL__ROW_COLUMN(Customer, id, idIndicator),
+ *             ODBC4ESL__ROW_COLUMN(Customer, name, nameIndicator)
+ *         };
+ *         return columns;
+ *     }
+ * };
+ */
+template<typename Row>
+struct ODBCRowLayout;
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace esl */
+
+#define ODBC4ESL__ROW_COLUMN(Row, value, indicator) \
+	esl::database::ODBCRowColumn::create<decltype(Row::value)>(offsetof(Row, value), offsetof(Row, indicator))
+
+#endif /* ESL_DATABASE_ODBCROWLAYOUT_H_ */
@@ -0,0 +1,40 @@
+#ifndef ESL_DATABASE_ODBCSTATUS_H_
+#define ESL_DATABASE_ODBCSTATUS_H_
+
+#include <cstring>
+#include <string>
+
+namespace esl {
+inline namespace v1_6 {
+namespace database {
+
+/* Result of an ODBC call that reports errors as value instead of throwing an exception */
+struct ODBCStatus {
+	bool success = true;
+
+	/* SQLSTATE and native error code of the first diagnostic record if success is false */
+	char state[6] = {};
+	long nativeCode = 0;
+
+	/* diagnostic message, only set if it has been requested */
+	std::string message;
+
+	explicit operator bool() const noexcept {
+		return success;
+	}
+
+	bool hasState(const char* aState) const noexcept {
+		return std::strncmp(state, aState, sizeof(state)) == 0;
+	}
+
+	/* SQLSTATE class "23", e.g. duplicate key or foreign key violation */
+	bool isIntegrityConstraintViolation() const noexcept {
+		return state[0] == '2' && state[1] == '3';
+	}
+};
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace esl */
+
+#endif /* ESL_DATABASE_ODBCSTATUS_H_ */
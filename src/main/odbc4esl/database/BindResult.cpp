@@ -18,6 +18,8 @@
 
 #include <odbc4esl/database/BindResult.h>
 #include <odbc4esl/database/Driver.h>
+#include <odbc4esl/database/HotPathTrace.h>
+#include <odbc4esl/database/NumberConversion.h>
 
 #include <esl/Logger.h>
 
@@ -33,15 +35,23 @@ esl::Logger logger("odbc4esl::database::BindResult");
 
 constexpr std::size_t BindResult::resultDataSize;
 
-BindResult::BindResult(const StatementHandle& aStatementHandle, const esl::database::Column& aColumn, std::size_t aIndex)
+constexpr std::size_t BindResult::overflowsBeforeGrow;
+
+BindResult::BindResult(const StatementHandle& aStatementHandle, const esl::database::Column& aColumn, std::size_t aIndex, std::size_t initialBufferSize, std::size_t aMaximumBufferSize, bool bind)
 : statementHandle(aStatementHandle),
   column(aColumn),
-  index(aIndex)
+  index(aIndex),
+  bindType(esl::database::ODBCRowColumn::getType(aColumn.getType())),
+  maximumBufferSize(aMaximumBufferSize)
 {
+	boundData = resultData;
 	switch(column.getType()) {
+	case esl::database::Column::Type::sqlBoolean:
 	case esl::database::Column::Type::sqlInteger:
 	case esl::database::Column::Type::sqlSmallInt:
-		Driver::getDriver().bindCol(statementHandle, index, resultInteger, resultIndicator);
+		if(bind) {
+			Driver::getDriver().bindCol(statementHandle, index, resultInteger, resultIndicator);
+		}
 		break;
 
 	case esl::database::Column::Type::sqlDouble:
@@ -49,7 +59,9 @@ BindResult::BindResult(const StatementHandle& aStatementHandle, const esl::datab
 	case esl::database::Column::Type::sqlDecimal:
 	case esl::database::Column::Type::sqlFloat:
 	case esl::database::Column::Type::sqlReal:
-		Driver::getDriver().bindCol(statementHandle, index, resultDouble, resultIndicator);
+		if(bind) {
+			Driver::getDriver().bindCol(statementHandle, index, resultDouble, resultIndicator);
+		}
 		break;
 
 	default:
@@ -67,8 +79,23 @@ BindResult::BindResult(const StatementHandle& aStatementHandle, const esl::datab
 		logger.trace << "BindResult:\n";
 		logger.trace << "- resultIndicator: " << resultIndicator << "\n";
 		//logger.trace << "- valueInputLength: " << valueInputLength << "\n";
-		logger.trace << "- valueInputLength: " << resultDataSize << "\n";
-		Driver::getDriver().bindCol(statementHandle, index, resultData, resultDataSize, resultIndicator);
+
+		/* size learned by previous executions of the same statement */
+		if(initialBufferSize > resultDataSize && initialBufferSize <= maximumBufferSize) {
+			overflowData.resize(initialBufferSize);
+			boundData = overflowData.data();
+			boundDataSize = initialBufferSize;
+		}
+		logger.trace << "- valueInputLength: " << boundDataSize << "\n";
+
+		/* binary and GUID columns have no column type, so the SQL type is only requested for unknown columns */
+		if(column.getType() == esl::database::Column::Type::sqlUnknown && Driver::isBinarySqlType(Driver::getDriver().colAttributeConciseType(statementHandle, static_cast<SQLSMALLINT>(index+1)))) {
+			logger.trace << "- raw bytes\n";
+			cType = SQL_C_BINARY;
+		}
+		if(bind) {
+			Driver::getDriver().bindCol(statementHandle, index, cType, static_cast<SQLPOINTER>(boundData), static_cast<SQLLEN>(boundDataSize), &resultIndicator);
+		}
 		break;
 	}
 
@@ -151,128 +178,292 @@ BindResult::~BindResult() {
 	}
 }
 */
+BindResult::Decoder BindResult::getDecoder(esl::database::Column::Type columnType) noexcept {
+	switch(esl::database::ODBCRowColumn::getType(columnType)) {
+	case esl::database::ODBCRowColumn::Type::integer:
+		return &BindResult::setIntegerField;
+	case esl::database::ODBCRowColumn::Type::floatingPoint:
+		return &BindResult::setDoubleField;
+	default:
+		return &BindResult::setStringField;
+	}
+}
+
+std::shared_ptr<const BindResult::DecodePlan> BindResult::createDecodePlan(const std::vector<esl::database::Column>& columns) {
+	std::shared_ptr<DecodePlan> decodePlan(new DecodePlan);
+
+	decodePlan->reserve(columns.size());
+	for(const auto& column : columns) {
+		decodePlan->push_back(getDecoder(column.getType()));
+	}
+
+	return decodePlan;
+}
+
 void BindResult::setField(esl::database::Field& field) {
+	(this->*getDecoder(column.getType()))(field);
+}
+
+void BindResult::setIntegerField(esl::database::Field& field) {
 	if(isSqlNullData()) {
-		logger.trace << "    Field: NULL\n";
+		ODBC4ESL__HOT_PATH_TRACE << "    Field: NULL\n";
 		field = nullptr;
 		return;
 	}
 
-	switch(column.getType()) {
-	case esl::database::Column::Type::sqlInteger:
-	case esl::database::Column::Type::sqlSmallInt:
-		logger.trace << "    Field: Integer(" << resultInteger << ")\n";
-		field = resultInteger;
-		break;
+	ODBC4ESL__HOT_PATH_TRACE << "    Field: Integer(" << resultInteger << ")\n";
+	field = resultInteger;
+}
 
-	case esl::database::Column::Type::sqlDouble:
-	case esl::database::Column::Type::sqlNumeric:
-	case esl::database::Column::Type::sqlDecimal:
-	case esl::database::Column::Type::sqlFloat:
-	case esl::database::Column::Type::sqlReal:
-		logger.trace << "    Field: Double(" << resultDouble << ")\n";
-		field = resultDouble;
-		break;
+void BindResult::setDoubleField(esl::database::Field& field) {
+	if(isSqlNullData()) {
+		ODBC4ESL__HOT_PATH_TRACE << "    Field: NULL\n";
+		field = nullptr;
+		return;
+	}
 
-	case esl::database::Column::Type::sqlVarChar:
-	case esl::database::Column::Type::sqlChar:
-	default:
-		logger.trace << "    Field: String preamble\n";
-		logger.trace << "    - getResultLength() [0] = " << getResultDataLength() << "\n";
-		//logger.trace << "    - bufferSize            = " << column.getBufferSize() << "\n";
-		logger.trace << "    - bufferSize            = " << resultDataSize << "\n";
-
-		// if(getResultLength() > column.getBufferSize()) {
-		if(isSqlNoTotal()) {
-			throw esl::system::Stacktrace::add(std::runtime_error("(1) getResultLength() == SQL_NO_TOTAL"));
+	ODBC4ESL__HOT_PATH_TRACE << "    Field: Double(" << resultDouble << ")\n";
+	field = resultDouble;
+}
+
+void BindResult::setStringField(esl::database::Field& field) {
+	if(isSqlNullData()) {
+		ODBC4ESL__HOT_PATH_TRACE << "    Field: NULL\n";
+		field = nullptr;
+		return;
+	}
+
+	ODBC4ESL__HOT_PATH_TRACE << "    Field: String preamble\n";
+	ODBC4ESL__HOT_PATH_TRACE << "    - getResultLength() [0] = " << getResultDataLength() << "\n";
+	//logger.trace << "    - bufferSize            = " << column.getBufferSize() << "\n";
+	ODBC4ESL__HOT_PATH_TRACE << "    - bufferSize            = " << boundDataSize << "\n";
+
+	// if(getResultLength() > column.getBufferSize()) {
+	if(isSqlNoTotal()) {
+		throw esl::system::Stacktrace::add(std::runtime_error("(1) getResultLength() == SQL_NO_TOTAL"));
 #if 0
-			std::string str;
-			while(true) {
-				if(isSqlNoTotal()) {
-					throw esl::addStacktrace(std::runtime_error("(2) getResultLength() == SQL_NO_TOTAL"));
-				}
-				if(getResultLength() <= str.size()) {
-					break;
-				}
+		std::string str;
+		while(true) {
+			if(isSqlNoTotal()) {
+				throw esl::addStacktrace(std::runtime_error("(2) getResultLength() == SQL_NO_TOTAL"));
+			}
+			if(getResultLength() <= str.size()) {
+				break;
+			}
+
+			Driver::getDriver().getData(statementHandle, static_cast<SQLUSMALLINT>(index+1),
+					SQL_C_CHAR, valueData,
+					column.getBufferSize(), &resultLength);
 
-				Driver::getDriver().getData(statementHandle, static_cast<SQLUSMALLINT>(index+1),
-						SQL_C_CHAR, valueData,
-						column.getBufferSize(), &resultLength);
+			if(isSqlNullData()) {
+				throw esl::addStacktrace(std::runtime_error("Fetching of column \"" + std::to_string(index) + "\" was SQL_NO_TOTAL but getData() got SQL_NULL_DATA result."));
+			}
 
-				if(isSqlNullData()) {
-					throw esl::addStacktrace(std::runtime_error("Fetching of column \"" + std::to_string(index) + "\" was SQL_NO_TOTAL but getData() got SQL_NULL_DATA result."));
+			//std::string tmpStr;
+			/*
+			if(isNoTotal()) {
+				tmpStr = std::string(valueData, column.getBufferSize());
+				logger.trace << "               valueResultLength == SQL_NO_TOTAL\n";
+			}
+			else {*/
+//				else if(getResultLength() > column.getBufferSize()) {
+				if(getResultLength() < str.size()) {
+					throw esl::addStacktrace(std::runtime_error("getResultLength() (=" + std::to_string(getResultLength()) + ") < str.size() (=" + std::to_string(str.size()) + ")."));
 				}
 
-				//std::string tmpStr;
-				/*
-				if(isNoTotal()) {
-					tmpStr = std::string(valueData, column.getBufferSize());
-					logger.trace << "               valueResultLength == SQL_NO_TOTAL\n";
+				logger.trace << "               getResultLength() = " << getResultLength() << "\n";
+				std::size_t length = getResultLength() - str.size();
+				logger.trace << "               remaining length = " << length << "\n";
+				if(length > column.getBufferSize()) {
+					length = column.getBufferSize();
 				}
-				else {*/
-//				else if(getResultLength() > column.getBufferSize()) {
-					if(getResultLength() < str.size()) {
-						throw esl::addStacktrace(std::runtime_error("getResultLength() (=" + std::to_string(getResultLength()) + ") < str.size() (=" + std::to_string(str.size()) + ")."));
-					}
-
-					logger.trace << "               getResultLength() = " << getResultLength() << "\n";
-					std::size_t length = getResultLength() - str.size();
-					logger.trace << "               remaining length = " << length << "\n";
-					if(length > column.getBufferSize()) {
-						length = column.getBufferSize();
-					}
 //					if(length > 0) {
 //						--length;
 //					}
 
-					logger.trace << "               fetch length = " << length << "\n";
-					if(length > 0) {
-						logger.trace << "               last byte is = " << (int) valueData[length-1] << "\n";
-					}
-					//tmpStr = std::string(valueData, length);
-					str.append(valueData, length-1);
-//				}
-				/*
-				else {
-					tmpStr = std::string(valueData, getResultLength());
-					logger.trace << "               valueResultLength != SQL_NO_TOTAL (" << getResultLength() << ")\n";
+				logger.trace << "               fetch length = " << length << "\n";
+				if(length > 0) {
+					logger.trace << "               last byte is = " << (int) valueData[length-1] << "\n";
 				}
-				*/
-				logger.trace << "               str += \"" << std::string(valueData, length) << "\"\n";
-				//str += tmpStr;
+				//tmpStr = std::string(valueData, length);
+				str.append(valueData, length-1);
+//				}
+			/*
+			else {
+				tmpStr = std::string(valueData, getResultLength());
+				logger.trace << "               valueResultLength != SQL_NO_TOTAL (" << getResultLength() << ")\n";
 			}
+			*/
+			logger.trace << "               str += \"" << std::string(valueData, length) << "\"\n";
+			//str += tmpStr;
+		}
 
-			logger.trace << "    Field: Str(\"" << str << "\")\n";
-			field = str;
+		logger.trace << "    Field: Str(\"" << str << "\")\n";
+		field = str;
 #endif
-		}
-		else if(getResultDataLength() > resultDataSize) {
-			std::size_t tmpBufferSize = getResultDataLength();
-			logger.trace << "    Field: String(...) [" << tmpBufferSize << "]\n";
-			//char* tmpBuffer = new char[tmpBufferSize+1];
-			std::vector<char> tmpBuffer(tmpBufferSize+1);
+	}
+	else {
+		std::string str;
+		readString(str);
+		field = std::move(str);
+	}
+}
 
-			Driver::getDriver().getData(statementHandle, static_cast<SQLUSMALLINT>(index+1),
-					SQL_C_CHAR, &tmpBuffer[0], tmpBufferSize+1, &resultIndicator);
+std::size_t BindResult::getIndex() const noexcept {
+	return index;
+}
 
-			if(isSqlNullData()) {
-				//delete[] tmpBuffer;
-				throw esl::system::Stacktrace::add(std::runtime_error("Fetching of column \"" + std::to_string(index) + "\" was SQL_NO_TOTAL but getData() got SQL_NULL_DATA result."));
-			}
+void BindResult::load() {
+	switch(bindType) {
+	case esl::database::ODBCRowColumn::Type::integer:
+		Driver::getDriver().getData(statementHandle, static_cast<SQLUSMALLINT>(index+1), SQL_C_SBIGINT, &resultInteger, 0, &resultIndicator);
+		break;
+	case esl::database::ODBCRowColumn::Type::floatingPoint:
+		Driver::getDriver().getData(statementHandle, static_cast<SQLUSMALLINT>(index+1), SQL_C_DOUBLE, &resultDouble, 0, &resultIndicator);
+		break;
+	default:
+		loadData();
+		break;
+	}
+}
+
+void BindResult::loadData() {
+	std::size_t terminatorSize = (cType == SQL_C_CHAR) ? 1 : 0;
+
+	/* Long values are read in parts. Before each part the driver reports the remaining length,
+	 * so the buffer is enlarged until the whole value fits and the indicator is set to the full length. */
+	std::size_t offset = 0;
+	while(true) {
+		Driver::getDriver().getData(statementHandle, static_cast<SQLUSMALLINT>(index+1),
+				cType, boundData + offset, boundDataSize - offset, &resultIndicator);
 
-			std::string str(&tmpBuffer[0], tmpBufferSize);
-			tmpBuffer.clear();
-			//logger.trace << "    Field: Str(\"" << str << "\")\n";
-			field = str;
+		if(isSqlNullData()) {
+			return;
 		}
-		else {
-			std::string str(resultData, getResultDataLength());
-			//logger.trace << "    Field: String(\"" << str << "\")\n";
-			field = str;
+		if(!isSqlNoTotal() && offset + getResultDataLength() + terminatorSize <= boundDataSize) {
+			resultIndicator = static_cast<SQLLEN>(offset + getResultDataLength());
+			return;
 		}
-		break;
+
+		std::size_t requiredSize = isSqlNoTotal() ? 2 * boundDataSize : offset + getResultDataLength() + terminatorSize;
+		ODBC4ESL__HOT_PATH_TRACE << "    Load: enlarge buffer of column " << index << " to " << requiredSize << " bytes\n";
+
+		offset = boundDataSize - terminatorSize;
+		if(boundData == resultData) {
+			overflowData.assign(resultData, resultData + offset);
+		}
+		overflowData.resize(requiredSize);
+		boundData = overflowData.data();
+		boundDataSize = requiredSize;
+	}
+}
+
+std::size_t BindResult::getFieldSize() const noexcept {
+	if(resultIndicator < 0) {
+		return 0;
+	}
+	return static_cast<std::size_t>(resultIndicator);
+}
+
+bool BindResult::getInteger(std::int64_t& value) const {
+	if(isSqlNullData()) {
+		return false;
+	}
+	if(bindType == esl::database::ODBCRowColumn::Type::integer) {
+		value = resultInteger;
+		return true;
+	}
+
+	if(bindType != esl::database::ODBCRowColumn::Type::character || cType != SQL_C_CHAR || getResultDataLength() >= boundDataSize
+			|| !NumberConversion::parseInteger(boundData, boundData + getResultDataLength(), value)) {
+		throw esl::system::Stacktrace::add(std::runtime_error("Value of column \"" + column.getName() + "\" is not an integer."));
+	}
+	return true;
+}
+
+bool BindResult::getDouble(double& value) const {
+	if(isSqlNullData()) {
+		return false;
+	}
+	if(bindType == esl::database::ODBCRowColumn::Type::floatingPoint) {
+		value = resultDouble;
+		return true;
+	}
+	if(bindType == esl::database::ODBCRowColumn::Type::integer) {
+		value = static_cast<double>(resultInteger);
+		return true;
+	}
+
+	if(cType != SQL_C_CHAR || getResultDataLength() >= boundDataSize
+			|| !NumberConversion::parseDouble(boundData, boundData + getResultDataLength(), value)) {
+		throw esl::system::Stacktrace::add(std::runtime_error("Value of column \"" + column.getName() + "\" is not a number."));
+	}
+	return true;
+}
+
+bool BindResult::getString(std::string& value) {
+	if(isSqlNullData()) {
+		return false;
+	}
+	if(isSqlNoTotal()) {
+		throw esl::system::Stacktrace::add(std::runtime_error("getResultLength() == SQL_NO_TOTAL"));
+	}
+	readString(value);
+	return true;
+}
+
+void BindResult::readString(std::string& value) {
+	/* character data needs one byte more for the terminating NUL of the driver, binary data does not */
+	std::size_t terminatorSize = (cType == SQL_C_CHAR) ? 1 : 0;
+
+	if(getResultDataLength() + terminatorSize > boundDataSize) {
+		std::size_t tmpBufferSize = getResultDataLength();
+		ODBC4ESL__HOT_PATH_TRACE << "    Field: String(...) [" << tmpBufferSize << "]\n";
+
+		/* read directly into the string */
+		value.resize(tmpBufferSize+terminatorSize);
+
+		Driver::getDriver().getData(statementHandle, static_cast<SQLUSMALLINT>(index+1),
+				cType, &value[0], tmpBufferSize+terminatorSize, &resultIndicator);
+
+		if(isSqlNullData()) {
+			throw esl::system::Stacktrace::add(std::runtime_error("Fetching of column \"" + std::to_string(index) + "\" was SQL_NO_TOTAL but getData() got SQL_NULL_DATA result."));
+		}
+
+		value.resize(tmpBufferSize);
+		grow(tmpBufferSize+terminatorSize);
 	}
+	else {
+		value.assign(boundData, getResultDataLength());
+	}
+}
+
+std::size_t BindResult::getBufferSize() const noexcept {
+	return boundDataSize;
+}
+
+void BindResult::grow(std::size_t requiredSize) {
+	/* a single long value does not justify a larger buffer, repeated ones do */
+	if(++overflowCount < overflowsBeforeGrow || requiredSize > maximumBufferSize) {
+		return;
+	}
+
+	std::size_t size = boundDataSize;
+	while(size < requiredSize) {
+		size *= 2;
+	}
+	if(size > maximumBufferSize) {
+		size = maximumBufferSize;
+	}
+
+	logger.debug << "Grow buffer of column \"" << column.getName() << "\" from " << boundDataSize << " to " << size << " bytes\n";
 
+	/* the new binding takes effect with the next fetch */
+	overflowData.resize(size);
+	boundData = overflowData.data();
+	boundDataSize = size;
+	overflowCount = 0;
+	Driver::getDriver().bindCol(statementHandle, index, cType, static_cast<SQLPOINTER>(boundData), static_cast<SQLLEN>(boundDataSize), &resultIndicator);
 }
 
 std::size_t BindResult::getResultDataLength() const noexcept {
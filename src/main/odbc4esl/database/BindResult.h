@@ -23,12 +23,15 @@
 
 #include <esl/database/Column.h>
 #include <esl/database/Field.h>
+#include <esl/database/ODBCRowLayout.h>
 
 #include <sqlext.h>
 
 #include <string>
 #include <cstdint>
 #include <cstddef>
+#include <memory>
+#include <vector>
 
 namespace odbc4esl {
 inline namespace v1_6 {
@@ -36,7 +39,19 @@ namespace database {
 
 class BindResult {
 public:
-	BindResult(const StatementHandle& statementHandle, const esl::database::Column& column, std::size_t index);
+	/* Converts the last fetched value into a field, selected once by the column type */
+	using Decoder = void (BindResult::*)(esl::database::Field& field);
+
+	/* One decoder per result column, built once and shared by all executions of a prepared statement */
+	using DecodePlan = std::vector<Decoder>;
+
+	static Decoder getDecoder(esl::database::Column::Type columnType) noexcept;
+	static std::shared_ptr<const DecodePlan> createDecodePlan(const std::vector<esl::database::Column>& columns);
+
+	/* Character columns are bound with initialBufferSize bytes if it is larger than the default size.
+	 * If values exceed the buffer repeatedly it grows up to maximumBufferSize bytes.
+	 * If bind is false the column is not bound and its value must be read by load() after each fetch. */
+	BindResult(const StatementHandle& statementHandle, const esl::database::Column& column, std::size_t index, std::size_t initialBufferSize = 0, std::size_t maximumBufferSize = 0, bool bind = true);
 	//virtual ~BindResult();
 
 	BindResult(const BindResult& other) = delete;
@@ -47,7 +62,32 @@ public:
 
 	void setField(esl::database::Field& field);
 
+	/* Index of the result column */
+	std::size_t getIndex() const noexcept;
+
+	/* Reads the value of an unbound column by SQLGetData. Columns must be loaded in ascending order and only once per row. */
+	void load();
+
+	/* Number of bytes the driver reported for the last fetched value, 0 for NULL */
+	std::size_t getFieldSize() const noexcept;
+
+	/* Size of the bound buffer, it can be used as initialBufferSize for the next execution */
+	std::size_t getBufferSize() const noexcept;
+
+	/* Typed access to the last fetched value without dispatching on the column type. They return false for NULL.
+	 * Numbers of character columns are parsed from the bind buffer, an exception is thrown if it is not a number. */
+	bool getInteger(std::int64_t& value) const;
+	bool getDouble(double& value) const;
+	bool getString(std::string& value);
+
 private:
+	void setIntegerField(esl::database::Field& field);
+	void setDoubleField(esl::database::Field& field);
+	void setStringField(esl::database::Field& field);
+	void readString(std::string& value);
+	void loadData();
+	void grow(std::size_t requiredSize);
+
 	std::size_t getResultDataLength() const noexcept;
 	bool isSqlNullData() const noexcept;
 	bool isSqlNoTotal() const noexcept;
@@ -55,6 +95,13 @@ private:
 	const StatementHandle& statementHandle;
 	const esl::database::Column& column;
 	const std::size_t index;
+	const esl::database::ODBCRowColumn::Type bindType;
+
+	/* SQL_C_CHAR, or SQL_C_BINARY for binary and GUID columns */
+	SQLSMALLINT cType = SQL_C_CHAR;
+
+	/* in front of the value buffer, so indicator and numeric values share a cache line */
+	SQLLEN resultIndicator = 0;
 
 	static constexpr std::size_t resultDataSize = 4096;
 
@@ -65,7 +112,13 @@ private:
 		double resultDouble;
 	};
 
-	SQLLEN resultIndicator = 0;
+	/* character values are bound to resultData or, after values did not fit repeatedly, to overflowData */
+	static constexpr std::size_t overflowsBeforeGrow = 2;
+	char* boundData;
+	std::size_t boundDataSize = resultDataSize;
+	std::vector<char> overflowData;
+	const std::size_t maximumBufferSize;
+	std::size_t overflowCount = 0;
 };
 
 } /* namespace database */
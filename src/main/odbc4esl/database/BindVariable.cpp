@@ -18,11 +18,11 @@
 
 #include <odbc4esl/database/BindVariable.h>
 #include <odbc4esl/database/Driver.h>
+#include <odbc4esl/database/HotPathTrace.h>
+#include <odbc4esl/database/NumberConversion.h>
 
 #include <esl/Logger.h>
 
-#include <string.h> // memcpy
-
 namespace odbc4esl {
 inline namespace v1_6 {
 namespace database {
@@ -31,35 +31,22 @@ namespace {
 esl::Logger logger("odbc4esl::database::BindVariable");
 }
 
-BindVariable::BindVariable(const StatementHandle& aStatementHandle, const esl::database::Column& aColumn, std::size_t aIndex)
+BindVariable::BindVariable(const StatementHandle& aStatementHandle, const esl::database::Column& aColumn, std::size_t aIndex, SQLSMALLINT aSqlType)
 : statementHandle(aStatementHandle),
   column(aColumn),
-  index(aIndex)
+  index(aIndex),
+  sqlType(aSqlType)
 {
-	valueString = nullptr;
+	valueInteger = 0;
 }
 
 BindVariable::~BindVariable() {
-	switch(column.getType()) {
-	case esl::database::Column::Type::sqlInteger:
-	case esl::database::Column::Type::sqlSmallInt:
-	case esl::database::Column::Type::sqlDouble:
-	case esl::database::Column::Type::sqlNumeric:
-	case esl::database::Column::Type::sqlDecimal:
-	case esl::database::Column::Type::sqlFloat:
-	case esl::database::Column::Type::sqlReal:
-		break;
-	default:
-		if(valueString) {
-			delete[] valueString;
-		}
-		break;
-	}
 }
 
 void BindVariable::getField(const esl::database::Field& field) {
 	//switch(parameterValues[i].getColumnType()) {
 	switch(column.getType()) {
+	case esl::database::Column::Type::sqlBoolean:
 	case esl::database::Column::Type::sqlInteger:
 	case esl::database::Column::Type::sqlSmallInt:
 		if(field.isNull()) {
@@ -71,7 +58,7 @@ void BindVariable::getField(const esl::database::Field& field) {
 		}
 
 		Driver::getDriver().bindParameter(statementHandle, static_cast<SQLUSMALLINT>(index+1), SQL_PARAM_INPUT,
-				SQL_C_SBIGINT, Driver::columnType2SqlType(column.getType()),
+				SQL_C_SBIGINT, sqlType,
 				column,
 				static_cast<SQLPOINTER>(&valueInteger),
 				0,
@@ -92,7 +79,7 @@ void BindVariable::getField(const esl::database::Field& field) {
 		}
 
 		Driver::getDriver().bindParameter(statementHandle, static_cast<SQLUSMALLINT>(index+1), SQL_PARAM_INPUT,
-				SQL_C_DOUBLE, Driver::columnType2SqlType(column.getType()),
+				SQL_C_DOUBLE, sqlType,
 				column,
 				static_cast<SQLPOINTER>(&valueDouble),
 				0,
@@ -100,24 +87,42 @@ void BindVariable::getField(const esl::database::Field& field) {
 		break;
 
 	default:
-		if(valueString) {
-			delete[] valueString;
-			valueString = nullptr;
-		}
-
 		SQLLEN bufferLength = 0;
 		if(field.isNull()) {
 			resultLength = SQL_NULL_DATA;
+			valueString.assign(1, 0);
+		}
+		else if(field.getColumnType() == esl::database::Column::Type::sqlInteger || field.getColumnType() == esl::database::Column::Type::sqlDouble) {
+			/* numbers are formatted directly into the buffer instead of a temporary string */
+			valueString.resize(NumberConversion::maximumLength + 1);
+			std::size_t length = (field.getColumnType() == esl::database::Column::Type::sqlInteger)
+					? NumberConversion::formatInteger(field.asInteger(), valueString.data())
+					: NumberConversion::formatDouble(field.asDouble(), valueString.data());
+			valueString[length] = 0;
+			bufferLength = length;
+			resultLength = length;
 		}
 		else {
 			std::string str = field.asString();
 			bufferLength = str.size();
 			resultLength = str.size();
 
-			valueString = new char[resultLength+1];
-			logger.trace << "new char[" << (resultLength + 1) << "]\n";
-			memcpy(valueString, str.data(), resultLength);
-			valueString[resultLength] = 0;
+			if(valueString.capacity() < str.size() + 1) {
+				ODBC4ESL__HOT_PATH_TRACE << "enlarge value buffer of parameter " << index << " to " << (resultLength + 1) << " bytes\n";
+				valueString.reserve(str.size() + 1);
+			}
+			valueString.assign(str.begin(), str.end());
+			valueString.push_back(0);
+		}
+
+		if(Driver::isBinarySqlType(sqlType)) {
+			/* raw bytes without terminating NUL */
+			Driver::getDriver().bindParameter(statementHandle, static_cast<SQLUSMALLINT>(index+1), SQL_PARAM_INPUT, SQL_C_BINARY, sqlType,
+					column,
+					static_cast<SQLPOINTER>(valueString.data()),
+					bufferLength,
+					&resultLength);
+			break;
 		}
 
 		/* ..., SQL_C_CHAR, SQL_CHAR,
@@ -128,13 +133,13 @@ void BindVariable::getField(const esl::database::Field& field) {
 		 */
 		Driver::getDriver().bindParameter(statementHandle, static_cast<SQLUSMALLINT>(index+1), SQL_PARAM_INPUT, SQL_C_CHAR, SQL_CHAR,
 				column,
-				static_cast<SQLPOINTER>(valueString),
+				static_cast<SQLPOINTER>(valueString.data()),
 				bufferLength+1,
 				&resultLength);
 		break;
 	}
 
-	if(logger.trace) {
+	if(ODBC4ESL__HOT_PATH_TRACE_ENABLED) {
 		logger.trace << "Parameter " << index << ":\n";
 		//SQLSMALLINT sqlType = Driver::columnType2SqlType(column.getType());
 		logger.trace << "  Column:\n";
@@ -143,7 +148,7 @@ void BindVariable::getField(const esl::database::Field& field) {
 		logger.trace << "    getDisplayLength()   = " << column.getDisplayLength() << "\n";
 		logger.trace << "    getDecimalDigits()   = " << column.getDecimalDigits() << "\n";
 		//logger.trace << "    getType()            = " << column.getType() << "\n";
-		logger.trace << "    sqlType              = " << Driver::columnType2SqlType(column.getType()) << "\n";
+		logger.trace << "    sqlType              = " << sqlType << "\n";
 		logger.trace << "  Parameter:\n";
 		logger.trace << "    getTypeName()        = " << field.getTypeName() << "\n";
 		//logger.trace << "    getColumnType()      = " << field.getColumnType() << "\n";
@@ -153,10 +158,7 @@ void BindVariable::getField(const esl::database::Field& field) {
 		switch(column.getType()) {
 		case esl::database::Column::Type::sqlBoolean:
 			logger.trace << "    Column-Type: sqlBoolean\n";
-			logger.trace << "    -> USE field.asString\n";
-			if(!field.isNull()) {
-				logger.trace << "       setLenght(" << (field.asString().size() + 1) << ")\n";
-			}
+			logger.trace << "    -> USE field.asInteger\n";
 			break;
 		case esl::database::Column::Type::sqlInteger:
 			logger.trace << "    Column-Type: sqlInteger\n";
@@ -29,6 +29,7 @@
 #include <string>
 #include <cstdint>
 #include <cstddef>
+#include <vector>
 
 namespace odbc4esl {
 inline namespace v1_6 {
@@ -36,7 +37,8 @@ namespace database {
 
 struct BindVariable {
 	BindVariable(BindVariable&& other) = delete;
-	BindVariable(const StatementHandle& statementHandle, const esl::database::Column& column, std::size_t index);
+	/* sqlType is the SQL type of the parameter, e.g. SQL_BIGINT, that has no column type of its own */
+	BindVariable(const StatementHandle& statementHandle, const esl::database::Column& column, std::size_t index, SQLSMALLINT sqlType);
 	~BindVariable();
 
 	BindVariable& operator=(const BindVariable&) = delete;
@@ -48,13 +50,16 @@ private:
 	const StatementHandle& statementHandle;
 	const esl::database::Column& column;
 	const std::size_t index;
+	const SQLSMALLINT sqlType;
 
 	union {
-		char* valueString;
 		std::int64_t valueInteger;
 		double valueDouble;
 	};
 
+	/* kept over multiple calls of getField to reuse its capacity */
+	std::vector<char> valueString;
+
 	mutable SQLLEN resultLength = 0;
 };
 
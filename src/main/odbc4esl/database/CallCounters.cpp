@@ -0,0 +1,179 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <odbc4esl/database/CallCounters.h>
+#include <odbc4esl/database/Connection.h>
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+namespace {
+std::atomic<bool> enabled(false);
+
+/* Each thread writes its own counters without contention. Global counters are the sum of
+ * the counters of all running threads plus the counters of all terminated threads. */
+class ThreadCounters;
+
+std::mutex& getRegistryMutex() {
+	static std::mutex registryMutex;
+	return registryMutex;
+}
+
+std::vector<ThreadCounters*>& getRegistry() {
+	static std::vector<ThreadCounters*> registry;
+	return registry;
+}
+
+CallCounters::Shared& getTerminatedThreadCounters() {
+	static CallCounters::Shared terminatedThreadCounters;
+	return terminatedThreadCounters;
+}
+
+class ThreadCounters {
+public:
+	ThreadCounters() {
+		std::lock_guard<std::mutex> lock(getRegistryMutex());
+		getRegistry().push_back(this);
+	}
+
+	~ThreadCounters() {
+		esl::database::ODBCCallCounters::Counters values;
+		counters.getCounters(values);
+
+		std::lock_guard<std::mutex> lock(getRegistryMutex());
+		getTerminatedThreadCounters().add(values);
+		std::vector<ThreadCounters*>& registry = getRegistry();
+		registry.erase(std::remove(registry.begin(), registry.end(), this), registry.end());
+	}
+
+	CallCounters::Shared counters;
+
+	/* values at the last call of resetThreadCounters(), counters itself are never reset */
+	esl::database::ODBCCallCounters::Counters baseline;
+};
+
+ThreadCounters& getThreadCounters() {
+	static thread_local ThreadCounters threadCounters;
+	return threadCounters;
+}
+}
+
+CallCounters::Shared::Shared() noexcept {
+	for(std::size_t i = 0; i < esl::database::ODBCCallCounters::functionCount; ++i) {
+		calls[i].store(0, std::memory_order_relaxed);
+		nanoseconds[i].store(0, std::memory_order_relaxed);
+	}
+}
+
+void CallCounters::Shared::add(Function function, std::uint64_t aNanoseconds) noexcept {
+	std::size_t index = static_cast<std::size_t>(function);
+	calls[index].fetch_add(1, std::memory_order_relaxed);
+	nanoseconds[index].fetch_add(aNanoseconds, std::memory_order_relaxed);
+}
+
+void CallCounters::Shared::addSingleWriter(Function function, std::uint64_t aNanoseconds) noexcept {
+	std::size_t index = static_cast<std::size_t>(function);
+	calls[index].store(calls[index].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	nanoseconds[index].store(nanoseconds[index].load(std::memory_order_relaxed) + aNanoseconds, std::memory_order_relaxed);
+}
+
+void CallCounters::Shared::add(const esl::database::ODBCCallCounters::Counters& counters) noexcept {
+	for(std::size_t i = 0; i < esl::database::ODBCCallCounters::functionCount; ++i) {
+		calls[i].fetch_add(counters.counters[i].calls, std::memory_order_relaxed);
+		nanoseconds[i].fetch_add(counters.counters[i].nanoseconds, std::memory_order_relaxed);
+	}
+}
+
+void CallCounters::Shared::getCounters(esl::database::ODBCCallCounters::Counters& counters) const noexcept {
+	for(std::size_t i = 0; i < esl::database::ODBCCallCounters::functionCount; ++i) {
+		counters.counters[i].calls += calls[i].load(std::memory_order_relaxed);
+		counters.counters[i].nanoseconds += nanoseconds[i].load(std::memory_order_relaxed);
+	}
+}
+
+CallCounters::Call::Call(Function aFunction, const Connection* aConnection) noexcept
+: function(aFunction),
+  connection(aConnection),
+  enabled(database::enabled.load(std::memory_order_relaxed))
+{
+	if(enabled) {
+		start = std::chrono::steady_clock::now();
+	}
+}
+
+CallCounters::Call::~Call() {
+	if(!enabled) {
+		return;
+	}
+
+	std::uint64_t nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+	database::getThreadCounters().counters.addSingleWriter(function, nanoseconds);
+	if(connection) {
+		connection->getCallCounters().add(function, nanoseconds);
+	}
+}
+
+bool CallCounters::isEnabled() noexcept {
+	return enabled.load(std::memory_order_relaxed);
+}
+
+void CallCounters::setEnabled(bool aEnabled) noexcept {
+	enabled.store(aEnabled, std::memory_order_relaxed);
+}
+
+esl::database::ODBCCallCounters::Counters CallCounters::getThreadCounters() {
+	ThreadCounters& threadCounters = database::getThreadCounters();
+
+	esl::database::ODBCCallCounters::Counters counters;
+	threadCounters.counters.getCounters(counters);
+	for(std::size_t i = 0; i < esl::database::ODBCCallCounters::functionCount; ++i) {
+		counters.counters[i].calls -= threadCounters.baseline.counters[i].calls;
+		counters.counters[i].nanoseconds -= threadCounters.baseline.counters[i].nanoseconds;
+	}
+
+	return counters;
+}
+
+void CallCounters::resetThreadCounters() {
+	ThreadCounters& threadCounters = database::getThreadCounters();
+
+	threadCounters.baseline = esl::database::ODBCCallCounters::Counters();
+	threadCounters.counters.getCounters(threadCounters.baseline);
+}
+
+esl::database::ODBCCallCounters::Counters CallCounters::getGlobalCounters() {
+	esl::database::ODBCCallCounters::Counters counters;
+
+	std::lock_guard<std::mutex> lock(getRegistryMutex());
+	getTerminatedThreadCounters().getCounters(counters);
+	for(const ThreadCounters* threadCounters : getRegistry()) {
+		threadCounters->counters.getCounters(counters);
+	}
+
+	return counters;
+}
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
@@ -0,0 +1,89 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ODBC4ESL_DATABASE_CALLCOUNTERS_H_
+#define ODBC4ESL_DATABASE_CALLCOUNTERS_H_
+
+#include <esl/database/ODBCCallCounters.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+class Connection;
+
+class CallCounters {
+public:
+	using Function = esl::database::ODBCCallCounters::Function;
+
+	/* Counters that might be read by other threads while they are written */
+	class Shared {
+	public:
+		Shared() noexcept;
+
+		Shared(const Shared&) = delete;
+		Shared& operator=(const Shared&) = delete;
+
+		void add(Function function, std::uint64_t nanoseconds) noexcept;
+
+		/* Faster than add, but only allowed if there is a single writing thread */
+		void addSingleWriter(Function function, std::uint64_t nanoseconds) noexcept;
+
+		void add(const esl::database::ODBCCallCounters::Counters& counters) noexcept;
+
+		/* adds the values to the given counters */
+		void getCounters(esl::database::ODBCCallCounters::Counters& counters) const noexcept;
+
+	private:
+		std::atomic<std::uint64_t> calls[esl::database::ODBCCallCounters::functionCount];
+		std::atomic<std::uint64_t> nanoseconds[esl::database::ODBCCallCounters::functionCount];
+	};
+
+	/* Counts and times one ODBC call from construction to destruction, if counting is enabled */
+	class Call {
+	public:
+		Call(Function function, const Connection* connection) noexcept;
+		~Call();
+
+		Call(const Call&) = delete;
+		Call& operator=(const Call&) = delete;
+
+	private:
+		const Function function;
+		const Connection* connection;
+		const bool enabled;
+		std::chrono::steady_clock::time_point start;
+	};
+
+	static bool isEnabled() noexcept;
+	static void setEnabled(bool enabled) noexcept;
+
+	static esl::database::ODBCCallCounters::Counters getThreadCounters();
+	static void resetThreadCounters();
+	static esl::database::ODBCCallCounters::Counters getGlobalCounters();
+};
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
+
+#endif /* ODBC4ESL_DATABASE_CALLCOUNTERS_H_ */
@@ -0,0 +1,49 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <odbc4esl/database/CancelHandle.h>
+#include <odbc4esl/database/Driver.h>
+#include <odbc4esl/database/StatementHandlePool.h>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+void CancelHandle::set(const StatementHandle& statementHandle) noexcept {
+	std::lock_guard<std::mutex> lock(mutex);
+	handle = statementHandle.getHandle();
+	pool = statementHandle.getPool();
+}
+
+void CancelHandle::reset() noexcept {
+	std::lock_guard<std::mutex> lock(mutex);
+	handle = SQL_NULL_HANDLE;
+	pool.reset();
+}
+
+void CancelHandle::cancel() {
+	/* the lock keeps the owner from freeing the handle while SQLCancel is running */
+	std::lock_guard<std::mutex> lock(mutex);
+	if(handle != SQL_NULL_HANDLE) {
+		Driver::getDriver().cancel(handle, pool ? pool->getConnection() : nullptr);
+	}
+}
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
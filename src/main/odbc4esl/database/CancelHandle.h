@@ -0,0 +1,55 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ODBC4ESL_DATABASE_CANCELHANDLE_H_
+#define ODBC4ESL_DATABASE_CANCELHANDLE_H_
+
+#include <odbc4esl/database/StatementHandle.h>
+
+#include <sqlext.h>
+
+#include <memory>
+#include <mutex>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+class StatementHandlePool;
+
+/* Statement handle that can be cancelled by another thread while the owner runs a function on it.
+ * The owner resets it before the handle is freed or given away, so cancel() never uses a stale handle. */
+class CancelHandle {
+public:
+	void set(const StatementHandle& statementHandle) noexcept;
+	void reset() noexcept;
+
+	/* Cancels the running function by SQLCancel. Does nothing if there is no handle. */
+	void cancel();
+
+private:
+	std::mutex mutex;
+	SQLHANDLE handle = SQL_NULL_HANDLE;
+	std::shared_ptr<StatementHandlePool> pool;
+};
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
+
+#endif /* ODBC4ESL_DATABASE_CANCELHANDLE_H_ */
@@ -0,0 +1,153 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <odbc4esl/database/CompletionQueue.h>
+
+#include <esl/system/Stacktrace.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <fcntl.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+namespace {
+std::runtime_error systemError(const std::string& function) {
+	return std::runtime_error(function + " failed: " + std::strerror(errno));
+}
+}
+
+CompletionQueue::CompletionQueue() {
+#ifdef __linux__
+	readFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if(readFd == -1) {
+		throw esl::system::Stacktrace::add(systemError("eventfd"));
+	}
+	writeFd = readFd;
+#else
+	int fds[2];
+	if(pipe(fds) == -1) {
+		throw esl::system::Stacktrace::add(systemError("pipe"));
+	}
+	readFd = fds[0];
+	writeFd = fds[1];
+
+	for(int fd : fds) {
+		if(fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) == -1 || fcntl(fd, F_SETFD, FD_CLOEXEC) == -1) {
+			std::runtime_error error = systemError("fcntl");
+			close(readFd);
+			close(writeFd);
+			throw esl::system::Stacktrace::add(error);
+		}
+	}
+#endif
+}
+
+CompletionQueue::~CompletionQueue() {
+	if(writeFd != readFd) {
+		close(writeFd);
+	}
+	close(readFd);
+}
+
+int CompletionQueue::getFd() const noexcept {
+	return readFd;
+}
+
+void CompletionQueue::push(esl::database::ODBCExecutor::Completion completion, std::exception_ptr exception) {
+	std::lock_guard<std::mutex> lock(mutex);
+
+	entries.push_back(Entry{std::move(completion), std::move(exception)});
+	if(!signaled) {
+		signal();
+		signaled = true;
+	}
+}
+
+std::size_t CompletionQueue::run() {
+	std::vector<Entry> runEntries;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		runEntries.swap(entries);
+		if(signaled) {
+			clear();
+			signaled = false;
+		}
+	}
+
+	std::size_t count = 0;
+	try {
+		for(; count < runEntries.size(); ++count) {
+			runEntries[count].completion(runEntries[count].exception);
+		}
+	}
+	catch(...) {
+		/* the remaining completions are put in front of the ones posted in the meantime */
+		std::lock_guard<std::mutex> lock(mutex);
+		entries.insert(entries.begin(), std::make_move_iterator(runEntries.begin() + count + 1), std::make_move_iterator(runEntries.end()));
+		if(!entries.empty() && !signaled) {
+			signal();
+			signaled = true;
+		}
+		throw;
+	}
+
+	return count;
+}
+
+void CompletionQueue::signal() {
+#ifdef __linux__
+	std::uint64_t value = 1;
+	ssize_t rc = write(writeFd, &value, sizeof(value));
+#else
+	char value = 0;
+	ssize_t rc = write(writeFd, &value, sizeof(value));
+#endif
+	/* EAGAIN means the descriptor is readable already */
+	if(rc == -1 && errno != EAGAIN) {
+		throw esl::system::Stacktrace::add(systemError("write"));
+	}
+}
+
+void CompletionQueue::clear() {
+#ifdef __linux__
+	std::uint64_t value;
+	while(read(readFd, &value, sizeof(value)) > 0) {
+	}
+#else
+	char buffer[64];
+	while(read(readFd, buffer, sizeof(buffer)) > 0) {
+	}
+#endif
+}
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
@@ -0,0 +1,70 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ODBC4ESL_DATABASE_COMPLETIONQUEUE_H_
+#define ODBC4ESL_DATABASE_COMPLETIONQUEUE_H_
+
+#include <esl/database/ODBCExecutor.h>
+
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <vector>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+/* Completions posted by worker threads. The file descriptor is signaled once when the queue becomes non-empty
+ * and cleared when the completions are taken, so the consumer is not woken up per completion. */
+class CompletionQueue {
+public:
+	CompletionQueue();
+	~CompletionQueue();
+
+	CompletionQueue(const CompletionQueue&) = delete;
+	CompletionQueue& operator=(const CompletionQueue&) = delete;
+
+	int getFd() const noexcept;
+
+	void push(esl::database::ODBCExecutor::Completion completion, std::exception_ptr exception);
+	std::size_t run();
+
+private:
+	struct Entry {
+		esl::database::ODBCExecutor::Completion completion;
+		std::exception_ptr exception;
+	};
+
+	void signal();
+	void clear();
+
+	std::mutex mutex;
+	std::vector<Entry> entries;
+	bool signaled = false;
+
+	/* both are the same eventfd on Linux */
+	int readFd = -1;
+	int writeFd = -1;
+};
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
+
+#endif /* ODBC4ESL_DATABASE_COMPLETIONQUEUE_H_ */
@@ -17,7 +17,10 @@
  */
 
 #include <odbc4esl/database/Connection.h>
+#include <odbc4esl/database/Deadline.h>
+#include <odbc4esl/database/DirectStatement.h>
 #include <odbc4esl/database/Driver.h>
+#include <odbc4esl/database/Metrics.h>
 #include <odbc4esl/database/PreparedBulkStatementBinding.h>
 #include <odbc4esl/database/PreparedStatementBinding.h>
 
@@ -29,6 +32,7 @@
 #include <esl/monitoring/Streams.h>
 #include <esl/system/Stacktrace.h>
 
+#include <chrono>
 #include <memory>
 #include <stdexcept>
 
@@ -45,10 +49,15 @@ std::set<std::string> implementations{{"unixODBC"}};
 Connection::Connection(const ConnectionFactory& connectionFactory)
 : handle(Driver::getDriver().allocHandleConnection(connectionFactory)),
   defaultBufferSize(connectionFactory.getSettings().defaultBufferSize),
-  maximumBufferSize(connectionFactory.getSettings().maximumBufferSize)
+  maximumBufferSize(connectionFactory.getSettings().maximumBufferSize),
+  statementHandlePool(std::make_shared<StatementHandlePool>(*this, connectionFactory.getSettings().statementHandlePoolSize))
 {
 	ESL__LOGGER_TRACE_THIS("create connection\n");
 
+	slowStatementSettings.threshold = std::chrono::milliseconds(connectionFactory.getSettings().slowStatementThreshold);
+	slowStatementSettings.captureParameters = connectionFactory.getSettings().slowStatementCaptureParams;
+	slowStatementSettings.redactParameters = connectionFactory.getSettings().slowStatementRedactParams;
+
     // disable autocommit
     Driver::getDriver().setConnectAttr(*this, SQL_ATTR_AUTOCOMMIT, (SQLPOINTER)SQL_AUTOCOMMIT_OFF, SQL_NTS);
 
@@ -60,9 +69,14 @@ Connection::~Connection() {
 	location.function = __func__;
 	location.file = __FILE__;
 
+	/* statement handles that outlive the connection must not use it anymore */
+	ESL__LOGGER_TRACE_THIS("free pooled statement handles\n");
+	statementHandlePool->close();
+
 	try {
 		if(!isClosed()) {
 		    rollback();
+
 			Driver::getDriver().disconnect(*this);
 			handle = SQL_NULL_HDBC;
 		}
@@ -105,6 +119,14 @@ SQLHANDLE Connection::getHandle() const {
 	return handle;
 }
 
+std::size_t Connection::getDefaultBufferSize() const noexcept {
+	return defaultBufferSize;
+}
+
+std::size_t Connection::getMaximumBufferSize() const noexcept {
+	return maximumBufferSize;
+}
+
 esl::database::PreparedStatement Connection::prepare(const std::string& sql) const {
 	return esl::database::PreparedStatement(std::unique_ptr<esl::database::PreparedStatement::Binding>(new PreparedStatementBinding(*this, sql, defaultBufferSize, maximumBufferSize)));
 }
@@ -113,10 +135,31 @@ esl::database::PreparedBulkStatement Connection::prepareBulk(const std::string&
 	return esl::database::PreparedBulkStatement(std::unique_ptr<esl::database::PreparedBulkStatement::Binding>(new PreparedBulkStatementBinding(*this, sql, defaultBufferSize, maximumBufferSize)));
 }
 
+std::unique_ptr<esl::database::ODBCPreparedStatement> Connection::prepareODBC(const std::string& sql) const {
+	return std::unique_ptr<esl::database::ODBCPreparedStatement>(new PreparedStatementBinding(*this, sql, defaultBufferSize, maximumBufferSize));
+}
+
+std::unique_ptr<esl::database::ODBCPreparedBulkStatement> Connection::prepareBulkODBC(const std::string& sql) const {
+	return std::unique_ptr<esl::database::ODBCPreparedBulkStatement>(new PreparedBulkStatementBinding(*this, sql, defaultBufferSize, maximumBufferSize));
+}
+
+const SlowStatementLog::Settings& Connection::getSlowStatementSettings() const noexcept {
+	return slowStatementSettings;
+}
+
+CallCounters::Shared& Connection::getCallCounters() const noexcept {
+	return callCounters;
+}
+
+std::unique_ptr<esl::database::ODBCResultSet> Connection::executeDirect(const std::string& sql, const std::vector<esl::database::Field>& parameterValues) const {
+	return DirectStatement::execute(*this, sql, parameterValues);
+}
+
 void Connection::commit() const {
 	if(!isClosed()) {
+		Deadline::check("SQLEndTran");
 		ESL__LOGGER_TRACE_THIS("Do commit\n");
-		Driver::getDriver().endTran(*this, SQL_COMMIT);
+		endTran(SQL_COMMIT);
 	}
 	else {
 		ESL__LOGGER_TRACE_THIS("NO commit, connection already closed\n");
@@ -125,8 +168,26 @@ void Connection::commit() const {
 
 void Connection::rollback() const {
 	if(!isClosed()) {
-		Driver::getDriver().endTran(*this, SQL_ROLLBACK);
+		endTran(SQL_ROLLBACK);
+	}
+}
+
+void Connection::endTran(SQLSMALLINT completionType) const {
+	Metrics& metrics = Metrics::getMetrics();
+	if(!metrics.isEnabled()) {
+		Driver::getDriver().endTran(*this, completionType);
+		return;
+	}
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	try {
+		Driver::getDriver().endTran(*this, completionType);
+	}
+	catch(...) {
+		++metrics.transactionErrors;
+		throw;
 	}
+	(completionType == SQL_COMMIT ? metrics.commit : metrics.rollback).add(std::chrono::steady_clock::now() - start);
 }
 
 bool Connection::isClosed() const {
@@ -141,6 +202,9 @@ const std::set<std::string>& Connection::getImplementations() const {
 	return implementations;
 }
 
+StatementHandle Connection::acquireStatementHandle() const {
+	return statementHandlePool->acquire();
+}
 
 } /* namespace database */
 } /* inline namespace v1_6 */
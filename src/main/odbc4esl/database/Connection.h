@@ -19,9 +19,16 @@
 #ifndef ODBC4ESL_DATABASE_CONNECTION_H_
 #define ODBC4ESL_DATABASE_CONNECTION_H_
 
+#include <odbc4esl/database/CallCounters.h>
 #include <odbc4esl/database/ConnectionFactory.h>
+#include <odbc4esl/database/SlowStatementLog.h>
+#include <odbc4esl/database/StatementHandle.h>
+#include <odbc4esl/database/StatementHandlePool.h>
 
 #include <esl/database/Connection.h>
+#include <esl/database/ODBCConnection.h>
+#include <esl/database/ODBCPreparedBulkStatement.h>
+#include <esl/database/ODBCPreparedStatement.h>
 #include <esl/database/PreparedStatement.h>
 #include <esl/database/PreparedBulkStatement.h>
 #include <esl/database/ResultSet.h>
@@ -29,6 +36,7 @@
 
 #include <sqlext.h>
 
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -37,15 +45,20 @@ namespace odbc4esl {
 inline namespace v1_6 {
 namespace database {
 
-class Connection : public esl::database::Connection {
+class Connection : public esl::database::ODBCConnection {
 public:
 	Connection(const ConnectionFactory& connectionFactory);
 	~Connection();
 
 	SQLHANDLE getHandle() const;
+	std::size_t getDefaultBufferSize() const noexcept;
+	std::size_t getMaximumBufferSize() const noexcept;
 
 	esl::database::PreparedStatement prepare(const std::string& sql) const override;
 	esl::database::PreparedBulkStatement prepareBulk(const std::string& sql) const override;
+	std::unique_ptr<esl::database::ODBCPreparedStatement> prepareODBC(const std::string& sql) const override;
+	std::unique_ptr<esl::database::ODBCPreparedBulkStatement> prepareBulkODBC(const std::string& sql) const override;
+	std::unique_ptr<esl::database::ODBCResultSet> executeDirect(const std::string& sql, const std::vector<esl::database::Field>& parameterValues) const override;
 	//esl::database::ResultSet getTable(const std::string& tableName);
 
 	void commit() const override;
@@ -56,10 +69,22 @@ public:
 
 	const std::set<std::string>& getImplementations() const override;
 
+	/* Takes a statement handle from the pool or allocates a new one if the pool is empty */
+	StatementHandle acquireStatementHandle() const;
+
+	const SlowStatementLog::Settings& getSlowStatementSettings() const noexcept;
+
+	CallCounters::Shared& getCallCounters() const noexcept;
+
 private:
+	void endTran(SQLSMALLINT completionType) const;
+
 	SQLHANDLE handle;
 	std::size_t defaultBufferSize;
 	std::size_t maximumBufferSize;
+	SlowStatementLog::Settings slowStatementSettings;
+	mutable CallCounters::Shared callCounters;
+	std::shared_ptr<StatementHandlePool> statementHandlePool;
 };
 
 } /* namespace database */
@@ -17,8 +17,11 @@
  */
 
 #include <odbc4esl/database/ConnectionFactory.h>
+#include <odbc4esl/database/CallCounters.h>
 #include <odbc4esl/database/Connection.h>
 #include <odbc4esl/database/Driver.h>
+#include <odbc4esl/database/InfoDiagnostics.h>
+#include <odbc4esl/database/Metrics.h>
 
 #include <esl/Logger.h>
 
@@ -26,6 +29,7 @@
 #include <esl/monitoring/Streams.h>
 #include <esl/system/Stacktrace.h>
 
+#include <chrono>
 #include <stdexcept>
 
 namespace odbc4esl {
@@ -42,6 +46,21 @@ ConnectionFactory::ConnectionFactory(esl::database::ODBCConnectionFactory::Setti
 {
   	// switch to ODBC 3.0
   	Driver::getDriver().setEnvAttr(*this, SQL_ATTR_ODBC_VERSION, (void *)SQL_OV_ODBC3, 0);
+
+	/* InfoDiagnostics, Metrics and CallCounters are process wide. Don't reset settings of other factories to defaults. */
+	if(settings.hasSuccessWithInfoLogInterval) {
+		InfoDiagnostics::getInfoDiagnostics().setLogInterval(std::chrono::milliseconds(settings.successWithInfoLogInterval));
+	}
+	for(const auto& state : settings.successWithInfoMutedStates) {
+		InfoDiagnostics::getInfoDiagnostics().mute(state);
+	}
+
+	if(settings.hasMetricsEnabled) {
+		Metrics::getMetrics().setEnabled(settings.metricsEnabled);
+	}
+	if(settings.hasCallCounters) {
+		CallCounters::setEnabled(settings.callCounters);
+	}
 }
 
 ConnectionFactory::~ConnectionFactory() {
@@ -50,6 +69,9 @@ ConnectionFactory::~ConnectionFactory() {
 	location.file = __FILE__;
 
 	try {
+		/* the last occurrences before the factory is destroyed would not be logged otherwise */
+		InfoDiagnostics::getInfoDiagnostics().logSummary();
+
 		Driver::getDriver().freeHandle(*this);
 		handle = SQL_NULL_HENV;
 	}
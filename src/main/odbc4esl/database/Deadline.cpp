@@ -0,0 +1,60 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <odbc4esl/database/Deadline.h>
+
+#include <esl/database/ODBCDeadline.h>
+#include <esl/system/Stacktrace.h>
+
+#include <chrono>
+#include <stdexcept>
+#include <string>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+void Deadline::check(const char* operation) {
+	std::chrono::steady_clock::time_point deadline;
+	if(esl::database::ODBCDeadline::get(deadline) && std::chrono::steady_clock::now() >= deadline) {
+		throw esl::system::Stacktrace::add(std::runtime_error(std::string("Deadline exceeded before ") + operation));
+	}
+}
+
+std::size_t Deadline::getQueryTimeout(std::size_t queryTimeout, const char* operation) {
+	std::chrono::steady_clock::time_point deadline;
+	if(!esl::database::ODBCDeadline::get(deadline)) {
+		return queryTimeout;
+	}
+
+	std::chrono::steady_clock::duration remaining = deadline - std::chrono::steady_clock::now();
+	if(remaining <= std::chrono::steady_clock::duration::zero()) {
+		throw esl::system::Stacktrace::add(std::runtime_error(std::string("Deadline exceeded before ") + operation));
+	}
+
+	/* rounded up, because 0 would disable the timeout */
+	std::size_t seconds = static_cast<std::size_t>((remaining + std::chrono::seconds(1) - std::chrono::steady_clock::duration(1)) / std::chrono::seconds(1));
+	if(queryTimeout == 0 || seconds < queryTimeout) {
+		return seconds;
+	}
+	return queryTimeout;
+}
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
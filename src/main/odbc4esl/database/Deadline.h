@@ -0,0 +1,43 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ODBC4ESL_DATABASE_DEADLINE_H_
+#define ODBC4ESL_DATABASE_DEADLINE_H_
+
+#include <cstddef>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+/* Applies esl::database::ODBCDeadline of the current thread */
+class Deadline {
+public:
+	/* Throws an exception if the deadline has passed */
+	static void check(const char* operation);
+
+	/* Query timeout in seconds for the next execution, 0 means no timeout.
+	 * It is the configured timeout limited by the remaining time. Throws an exception if the deadline has passed. */
+	static std::size_t getQueryTimeout(std::size_t queryTimeout, const char* operation);
+};
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
+
+#endif /* ODBC4ESL_DATABASE_DEADLINE_H_ */
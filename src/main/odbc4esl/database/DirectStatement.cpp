@@ -0,0 +1,130 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <odbc4esl/database/DirectStatement.h>
+#include <odbc4esl/database/BindVariable.h>
+#include <odbc4esl/database/Connection.h>
+#include <odbc4esl/database/Deadline.h>
+#include <odbc4esl/database/Driver.h>
+#include <odbc4esl/database/Metrics.h>
+#include <odbc4esl/database/ResultSetBinding.h>
+#include <odbc4esl/database/StatementHandle.h>
+#include <odbc4esl/database/StatementTiming.h>
+
+#include <esl/Logger.h>
+
+#include <chrono>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+namespace {
+esl::Logger logger("odbc4esl::database::DirectStatement");
+
+/* integer fields have 64 bit, so they are bound as SQL_BIGINT */
+SQLSMALLINT getParameterSqlType(const esl::database::Column& column) {
+	switch(column.getType()) {
+	case esl::database::Column::Type::sqlInteger:
+	case esl::database::Column::Type::sqlSmallInt:
+		return SQL_BIGINT;
+	default:
+		break;
+	}
+	return Driver::columnType2SqlType(column.getType());
+}
+}
+
+std::unique_ptr<esl::database::ODBCResultSet> DirectStatement::execute(const Connection& connection, const std::string& sql, const std::vector<esl::database::Field>& parameterValues) {
+	logger.trace << "Execute direct SQL \"" << sql << "\"\n";
+
+	std::shared_ptr<Metrics::Statement> statementMetrics;
+	if(Metrics::getMetrics().isEnabled()) {
+		statementMetrics = Metrics::getMetrics().getStatement(sql);
+	}
+
+	StatementHandle statementHandle(connection.acquireStatementHandle());
+
+	std::size_t queryTimeout = Deadline::getQueryTimeout(0, "SQLExecDirect");
+	if(queryTimeout > 0) {
+		Driver::getDriver().setStmtAttr(statementHandle, SQL_ATTR_QUERY_TIMEOUT, reinterpret_cast<SQLPOINTER>(static_cast<SQLULEN>(queryTimeout)), 0);
+		statementHandle.setAttributesChanged();
+	}
+
+	/* columns and variables must stay alive until SQLExecDirect returned */
+	std::vector<esl::database::Column> parameterColumns;
+	parameterColumns.reserve(parameterValues.size());
+	for(const auto& parameterValue : parameterValues) {
+		parameterColumns.push_back(createParameterColumn(parameterValue, connection.getDefaultBufferSize(), connection.getMaximumBufferSize()));
+	}
+
+	std::vector<std::unique_ptr<BindVariable>> parameterVariables(parameterValues.size());
+	for(std::size_t i=0; i<parameterValues.size(); ++i) {
+		parameterVariables[i].reset(new BindVariable(statementHandle, parameterColumns[i], i, getParameterSqlType(parameterColumns[i])));
+		parameterVariables[i]->getField(parameterValues[i]);
+	}
+
+	StatementTiming statementTiming(statementMetrics, connection.getSlowStatementSettings(), sql, parameterValues);
+	Driver::getDriver().execDirect(statementHandle, sql);
+	statementTiming.executed(true);
+
+	std::vector<esl::database::Column> resultColumns = ResultSetBinding::describeColumns(statementHandle, connection.getDefaultBufferSize(), connection.getMaximumBufferSize());
+	while(resultColumns.empty()) {
+		if(!Driver::getDriver().moreResults(statementHandle)) {
+			return nullptr;
+		}
+		resultColumns = ResultSetBinding::describeColumns(statementHandle, connection.getDefaultBufferSize(), connection.getMaximumBufferSize());
+	}
+
+	/* the result set outlives the parameter variables, so the driver must not reference their buffers anymore */
+	if(!parameterVariables.empty()) {
+		Driver::getDriver().freeStmt(statementHandle, SQL_RESET_PARAMS);
+	}
+
+	return std::unique_ptr<esl::database::ODBCResultSet>(new ResultSetBinding(std::move(statementHandle), resultColumns, statementMetrics, statementTiming.getExecuteStart(), statementTiming.releaseSlowStatementLog()));
+}
+
+esl::database::Column DirectStatement::createParameterColumn(const esl::database::Field& field, std::size_t defaultBufferSize, std::size_t maximumBufferSize) {
+	esl::database::Column::Type columnType = field.isNull() ? esl::database::Column::Type::sqlVarChar : field.getColumnType();
+	std::size_t characterLength = 0;
+
+	switch(columnType) {
+	case esl::database::Column::Type::sqlInteger:
+	case esl::database::Column::Type::sqlSmallInt:
+	case esl::database::Column::Type::sqlDouble:
+	case esl::database::Column::Type::sqlNumeric:
+	case esl::database::Column::Type::sqlDecimal:
+	case esl::database::Column::Type::sqlFloat:
+	case esl::database::Column::Type::sqlReal:
+		break;
+	default:
+		/* BindVariable binds everything else as SQL_C_CHAR, so the column size is the length of the string */
+		columnType = esl::database::Column::Type::sqlVarChar;
+		characterLength = field.isNull() ? 1 : field.asString().size();
+		if(characterLength == 0) {
+			characterLength = 1;
+		}
+		break;
+	}
+
+	return esl::database::Column("", columnType, true, defaultBufferSize, maximumBufferSize, characterLength, 0, characterLength);
+}
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
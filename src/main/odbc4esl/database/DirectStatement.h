@@ -0,0 +1,50 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ODBC4ESL_DATABASE_DIRECTSTATEMENT_H_
+#define ODBC4ESL_DATABASE_DIRECTSTATEMENT_H_
+
+#include <esl/database/Column.h>
+#include <esl/database/Field.h>
+#include <esl/database/ODBCResultSet.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+class Connection;
+
+/* One-shot execution by SQLExecDirect. In contrast to PreparedStatementBinding there is no SQLPrepare and
+ * no SQLDescribeParam. Result columns are described only after execution and only if there is a result set. */
+class DirectStatement {
+public:
+	static std::unique_ptr<esl::database::ODBCResultSet> execute(const Connection& connection, const std::string& sql, const std::vector<esl::database::Field>& parameterValues);
+
+	/* Parameter column derived from the type of the field instead of asking the driver */
+	static esl::database::Column createParameterColumn(const esl::database::Field& field, std::size_t defaultBufferSize, std::size_t maximumBufferSize);
+};
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
+
+#endif /* ODBC4ESL_DATABASE_DIRECTSTATEMENT_H_ */
@@ -17,7 +17,9 @@
  */
 
 #include <odbc4esl/database/Driver.h>
+#include <odbc4esl/database/CallCounters.h>
 #include <odbc4esl/database/Diagnostics.h>
+#include <odbc4esl/database/InfoDiagnostics.h>
 
 #include <esl/Logger.h>
 
@@ -35,21 +37,13 @@ namespace database {
 namespace {
 esl::Logger logger("odbc4esl::database::Driver");
 
-void checkAndThrow(SQLRETURN rc, SQLSMALLINT type, SQLHANDLE handle, const char* operation) {
+void checkAndThrow(SQLRETURN rc, SQLSMALLINT type, SQLHANDLE handle, CallCounters::Function function, const char* operation) {
 	switch(rc) {
 	case SQL_SUCCESS:
 		break;
-	case SQL_SUCCESS_WITH_INFO: {
-		if(operation) {
-			logger.warn << "Function \"" << operation << "\" returned SQL_SUCCESS_WITH_INFO:\n";
-		}
-		else {
-			logger.warn << "Function returned SQL_SUCCESS_WITH_INFO:\n";
-		}
-		Diagnostics diagnostics(type, handle);
-		diagnostics.dump(logger.warn);
+	case SQL_SUCCESS_WITH_INFO:
+		InfoDiagnostics::getInfoDiagnostics().add(type, handle, function, operation);
 		break;
-	}
 	case SQL_INVALID_HANDLE: {
 		if(operation) {
 			throw esl::system::Stacktrace::add(std::runtime_error(std::string(operation) + " returned SQL_INVALID_HANDLE"));
@@ -80,6 +74,47 @@ void checkAndThrow(SQLRETURN rc, SQLSMALLINT type, SQLHANDLE handle, const char*
 	}
 	}
 }
+
+/* Like checkAndThrow, but SQL_ERROR is reported by status instead of an exception */
+bool checkAndSetStatus(SQLRETURN rc, SQLSMALLINT type, SQLHANDLE handle, CallCounters::Function function, const char* operation, esl::database::ODBCStatus& status, bool withMessage) {
+	switch(rc) {
+	case SQL_NO_DATA:
+		return true;
+	case SQL_ERROR:
+		break;
+	default:
+		checkAndThrow(rc, type, handle, function, operation);
+		return true;
+	}
+
+	status.success = false;
+
+	SQLCHAR sqlstate[SQL_SQLSTATE_SIZE + 1];
+	SQLINTEGER sqlcode = 0;
+	SQLSMALLINT length = 0;
+
+	if(withMessage) {
+		SQLCHAR message[SQL_MAX_MESSAGE_LENGTH + 1];
+		CallCounters::Call call(CallCounters::Function::getDiagRec, nullptr);
+		rc = SQLGetDiagRec(type, handle, 1, sqlstate, &sqlcode, message, SQL_MAX_MESSAGE_LENGTH, &length);
+		if(rc == SQL_SUCCESS || rc == SQL_SUCCESS_WITH_INFO) {
+			status.message = std::string(reinterpret_cast<char*>(message), std::min<SQLSMALLINT>(length, SQL_MAX_MESSAGE_LENGTH));
+		}
+	}
+	else {
+		// message text is not requested, so SQL_SUCCESS_WITH_INFO is returned because of truncation
+		CallCounters::Call call(CallCounters::Function::getDiagRec, nullptr);
+		rc = SQLGetDiagRec(type, handle, 1, sqlstate, &sqlcode, NULL, 0, &length);
+	}
+
+	if(rc == SQL_SUCCESS || rc == SQL_SUCCESS_WITH_INFO) {
+		sqlstate[SQL_SQLSTATE_SIZE] = 0;
+		std::copy(sqlstate, sqlstate + SQL_SQLSTATE_SIZE + 1, status.state);
+		status.nativeCode = sqlcode;
+	}
+
+	return false;
+}
 }
 
 const Driver& Driver::getDriver() {
@@ -97,9 +132,14 @@ esl::database::Column::Type Driver::sqlType2ColumnType(SQLSMALLINT sqlType) {
 //	case SQL_BOOLEAN:
 //		return esl::database::Column::Type::sqlBoolean;
 
+	case SQL_BIT:
+		return esl::database::Column::Type::sqlBoolean;
+
+	case SQL_BIGINT:
 	case SQL_INTEGER:
 		return esl::database::Column::Type::sqlInteger;
 	case SQL_SMALLINT:
+	case SQL_TINYINT:
 		return esl::database::Column::Type::sqlSmallInt;
 
 	case SQL_DOUBLE:
@@ -116,6 +156,7 @@ esl::database::Column::Type Driver::sqlType2ColumnType(SQLSMALLINT sqlType) {
 	case SQL_CHAR:
 		return esl::database::Column::Type::sqlChar;
 	case SQL_VARCHAR:
+	case SQL_LONGVARCHAR:
 		return esl::database::Column::Type::sqlVarChar;
 
 	case SQL_DATETIME:
@@ -148,8 +189,8 @@ esl::database::Column::Type Driver::sqlType2ColumnType(SQLSMALLINT sqlType) {
 
 SQLSMALLINT Driver::columnType2SqlType(esl::database::Column::Type columnType) {
 	switch(columnType) {
-//	case esl::database::Column::Type::sqlBoolean:
-//		return SQL_BOOLEAN;
+	case esl::database::Column::Type::sqlBoolean:
+		return SQL_BIT;
 
 	case esl::database::Column::Type::sqlInteger:
 		return SQL_INTEGER;
@@ -200,47 +241,96 @@ SQLSMALLINT Driver::columnType2SqlType(esl::database::Column::Type columnType) {
 	return SQL_UNKNOWN_TYPE;
 }
 
+bool Driver::isBinarySqlType(SQLSMALLINT sqlType) noexcept {
+	switch(sqlType) {
+	case SQL_BINARY:
+	case SQL_VARBINARY:
+	case SQL_LONGVARBINARY:
+	case SQL_GUID:
+		return true;
+	default:
+		break;
+	}
+	return false;
+}
+
 SQLHANDLE Driver::allocHandleEnvironment() const {
 	SQLHANDLE newHandle;
+	CallCounters::Call call(CallCounters::Function::allocHandle, nullptr);
 	SQLRETURN rc = SQLAllocHandle(SQL_HANDLE_ENV, SQL_NULL_HENV, &newHandle);
 
-	checkAndThrow(rc, SQL_HANDLE_ENV, SQL_NULL_HENV, "SQLAllocHandle for environment");
+	checkAndThrow(rc, SQL_HANDLE_ENV, SQL_NULL_HENV, CallCounters::Function::allocHandle, "SQLAllocHandle for environment");
 
 	return newHandle;
 }
 
 SQLHANDLE Driver::allocHandleConnection(const ConnectionFactory& connectionFactory) const {
 	SQLHANDLE newHandle;
+	CallCounters::Call call(CallCounters::Function::allocHandle, nullptr);
 	SQLRETURN rc = SQLAllocHandle(SQL_HANDLE_DBC, connectionFactory.getHandle(), &newHandle);
 
-	checkAndThrow(rc, SQL_HANDLE_ENV, connectionFactory.getHandle(), "SQLAllocHandle for connection");
+	checkAndThrow(rc, SQL_HANDLE_ENV, connectionFactory.getHandle(), CallCounters::Function::allocHandle, "SQLAllocHandle for connection");
+
+	return newHandle;
+}
+
+SQLHANDLE Driver::allocHandleStatement(const Connection& connection) const {
+	SQLHANDLE newHandle;
+	CallCounters::Call call(CallCounters::Function::allocHandle, &connection);
+	SQLRETURN rc = SQLAllocHandle(SQL_HANDLE_STMT, connection.getHandle(), &newHandle);
+
+	checkAndThrow(rc, SQL_HANDLE_DBC, connection.getHandle(), CallCounters::Function::allocHandle, "SQLAllocHandle for statement");
 
 	return newHandle;
 }
 
 void Driver::freeHandle(const ConnectionFactory& connectionFactory) const {
+	CallCounters::Call call(CallCounters::Function::freeHandle, nullptr);
 	SQLRETURN rc = SQLFreeHandle(SQL_HANDLE_ENV, connectionFactory.getHandle());
 
-	checkAndThrow(rc, SQL_HANDLE_ENV, connectionFactory.getHandle(), "SQLFreeHandle for environment handle");
+	checkAndThrow(rc, SQL_HANDLE_ENV, connectionFactory.getHandle(), CallCounters::Function::freeHandle, "SQLFreeHandle for environment handle");
 }
 
 void Driver::freeHandle(const Connection& connection) const {
+	CallCounters::Call call(CallCounters::Function::freeHandle, &connection);
 	SQLRETURN rc = SQLFreeHandle(SQL_HANDLE_DBC, connection.getHandle());
 
-	checkAndThrow(rc, SQL_HANDLE_DBC, connection.getHandle(), "SQLFreeHandle for connection handle");
+	checkAndThrow(rc, SQL_HANDLE_DBC, connection.getHandle(), CallCounters::Function::freeHandle, "SQLFreeHandle for connection handle");
 }
 
 void Driver::freeHandle(const StatementHandle& statementHandle) const {
 	// TODO: Do not throw: StatementHandles seems to be closed already after fetch() returned SQL_NO_DATA
+	CallCounters::Call call(CallCounters::Function::freeHandle, statementHandle.getConnection());
+
 #if 1
 	SQLFreeHandle(SQL_HANDLE_STMT, statementHandle.getHandle());
 #else
 	SQLRETURN rc = SQLFreeHandle(SQL_HANDLE_STMT, statementHandle.getHandle());
 
-	checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), "SQLFreeHandle for statement handle");
+	checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), CallCounters::Function::freeHandle, "SQLFreeHandle for statement handle");
 #endif
 }
 
+void Driver::freeStmt(const StatementHandle& statementHandle, SQLUSMALLINT option) const {
+	CallCounters::Call call(CallCounters::Function::freeStmt, statementHandle.getConnection());
+	SQLRETURN rc = SQLFreeStmt(statementHandle.getHandle(), option);
+
+	switch(option) {
+	case SQL_CLOSE:
+		checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), CallCounters::Function::freeStmt, "SQLFreeStmt with SQL_CLOSE");
+		break;
+	case SQL_UNBIND:
+		checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), CallCounters::Function::freeStmt, "SQLFreeStmt with SQL_UNBIND");
+		break;
+	case SQL_RESET_PARAMS:
+		checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), CallCounters::Function::freeStmt, "SQLFreeStmt with SQL_RESET_PARAMS");
+		break;
+	default:
+		checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), CallCounters::Function::freeStmt, "SQLFreeStmt");
+		break;
+	}
+}
+
 #if 0
 void Driver::freeHandle(SQLSMALLINT type, SQLHANDLE handle) const {
 	SQLRETURN rc = SQLFreeHandle(type, handle);
@@ -261,24 +351,32 @@ void Driver::freeHandle(SQLSMALLINT type, SQLHANDLE handle) const {
 		break;
 	*/
 	case SQL_HANDLE_DESC:
-		checkAndThrow(rc, type, handle, "SQLFreeHandle for descriptor handle");
+		checkAndThrow(rc, type, handle, CallCounters::Function::freeHandle, "SQLFreeHandle for descriptor handle");
 		break;
 	default:
-		checkAndThrow(rc, type, handle, "SQLFreeHandle");
+		checkAndThrow(rc, type, handle, CallCounters::Function::freeHandle, "SQLFreeHandle");
 		break;
 	}
 }
 #endif
 
 void Driver::setEnvAttr(const ConnectionFactory& connectionFactory, SQLINTEGER attribute, SQLPOINTER value, SQLINTEGER stringLength) const {
+	CallCounters::Call call(CallCounters::Function::setEnvAttr, nullptr);
 	SQLRETURN rc = SQLSetEnvAttr(connectionFactory.getHandle(), attribute, value, stringLength);
 
-	checkAndThrow(rc, SQL_HANDLE_ENV, connectionFactory.getHandle(), "SQLSetEnvAttr");
+	checkAndThrow(rc, SQL_HANDLE_ENV, connectionFactory.getHandle(), CallCounters::Function::setEnvAttr, "SQLSetEnvAttr");
 }
 
 void Driver::setConnectAttr(const Connection& connection, SQLINTEGER attribute, SQLPOINTER value, SQLINTEGER stringLength) const {
+	CallCounters::Call call(CallCounters::Function::setConnectAttr, &connection);
 	SQLRETURN rc = SQLSetConnectAttr(connection.getHandle(), attribute, value, stringLength);
-	checkAndThrow(rc, SQL_HANDLE_DBC, connection.getHandle(), "SQLSetConnectAttr");
+	checkAndThrow(rc, SQL_HANDLE_DBC, connection.getHandle(), CallCounters::Function::setConnectAttr, "SQLSetConnectAttr");
+}
+
+void Driver::setStmtAttr(const StatementHandle& statementHandle, SQLINTEGER attribute, SQLPOINTER value, SQLINTEGER stringLength) const {
+	CallCounters::Call call(CallCounters::Function::setStmtAttr, statementHandle.getConnection());
+	SQLRETURN rc = SQLSetStmtAttr(statementHandle.getHandle(), attribute, value, stringLength);
+	checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), CallCounters::Function::setStmtAttr, "SQLSetStmtAttr");
 }
 
 void Driver::driverConnect(const Connection& connection, const std::string connectionString) const {
@@ -287,8 +385,9 @@ void Driver::driverConnect(const Connection& connection, const std::string conne
     SQLCHAR* szConnStrIn = reinterpret_cast<SQLCHAR*>(const_cast<char*>(connectionString.c_str()));
     SQLSMALLINT cbConnStrIn = connectionString.size();
 
+	CallCounters::Call call(CallCounters::Function::driverConnect, &connection);
 	SQLRETURN rc = SQLDriverConnect(connection.getHandle(), NULL, szConnStrIn, cbConnStrIn, NULL, 0, NULL, SQL_DRIVER_NOPROMPT);
-	checkAndThrow(rc, SQL_HANDLE_DBC, connection.getHandle(), "SQLDriverConnect failed");
+	checkAndThrow(rc, SQL_HANDLE_DBC, connection.getHandle(), CallCounters::Function::driverConnect, "SQLDriverConnect failed");
 
 	ESL__LOGGER_TRACE_THIS("connected\n");
 }
@@ -296,16 +395,17 @@ void Driver::driverConnect(const Connection& connection, const std::string conne
 void Driver::endTran(const Connection& connection, SQLSMALLINT type) const {
     SQLRETURN rc;
 
+    CallCounters::Call call(CallCounters::Function::endTran, &connection);
     rc = SQLEndTran(SQL_HANDLE_DBC, connection.getHandle(), type);
     switch(type) {
     case SQL_COMMIT:
-        checkAndThrow(rc, SQL_HANDLE_DBC, connection.getHandle(), "SQLEndTran with SQL_COMMIT");
+        checkAndThrow(rc, SQL_HANDLE_DBC, connection.getHandle(), CallCounters::Function::endTran, "SQLEndTran with SQL_COMMIT");
         break;
     case SQL_ROLLBACK:
-        checkAndThrow(rc, SQL_HANDLE_DBC, connection.getHandle(), "SQLEndTran with SQL_ROLLBACK");
+        checkAndThrow(rc, SQL_HANDLE_DBC, connection.getHandle(), CallCounters::Function::endTran, "SQLEndTran with SQL_ROLLBACK");
         break;
     default:
-        checkAndThrow(rc, SQL_HANDLE_DBC, connection.getHandle(), "SQLEndTran");
+        checkAndThrow(rc, SQL_HANDLE_DBC, connection.getHandle(), CallCounters::Function::endTran, "SQLEndTran");
     }
 }
 
@@ -313,8 +413,9 @@ void Driver::disconnect(const Connection& connection) const {
     SQLRETURN rc;
 
 	ESL__LOGGER_TRACE_THIS("disconnect\n");
+    CallCounters::Call call(CallCounters::Function::disconnect, &connection);
     rc = SQLDisconnect(connection.getHandle());
-    checkAndThrow(rc, SQL_HANDLE_DBC, connection.getHandle(), "SQLDisconnect");
+    checkAndThrow(rc, SQL_HANDLE_DBC, connection.getHandle(), CallCounters::Function::disconnect, "SQLDisconnect");
 
 	ESL__LOGGER_TRACE_THIS("free connection handle\n");
     freeHandle(connection);
@@ -330,6 +431,7 @@ bool Driver::getDiagRec(esl::database::Diagnostic& diagnostic, SQLSMALLINT type,
 	SQLCHAR sqlstate[SQL_SQLSTATE_SIZE + 1];
 	SQLCHAR message[SQL_MAX_MESSAGE_LENGTH + 1];
 
+    CallCounters::Call call(CallCounters::Function::getDiagRec, nullptr);
     rc = SQLGetDiagRec(type,
             handle,
 			index,
@@ -355,15 +457,27 @@ bool Driver::getDiagRec(esl::database::Diagnostic& diagnostic, SQLSMALLINT type,
     return true;
 }
 
-StatementHandle Driver::prepare(const Connection& connection, const std::string& sql) const {
-	SQLHANDLE newHandle;
-	SQLRETURN rc = SQLAllocHandle(SQL_HANDLE_STMT, connection.getHandle(), &newHandle);
-	checkAndThrow(rc, SQL_HANDLE_DBC, connection.getHandle(), "SQLAllocHandle for statement");
+bool Driver::getDiagState(SQLCHAR (&resultState)[SQL_SQLSTATE_SIZE + 1], SQLSMALLINT type, SQLHANDLE handle, SQLSMALLINT index) const {
+	SQLINTEGER sqlcode;
+	SQLSMALLINT length;
 
-	StatementHandle statementHandle(newHandle);
+	// message text is not requested, so SQL_SUCCESS_WITH_INFO is returned because of truncation
+	CallCounters::Call call(CallCounters::Function::getDiagRec, nullptr);
+	SQLRETURN rc = SQLGetDiagRec(type, handle, index, resultState, &sqlcode, NULL, 0, &length);
+	if(rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) {
+		return false;
+	}
+
+	resultState[SQL_SQLSTATE_SIZE] = 0;
+	return true;
+}
 
-	rc = SQLPrepare(statementHandle.getHandle(), reinterpret_cast<SQLCHAR*>(const_cast<char*>(sql.c_str())), SQL_NTS);
-	checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), "SQLPrepare");
+StatementHandle Driver::prepare(const Connection& connection, const std::string& sql) const {
+	StatementHandle statementHandle(connection.acquireStatementHandle());
+
+	CallCounters::Call call(CallCounters::Function::prepare, &connection);
+	SQLRETURN rc = SQLPrepare(statementHandle.getHandle(), reinterpret_cast<SQLCHAR*>(const_cast<char*>(sql.c_str())), SQL_NTS);
+	checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), CallCounters::Function::prepare, "SQLPrepare");
 
 	return statementHandle;
 }
@@ -371,8 +485,9 @@ StatementHandle Driver::prepare(const Connection& connection, const std::string&
 SQLSMALLINT Driver::numResultCols(const StatementHandle& statementHandle) const {
 	SQLSMALLINT resultColumnsCount;
 
+	CallCounters::Call call(CallCounters::Function::numResultCols, statementHandle.getConnection());
 	SQLRETURN rc = SQLNumResultCols(statementHandle.getHandle(), &resultColumnsCount);
-    checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), "SQLNumResultCols");
+    checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), CallCounters::Function::numResultCols, "SQLNumResultCols");
 
 	return resultColumnsCount;
 }
@@ -380,8 +495,9 @@ SQLSMALLINT Driver::numResultCols(const StatementHandle& statementHandle) const
 SQLSMALLINT Driver::numParams(const StatementHandle& statementHandle) const {
 	SQLSMALLINT parameterColumnsCount;
 
+	CallCounters::Call call(CallCounters::Function::numParams, statementHandle.getConnection());
 	SQLRETURN rc = SQLNumParams(statementHandle.getHandle(), &parameterColumnsCount);
-    checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), "SQLNumParams");
+    checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), CallCounters::Function::numParams, "SQLNumParams");
 
 	return parameterColumnsCount;
 }
@@ -394,15 +510,16 @@ void Driver::describeCol(const StatementHandle& statementHandle, SQLSMALLINT ind
 	SQLSMALLINT sqlResultValueDecimalDigits; // no of digits if column is numeric
 	SQLSMALLINT sqlResultValueNullable;      // whether column can have NULL value
 
+	CallCounters::Call call(CallCounters::Function::describeCol, statementHandle.getConnection());
 	SQLRETURN rc = SQLDescribeCol(statementHandle.getHandle(), index,
 			sqlResultColumnName, sizeof(sqlResultColumnName), &sqlResultColumnNameLength, &sqlResultColumnType,
 			&sqlResultValueCharacterLength, &sqlResultValueDecimalDigits, &sqlResultValueNullable);
 	sqlResultColumnName[200] = 0;
-	checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), "SQLDescribeCol()");
+	checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), CallCounters::Function::describeCol, "SQLDescribeCol()");
 
 	resultColumnName = reinterpret_cast<char*>(&sqlResultColumnName[0]);
 	resultColumnType = sqlType2ColumnType(sqlResultColumnType);
-	if(resultColumnType == esl::database::Column::Type::sqlUnknown) {
+	if(resultColumnType == esl::database::Column::Type::sqlUnknown && !isBinarySqlType(sqlResultColumnType)) {
 		logger.warn << "describeCol called for column \"" << resultColumnName << "\" (index " << index << ") and got unknown column type " << sqlResultColumnType << ".\n";
 	}
 	resultCharacterLength = sqlResultValueCharacterLength < 0 ? 0 : static_cast<std::size_t>(sqlResultValueCharacterLength);
@@ -414,24 +531,38 @@ void Driver::colAttributeDisplaySize(const StatementHandle& statementHandle, SQL
 	SQLLEN      sqlResultValueDisplayLength;
 
 	// get Maximum number of characters required to display data from the column.
+	CallCounters::Call call(CallCounters::Function::colAttribute, statementHandle.getConnection());
 	SQLRETURN rc = SQLColAttribute(statementHandle.getHandle(), index,
 			SQL_COLUMN_DISPLAY_SIZE, NULL, 0, NULL, &sqlResultValueDisplayLength);
-	checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), "SQLColAttribute()");
+	checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), CallCounters::Function::colAttribute, "SQLColAttribute()");
 
 	resultDisplayLength = sqlResultValueDisplayLength < 0 ? 0 : static_cast<std::size_t>(sqlResultValueDisplayLength);
 }
 
-void Driver::describeParam(const StatementHandle& statementHandle, SQLSMALLINT index, esl::database::Column::Type& resultColumnType, std::size_t& resultCharacterLength, std::size_t& resultDecimalDigits, bool& resultNullable) const {
+SQLSMALLINT Driver::colAttributeConciseType(const StatementHandle& statementHandle, SQLSMALLINT index) const {
+	SQLLEN sqlResultConciseType;
+
+	CallCounters::Call call(CallCounters::Function::colAttribute, statementHandle.getConnection());
+	SQLRETURN rc = SQLColAttribute(statementHandle.getHandle(), index,
+			SQL_DESC_CONCISE_TYPE, NULL, 0, NULL, &sqlResultConciseType);
+	checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), CallCounters::Function::colAttribute, "SQLColAttribute()");
+
+	return static_cast<SQLSMALLINT>(sqlResultConciseType);
+}
+
+void Driver::describeParam(const StatementHandle& statementHandle, SQLSMALLINT index, esl::database::Column::Type& resultColumnType, std::size_t& resultCharacterLength, std::size_t& resultDecimalDigits, bool& resultNullable, SQLSMALLINT& resultSqlType) const {
 	SQLSMALLINT sqlParameterColumnType;           // column type
 	SQLULEN     sqlParameterValueCharacterLength; // column lengths
 	SQLSMALLINT sqlParameterValueDecimalDigits;   // no of digits if column is numeric
 	SQLSMALLINT sqlParameterValueNullable;        // whether column can have NULL value
 
+	CallCounters::Call call(CallCounters::Function::describeParam, statementHandle.getConnection());
 	SQLRETURN rc = SQLDescribeParam(statementHandle.getHandle(), index, &sqlParameterColumnType,
 			&sqlParameterValueCharacterLength, &sqlParameterValueDecimalDigits, &sqlParameterValueNullable);
-	checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), "SQLDescribeParam()");
+	checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), CallCounters::Function::describeParam, "SQLDescribeParam()");
 
 	resultColumnType = sqlType2ColumnType(sqlParameterColumnType);
+	resultSqlType = sqlParameterColumnType;
 	resultCharacterLength = sqlParameterValueCharacterLength < 0 ? 0 : static_cast<std::size_t>(sqlParameterValueCharacterLength);
 	resultDecimalDigits = sqlParameterValueDecimalDigits < 0 ? 0 : static_cast<std::size_t>(sqlParameterValueDecimalDigits);
 	resultNullable = (sqlParameterValueNullable != 0);
@@ -439,22 +570,23 @@ void Driver::describeParam(const StatementHandle& statementHandle, SQLSMALLINT i
 
 void Driver::bindParameter(const StatementHandle& statementHandle, SQLSMALLINT index, SQLSMALLINT ioType, SQLSMALLINT cType, SQLSMALLINT sqlType,
 	const esl::database::Column& column, SQLPOINTER valuePtr, SQLLEN bufferLength, SQLLEN* indicatorPtrOrStrLen) const {
+	CallCounters::Call call(CallCounters::Function::bindParameter, statementHandle.getConnection());
 	SQLRETURN rc = SQLBindParameter(statementHandle.getHandle(), index, ioType, cType, sqlType,
 			static_cast<SQLULEN>(column.getCharacterLength()), /* 0 */static_cast<SQLSMALLINT>(column.getDecimalDigits()),
 			valuePtr, bufferLength, indicatorPtrOrStrLen);
 
 	switch(cType) {
 	case SQL_C_SBIGINT:
-		checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), "SQLBindParameter() with SQL_C_SBIGINT");
+		checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), CallCounters::Function::bindParameter, "SQLBindParameter() with SQL_C_SBIGINT");
 		break;
 	case SQL_C_DOUBLE:
-		checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), "SQLBindParameter() with SQL_C_DOUBLE");
+		checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), CallCounters::Function::bindParameter, "SQLBindParameter() with SQL_C_DOUBLE");
 		break;
 	case SQL_C_CHAR:
-		checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), "SQLBindParameter() with SQL_C_CHAR");
+		checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), CallCounters::Function::bindParameter, "SQLBindParameter() with SQL_C_CHAR");
 		break;
 	default:
-		checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), "SQLBindParameter()");
+		checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), CallCounters::Function::bindParameter, "SQLBindParameter()");
 		break;
 	}
 }
@@ -469,36 +601,46 @@ void Driver::bindCol(const StatementHandle& statementHandle, SQLSMALLINT index,
 
 	switch(dataType) {
 	case SQL_C_SBIGINT:
-		checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), "SQLBindCol() with SQL_C_SBIGINT");
+		checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), CallCounters::Function::bindCol, "SQLBindCol() with SQL_C_SBIGINT");
 		break;
 	case SQL_C_DOUBLE:
-		checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), "SQLBindCol() with SQL_C_DOUBLE");
+		checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), CallCounters::Function::bindCol, "SQLBindCol() with SQL_C_DOUBLE");
 		break;
 	case SQL_C_CHAR:
-		checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), "SQLBindCol() with SQL_C_CHAR");
+		checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), CallCounters::Function::bindCol, "SQLBindCol() with SQL_C_CHAR");
 		break;
 	default:
-		checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), "SQLBindCol()");
+		checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), CallCounters::Function::bindCol, "SQLBindCol()");
 		break;
 	}
 }
 */
 void Driver::bindCol(const StatementHandle& statementHandle, std::size_t index, std::int64_t& resultValue, SQLLEN& resultIndicator) const {
+	CallCounters::Call call(CallCounters::Function::bindCol, statementHandle.getConnection());
 	SQLRETURN rc = SQLBindCol(statementHandle.getHandle(), static_cast<SQLUSMALLINT>(index+1), SQL_C_SBIGINT, static_cast<SQLPOINTER>(&resultValue), 0, &resultIndicator);
 
-	checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), "SQLBindCol() with SQL_C_SBIGINT");
+	checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), CallCounters::Function::bindCol, "SQLBindCol() with SQL_C_SBIGINT");
 }
 
 void Driver::bindCol(const StatementHandle& statementHandle, std::size_t index, double& resultValue, SQLLEN& resultIndicator) const {
+	CallCounters::Call call(CallCounters::Function::bindCol, statementHandle.getConnection());
 	SQLRETURN rc = SQLBindCol(statementHandle.getHandle(), static_cast<SQLUSMALLINT>(index+1), SQL_C_DOUBLE, static_cast<SQLPOINTER>(&resultValue), 0, &resultIndicator);
 
-	checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), "SQLBindCol() with SQL_C_DOUBLE");
+	checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), CallCounters::Function::bindCol, "SQLBindCol() with SQL_C_DOUBLE");
 }
 
 void Driver::bindCol(const StatementHandle& statementHandle, std::size_t index, char* resultData, std::size_t resultDataLength, SQLLEN& resultIndicator) const {
+	CallCounters::Call call(CallCounters::Function::bindCol, statementHandle.getConnection());
 	SQLRETURN rc = SQLBindCol(statementHandle.getHandle(), static_cast<SQLUSMALLINT>(index+1), SQL_C_CHAR, static_cast<SQLPOINTER>(resultData), resultDataLength, &resultIndicator);
 
-	checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), "SQLBindCol() with SQL_C_CHAR");
+	checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), CallCounters::Function::bindCol, "SQLBindCol() with SQL_C_CHAR");
+}
+
+void Driver::bindCol(const StatementHandle& statementHandle, std::size_t index, SQLSMALLINT cType, SQLPOINTER resultData, SQLLEN resultDataLength, SQLLEN* resultIndicator) const {
+	CallCounters::Call call(CallCounters::Function::bindCol, statementHandle.getConnection());
+	SQLRETURN rc = SQLBindCol(statementHandle.getHandle(), static_cast<SQLUSMALLINT>(index+1), cType, resultData, resultDataLength, resultIndicator);
+
+	checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), CallCounters::Function::bindCol, "SQLBindCol()");
 }
 
 void Driver::getData(const StatementHandle& statementHandle, SQLSMALLINT index,
@@ -506,35 +648,70 @@ void Driver::getData(const StatementHandle& statementHandle, SQLSMALLINT index,
 		void* dataValue,
 		std::size_t dataBufferLength,
 		SQLLEN* dataButterLengthOrIndicator) const {
+	CallCounters::Call call(CallCounters::Function::getData, statementHandle.getConnection());
 	SQLRETURN rc = SQLGetData(statementHandle.getHandle(), index, dataType, static_cast<SQLPOINTER>(dataValue), static_cast<SQLLEN>(dataBufferLength), dataButterLengthOrIndicator);
 
 	switch(dataType) {
 	case SQL_C_SBIGINT:
-		checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), "SQLGetData() with SQL_C_SBIGINT");
+		checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), CallCounters::Function::getData, "SQLGetData() with SQL_C_SBIGINT");
 		break;
 	case SQL_C_DOUBLE:
-		checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), "SQLGetData() with SQL_C_DOUBLE");
+		checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), CallCounters::Function::getData, "SQLGetData() with SQL_C_DOUBLE");
 		break;
 	case SQL_C_CHAR:
-		checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), "SQLGetData() with SQL_C_CHAR");
+		checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), CallCounters::Function::getData, "SQLGetData() with SQL_C_CHAR");
 		break;
 	default:
-		checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), "SQLGetData()");
+		checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), CallCounters::Function::getData, "SQLGetData()");
 		break;
 	}
 }
 
 void Driver::execute(const StatementHandle& statementHandle) const {
+	CallCounters::Call call(CallCounters::Function::execute, statementHandle.getConnection());
+	SQLRETURN rc = SQLExecute(statementHandle.getHandle());
+	checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), CallCounters::Function::execute, "SQLExecute()");
+}
+
+void Driver::execDirect(const StatementHandle& statementHandle, const std::string& sql) const {
+	CallCounters::Call call(CallCounters::Function::execDirect, statementHandle.getConnection());
+	SQLRETURN rc = SQLExecDirect(statementHandle.getHandle(), reinterpret_cast<SQLCHAR*>(const_cast<char*>(sql.c_str())), SQL_NTS);
+	if(rc == SQL_NO_DATA) {
+		// searched UPDATE or DELETE that affected no rows
+		return;
+	}
+	checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), CallCounters::Function::execDirect, "SQLExecDirect()");
+}
+
+bool Driver::tryExecute(const StatementHandle& statementHandle, esl::database::ODBCStatus& status, bool withMessage) const {
+	CallCounters::Call call(CallCounters::Function::execute, statementHandle.getConnection());
 	SQLRETURN rc = SQLExecute(statementHandle.getHandle());
-	checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), "SQLExecute()");
+	return checkAndSetStatus(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), CallCounters::Function::execute, "SQLExecute()", status, withMessage);
+}
+
+void Driver::cancel(SQLHANDLE statementHandle, const Connection* connection) const {
+	CallCounters::Call call(CallCounters::Function::cancel, connection);
+	SQLRETURN rc = SQLCancel(statementHandle);
+	checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle, CallCounters::Function::cancel, "SQLCancel()");
 }
 
 bool Driver::fetch(const StatementHandle& statementHandle) const {
+	CallCounters::Call call(CallCounters::Function::fetch, statementHandle.getConnection());
 	SQLRETURN rc = SQLFetch(statementHandle.getHandle());
 	if(rc == SQL_NO_DATA) {
 		return false;
 	}
-	checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), "SQLFetch()");
+	checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), CallCounters::Function::fetch, "SQLFetch()");
+	return true;
+}
+
+bool Driver::moreResults(const StatementHandle& statementHandle) const {
+	CallCounters::Call call(CallCounters::Function::moreResults, statementHandle.getConnection());
+	SQLRETURN rc = SQLMoreResults(statementHandle.getHandle());
+	if(rc == SQL_NO_DATA) {
+		return false;
+	}
+	checkAndThrow(rc, SQL_HANDLE_STMT, statementHandle.getHandle(), CallCounters::Function::moreResults, "SQLMoreResults()");
 	return true;
 }
 
@@ -25,6 +25,7 @@
 
 #include <esl/database/Column.h>
 #include <esl/database/Diagnostic.h>
+#include <esl/database/ODBCStatus.h>
 
 #include <sqlext.h>
 
@@ -42,25 +43,33 @@ public:
 	static esl::database::Column::Type sqlType2ColumnType(SQLSMALLINT sqlType);
 	static SQLSMALLINT columnType2SqlType(esl::database::Column::Type columnType);
 
+	/* Binary and GUID types have no column type. Their values are kept as raw bytes. */
+	static bool isBinarySqlType(SQLSMALLINT sqlType) noexcept;
+
 	SQLHANDLE allocHandleEnvironment() const;
 	SQLHANDLE allocHandleConnection(const ConnectionFactory& connectionFactory) const;
+	SQLHANDLE allocHandleStatement(const Connection& connection) const;
 	void freeHandle(const ConnectionFactory& connectionFactory) const;
 	void freeHandle(const Connection& connection) const;
 	void freeHandle(const StatementHandle& statementHandle) const;
+	void freeStmt(const StatementHandle& statementHandle, SQLUSMALLINT option) const;
 
 	void setEnvAttr(const ConnectionFactory& connectionFactory, SQLINTEGER attribute, SQLPOINTER value, SQLINTEGER stringLength) const;
 
 	void setConnectAttr(const Connection& connection, SQLINTEGER attribute, SQLPOINTER value, SQLINTEGER stringLength) const;
+	void setStmtAttr(const StatementHandle& statementHandle, SQLINTEGER attribute, SQLPOINTER value, SQLINTEGER stringLength) const;
 	void driverConnect(const Connection& connection, const std::string connectionString) const;
 	void endTran(const Connection& connection, SQLSMALLINT type) const;
 	void disconnect(const Connection& connection) const;
 	bool getDiagRec(esl::database::Diagnostic& diagnostic, SQLSMALLINT type, SQLHANDLE handle, SQLSMALLINT index) const;
+	bool getDiagState(SQLCHAR (&resultState)[SQL_SQLSTATE_SIZE + 1], SQLSMALLINT type, SQLHANDLE handle, SQLSMALLINT index) const;
 	StatementHandle prepare(const Connection& connection, const std::string& sql) const;
 	SQLSMALLINT numResultCols(const StatementHandle& statementHandle) const;
 	SQLSMALLINT numParams(const StatementHandle& statementHandle) const;
 	void describeCol(const StatementHandle& statementHandle, SQLSMALLINT index, std::string& resultColumnName, esl::database::Column::Type& resultColumnType, std::size_t& resultCharacterLength, std::size_t& resultDecimalDigits, bool& resultNullable) const;
 	void colAttributeDisplaySize(const StatementHandle& statementHandle, SQLSMALLINT index, std::size_t& resultDisplayLength) const;
-	void describeParam(const StatementHandle& statementHandle, SQLSMALLINT index, esl::database::Column::Type& resultColumnType, std::size_t& resultCharacterLength, std::size_t& resultDecimalDigits, bool& resultNullable) const;
+	SQLSMALLINT colAttributeConciseType(const StatementHandle& statementHandle, SQLSMALLINT index) const;
+	void describeParam(const StatementHandle& statementHandle, SQLSMALLINT index, esl::database::Column::Type& resultColumnType, std::size_t& resultCharacterLength, std::size_t& resultDecimalDigits, bool& resultNullable, SQLSMALLINT& resultSqlType) const;
 	void bindParameter(const StatementHandle& statementHandle, SQLSMALLINT index, SQLSMALLINT ioType, SQLSMALLINT cType, SQLSMALLINT sqlType,
 			const esl::database::Column& column, SQLPOINTER valuePtr, SQLLEN bufferLength, SQLLEN* indicatorPtrOrStrLen) const;
 	/*
@@ -74,6 +83,9 @@ public:
 	void bindCol(const StatementHandle& statementHandle, std::size_t index, double& resultValue, SQLLEN& resultIndicator) const;
 	void bindCol(const StatementHandle& statementHandle, std::size_t index, char* resultData, std::size_t resultDataLength, SQLLEN& resultIndicator) const;
 
+	/* Binds a column of the first row for row-wise binding. The driver adds the row size to the pointers for further rows. */
+	void bindCol(const StatementHandle& statementHandle, std::size_t index, SQLSMALLINT cType, SQLPOINTER resultData, SQLLEN resultDataLength, SQLLEN* resultIndicator) const;
+
 
 	void getData(const StatementHandle& statementHandle, SQLSMALLINT index,
 			SQLSMALLINT       dataType,
@@ -82,7 +94,18 @@ public:
 			SQLLEN*           dataButterLengthOrIndicator) const;
 
 	void execute(const StatementHandle& statementHandle) const;
+	void execDirect(const StatementHandle& statementHandle, const std::string& sql) const;
+
+	/* Cancels the function running on the statement handle in another thread. It takes the raw handle,
+	 * because the StatementHandle object is owned by the other thread. */
+	void cancel(SQLHANDLE statementHandle, const Connection* connection) const;
+
+	/* Returns false and sets status instead of throwing an exception if execution failed with SQL_ERROR */
+	bool tryExecute(const StatementHandle& statementHandle, esl::database::ODBCStatus& status, bool withMessage) const;
 	bool fetch(const StatementHandle& statementHandle) const;
+
+	/* Returns false if there are no more results (SQL_NO_DATA) */
+	bool moreResults(const StatementHandle& statementHandle) const;
 };
 
 } /* namespace database */
@@ -0,0 +1,221 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <odbc4esl/database/Executor.h>
+
+#include <esl/Logger.h>
+
+#include <esl/system/Stacktrace.h>
+
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+namespace {
+esl::Logger logger("odbc4esl::database::Executor");
+}
+
+Executor::Executor(esl::database::ODBCConnectionFactory& connectionFactory, const Settings& settings) {
+	if(settings.workerCount == 0) {
+		throw esl::system::Stacktrace::add(std::runtime_error("Executor needs at least one worker."));
+	}
+
+	/* all connections are created before the first thread is started, so a failing connection leaves no thread behind */
+	workers.reserve(settings.workerCount);
+	for(std::size_t i = 0; i < settings.workerCount; ++i) {
+		workers.emplace_back(new Worker);
+		workers.back()->connection = connectionFactory.createODBCConnection();
+		if(!workers.back()->connection) {
+			throw esl::system::Stacktrace::add(std::runtime_error("Cannot create connection for executor worker " + std::to_string(i) + "."));
+		}
+	}
+
+	/* the destructor does not run if a thread cannot be started, so the threads started before have to be joined here */
+	try {
+		for(std::size_t i = 0; i < workers.size(); ++i) {
+			workers[i]->thread = std::thread(&Executor::run, this, i);
+		}
+	}
+	catch(...) {
+		stop();
+		throw;
+	}
+}
+
+Executor::~Executor() {
+	stop();
+}
+
+void Executor::submit(std::size_t affinity, Job job, Completion completion) {
+	add(affinity % workers.size(), Task{std::move(job), std::move(completion)}, true);
+}
+
+void Executor::submit(Job job, Completion completion) {
+	std::size_t index;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		index = nextWorker;
+		nextWorker = (nextWorker + 1) % workers.size();
+	}
+	add(index, Task{std::move(job), std::move(completion)}, false);
+}
+
+std::size_t Executor::getWorkerCount() const noexcept {
+	return workers.size();
+}
+
+void Executor::stop() noexcept {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopped = true;
+	}
+	for(auto& worker : workers) {
+		worker->taskAdded.notify_one();
+	}
+
+	for(auto& worker : workers) {
+		if(worker->thread.joinable()) {
+			worker->thread.join();
+		}
+	}
+}
+
+int Executor::getCompletionFd() const noexcept {
+	return completionQueue.getFd();
+}
+
+std::size_t Executor::runCompletions() {
+	return completionQueue.run();
+}
+
+void Executor::add(std::size_t index, Task task, bool pinned) {
+	Worker* wakeUp = nullptr;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if(stopped) {
+			throw esl::system::Stacktrace::add(std::runtime_error("Executor has been stopped."));
+		}
+
+		Worker& worker = *workers[index];
+		if(pinned) {
+			worker.pinnedTasks.push_back(std::move(task));
+		}
+		else {
+			worker.sharedTasks.push_back(std::move(task));
+		}
+
+		if(worker.idle) {
+			wakeUp = &worker;
+		}
+		else if(!pinned) {
+			/* the worker is busy, an idle worker steals the task */
+			for(auto& otherWorker : workers) {
+				if(otherWorker->idle) {
+					wakeUp = otherWorker.get();
+					break;
+				}
+			}
+		}
+
+		if(wakeUp) {
+			/* the flag is reset here, so concurrent submits wake up different workers */
+			wakeUp->idle = false;
+		}
+	}
+
+	if(wakeUp) {
+		wakeUp->taskAdded.notify_one();
+	}
+}
+
+bool Executor::take(std::size_t index, Task& task) {
+	Worker& worker = *workers[index];
+
+	if(!worker.pinnedTasks.empty()) {
+		task = std::move(worker.pinnedTasks.front());
+		worker.pinnedTasks.pop_front();
+		return true;
+	}
+	if(!worker.sharedTasks.empty()) {
+		task = std::move(worker.sharedTasks.front());
+		worker.sharedTasks.pop_front();
+		return true;
+	}
+
+	/* steals the most recently added task of the next worker with shared tasks,
+	 * its older tasks are probably run by itself soon */
+	for(std::size_t i = 1; i < workers.size(); ++i) {
+		Worker& victim = *workers[(index + i) % workers.size()];
+		if(!victim.sharedTasks.empty()) {
+			task = std::move(victim.sharedTasks.back());
+			victim.sharedTasks.pop_back();
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void Executor::run(std::size_t index) {
+	Worker& worker = *workers[index];
+	std::unique_lock<std::mutex> lock(mutex);
+
+	while(true) {
+		Task task;
+		if(!take(index, task)) {
+			if(stopped) {
+				/* stopped and no task is left that this worker could run */
+				return;
+			}
+			worker.idle = true;
+			worker.taskAdded.wait(lock, [this, &worker]() { return stopped || !worker.idle; });
+			worker.idle = false;
+			continue;
+		}
+
+		lock.unlock();
+
+		std::exception_ptr exception;
+		try {
+			task.job(*worker.connection);
+		}
+		catch(...) {
+			exception = std::current_exception();
+		}
+
+		if(task.completion) {
+			try {
+				completionQueue.push(std::move(task.completion), exception);
+			}
+			catch(const std::exception& e) {
+				logger.error << "Cannot post completion of executor worker " << index << ": " << e.what() << "\n";
+			}
+		}
+
+		lock.lock();
+	}
+}
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
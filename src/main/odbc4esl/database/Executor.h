@@ -0,0 +1,89 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ODBC4ESL_DATABASE_EXECUTOR_H_
+#define ODBC4ESL_DATABASE_EXECUTOR_H_
+
+#include <odbc4esl/database/CompletionQueue.h>
+
+#include <esl/database/ODBCConnection.h>
+#include <esl/database/ODBCConnectionFactory.h>
+#include <esl/database/ODBCExecutor.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+class Executor : public esl::database::ODBCExecutor {
+public:
+	Executor(esl::database::ODBCConnectionFactory& connectionFactory, const Settings& settings);
+	~Executor();
+
+	void submit(std::size_t affinity, Job job, Completion completion) override;
+	void submit(Job job, Completion completion) override;
+
+	std::size_t getWorkerCount() const noexcept override;
+
+	int getCompletionFd() const noexcept override;
+	std::size_t runCompletions() override;
+
+private:
+	struct Task {
+		Job job;
+		Completion completion;
+	};
+
+	/* Pinned tasks are run only by their worker, shared tasks can be stolen by idle workers */
+	struct Worker {
+		std::unique_ptr<esl::database::ODBCConnection> connection;
+		std::deque<Task> pinnedTasks;
+		std::deque<Task> sharedTasks;
+		std::condition_variable taskAdded;
+		bool idle = false;
+		std::thread thread;
+	};
+
+	void add(std::size_t index, Task task, bool pinned);
+	bool take(std::size_t index, Task& task);
+	void run(std::size_t index);
+
+	/* stops the workers and joins the threads that have been started */
+	void stop() noexcept;
+
+	CompletionQueue completionQueue;
+
+	/* guards the tasks of all workers, jobs run for milliseconds, so a single mutex is not contended */
+	std::mutex mutex;
+	std::vector<std::unique_ptr<Worker>> workers;
+	std::size_t nextWorker = 0;
+	bool stopped = false;
+};
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
+
+#endif /* ODBC4ESL_DATABASE_EXECUTOR_H_ */
@@ -0,0 +1,33 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ODBC4ESL_DATABASE_HOTPATHTRACE_H_
+#define ODBC4ESL_DATABASE_HOTPATHTRACE_H_
+
+/* Trace logging done per fetched row, per cell or per bound parameter.
+ * Expects a logger named "logger" in scope. If ODBC4ESL_NO_HOT_PATH_TRACE is defined
+ * (CMake option ODBC4ESL_HOT_PATH_TRACE=OFF) the statements are compiled out completely. */
+#ifdef ODBC4ESL_NO_HOT_PATH_TRACE
+#define ODBC4ESL__HOT_PATH_TRACE if(true) {} else logger.trace
+#define ODBC4ESL__HOT_PATH_TRACE_ENABLED false
+#else
+#define ODBC4ESL__HOT_PATH_TRACE logger.trace
+#define ODBC4ESL__HOT_PATH_TRACE_ENABLED static_cast<bool>(logger.trace)
+#endif
+
+#endif /* ODBC4ESL_DATABASE_HOTPATHTRACE_H_ */
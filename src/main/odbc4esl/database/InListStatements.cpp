@@ -0,0 +1,168 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <odbc4esl/database/InListStatements.h>
+
+#include <esl/system/Stacktrace.h>
+
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+namespace {
+bool isSpace(char c) noexcept {
+	return std::isspace(static_cast<unsigned char>(c)) != 0;
+}
+
+bool isIdentifier(char c) noexcept {
+	return std::isalnum(static_cast<unsigned char>(c)) != 0 || c == '_';
+}
+
+/* Returns the end of "IN (?)" if it starts at position, otherwise std::string::npos. Case and blanks are not significant.
+ * listBegin is set to the position behind the opening parenthesis. */
+std::string::size_type matchInList(const std::string& sql, std::string::size_type position, std::string::size_type& listBegin) {
+	if(position > 0 && isIdentifier(sql[position-1])) {
+		return std::string::npos;
+	}
+	if(position + 2 > sql.size() || std::toupper(static_cast<unsigned char>(sql[position])) != 'I' || std::toupper(static_cast<unsigned char>(sql[position+1])) != 'N') {
+		return std::string::npos;
+	}
+
+	const char expected[] = { '(', '?', ')' };
+	position += 2;
+	for(char c : expected) {
+		while(position < sql.size() && isSpace(sql[position])) {
+			++position;
+		}
+		if(position >= sql.size() || sql[position] != c) {
+			return std::string::npos;
+		}
+		++position;
+		if(c == '(') {
+			listBegin = position;
+		}
+	}
+	return position;
+}
+}
+
+InListStatements::InListStatements(const esl::database::ODBCConnection& aConnection, const std::string& sql, std::size_t aMaximumSize, Padding aPadding)
+: connection(aConnection),
+  maximumSize(aMaximumSize),
+  padding(aPadding)
+{
+	if(maximumSize == 0) {
+		throw esl::system::Stacktrace::add(std::runtime_error("Maximum size of IN list must not be 0."));
+	}
+
+	/* parameter markers and "IN (?)" inside of string literals are skipped */
+	bool literal = false;
+	for(std::string::size_type position = 0; position < sql.size(); ++position) {
+		if(sql[position] == '\'') {
+			literal = !literal;
+			continue;
+		}
+		if(literal) {
+			continue;
+		}
+
+		std::string::size_type listBegin = 0;
+		std::string::size_type end = matchInList(sql, position, listBegin);
+		if(end != std::string::npos) {
+			sqlPrefix = sql.substr(0, listBegin);
+			sqlSuffix = sql.substr(end);
+			return;
+		}
+		if(sql[position] == '?') {
+			++listIndex;
+		}
+	}
+
+	throw esl::system::Stacktrace::add(std::runtime_error("SQL statement has no IN list \"IN (?)\": \"" + sql + "\""));
+}
+
+std::size_t InListStatements::getBucketSize(std::size_t size) const {
+	if(size > maximumSize) {
+		throw esl::system::Stacktrace::add(std::runtime_error("IN list has " + std::to_string(size) + " values, but at most " + std::to_string(maximumSize) + " values are allowed."));
+	}
+
+	std::size_t bucketSize = 1;
+	while(bucketSize < size) {
+		bucketSize *= 2;
+	}
+	return std::min(bucketSize, maximumSize);
+}
+
+void InListStatements::createFields(const std::vector<esl::database::Field>& parameters, const std::vector<esl::database::Field>& values, std::vector<esl::database::Field>& aFields) const {
+	if(parameters.size() < listIndex) {
+		throw esl::system::Stacktrace::add(std::runtime_error("Statement has " + std::to_string(listIndex) + " parameters in front of the IN list, but only " + std::to_string(parameters.size()) + " parameters are given."));
+	}
+
+	std::size_t bucketSize = getBucketSize(values.size());
+
+	aFields.clear();
+	aFields.reserve(parameters.size() + bucketSize);
+	aFields.insert(aFields.end(), parameters.begin(), parameters.begin() + listIndex);
+	aFields.insert(aFields.end(), values.begin(), values.end());
+	if(padding == Padding::repeatLast && !values.empty()) {
+		aFields.resize(listIndex + bucketSize, values.back());
+	}
+	else {
+		aFields.resize(listIndex + bucketSize);
+		for(std::size_t i = listIndex + values.size(); i < aFields.size(); ++i) {
+			aFields[i] = nullptr;
+		}
+	}
+	aFields.insert(aFields.end(), parameters.begin() + listIndex, parameters.end());
+}
+
+esl::database::ODBCPreparedStatement& InListStatements::getStatement(std::size_t size) {
+	std::size_t bucketSize = getBucketSize(size);
+
+	std::size_t index = 0;
+	while((static_cast<std::size_t>(1) << index) < bucketSize) {
+		++index;
+	}
+	if(statements.size() <= index) {
+		statements.resize(index + 1);
+	}
+
+	if(!statements[index]) {
+		std::string sql = sqlPrefix + "?";
+		for(std::size_t i = 1; i < bucketSize; ++i) {
+			sql += ", ?";
+		}
+		sql += ")" + sqlSuffix;
+		statements[index] = connection.prepareODBC(sql);
+	}
+
+	return *statements[index];
+}
+
+std::unique_ptr<esl::database::ODBCResultSet> InListStatements::executeODBC(const std::vector<esl::database::Field>& parameters, const std::vector<esl::database::Field>& values) {
+	createFields(parameters, values, fields);
+	return getStatement(values.size()).executeODBC(fields);
+}
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
@@ -0,0 +1,67 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ODBC4ESL_DATABASE_INLISTSTATEMENTS_H_
+#define ODBC4ESL_DATABASE_INLISTSTATEMENTS_H_
+
+#include <esl/database/Field.h>
+#include <esl/database/ODBCConnection.h>
+#include <esl/database/ODBCInListStatements.h>
+#include <esl/database/ODBCPreparedStatement.h>
+#include <esl/database/ODBCResultSet.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+class InListStatements : public esl::database::ODBCInListStatements {
+public:
+	InListStatements(const esl::database::ODBCConnection& connection, const std::string& sql, std::size_t maximumSize, Padding padding);
+
+	std::size_t getBucketSize(std::size_t size) const override;
+	void createFields(const std::vector<esl::database::Field>& parameters, const std::vector<esl::database::Field>& values, std::vector<esl::database::Field>& fields) const override;
+	esl::database::ODBCPreparedStatement& getStatement(std::size_t size) override;
+	std::unique_ptr<esl::database::ODBCResultSet> executeODBC(const std::vector<esl::database::Field>& parameters, const std::vector<esl::database::Field>& values) override;
+
+private:
+	const esl::database::ODBCConnection& connection;
+	const std::size_t maximumSize;
+	const Padding padding;
+
+	/* SQL in front of and behind the parenthesized parameter of "IN (?)" */
+	std::string sqlPrefix;
+	std::string sqlSuffix;
+
+	/* number of parameters in front of the IN list */
+	std::size_t listIndex = 0;
+
+	/* indexed by the exponent of the bucket size */
+	std::vector<std::unique_ptr<esl::database::ODBCPreparedStatement>> statements;
+	std::vector<esl::database::Field> fields;
+};
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
+
+#endif /* ODBC4ESL_DATABASE_INLISTSTATEMENTS_H_ */
@@ -0,0 +1,299 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <odbc4esl/database/InfoDiagnostics.h>
+#include <odbc4esl/database/Diagnostics.h>
+#include <odbc4esl/database/Driver.h>
+
+#include <esl/Logger.h>
+
+#include <esl/system/Stacktrace.h>
+
+#include <stdexcept>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+namespace {
+esl::Logger logger("odbc4esl::database::InfoDiagnostics");
+
+/* more diagnostic records of a single call are not taken into account */
+constexpr std::size_t maxStatesPerCall = 8;
+
+struct Summary {
+	std::uint64_t state;
+	std::uint64_t count;
+	std::uint64_t totalCount;
+};
+
+std::int64_t getNanoseconds() noexcept {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void logOperation(const char* operation) {
+	if(operation) {
+		logger.warn << "Function \"" << operation << "\"";
+	}
+	else {
+		logger.warn << "Function";
+	}
+}
+}
+
+constexpr std::size_t InfoDiagnostics::statesPerFunction;
+constexpr std::size_t InfoDiagnostics::maximumMutedStates;
+constexpr std::uint64_t InfoDiagnostics::emptyState;
+constexpr std::uint64_t InfoDiagnostics::otherState;
+
+InfoDiagnostics& InfoDiagnostics::getInfoDiagnostics() {
+	static InfoDiagnostics infoDiagnostics;
+	return infoDiagnostics;
+}
+
+InfoDiagnostics::InfoDiagnostics()
+: logInterval(60000)
+{
+	clear();
+	for(auto& mutedState : mutedStates) {
+		mutedState.store(emptyState);
+	}
+}
+
+void InfoDiagnostics::add(SQLSMALLINT type, SQLHANDLE handle, Function function, const char* operation) {
+	std::uint64_t states[maxStatesPerCall];
+	std::size_t statesCount = 0;
+
+	SQLCHAR state[SQL_SQLSTATE_SIZE + 1];
+	while(statesCount < maxStatesPerCall && Driver::getDriver().getDiagState(state, type, handle, static_cast<SQLSMALLINT>(statesCount + 1))) {
+		states[statesCount] = packState(state);
+		++statesCount;
+	}
+	if(statesCount == 0) {
+		states[statesCount] = 0;
+		++statesCount;
+	}
+
+	bool logDetails = false;
+	Summary summaries[maxStatesPerCall];
+	std::size_t summariesCount = 0;
+
+	std::int64_t now = 0;
+	for(std::size_t i = 0; i < statesCount; ++i) {
+		Slot& slot = getSlot(function, states[i]);
+		std::uint64_t count = slot.count.fetch_add(1, std::memory_order_relaxed) + 1;
+
+		if(isMuted(states[i])) {
+			continue;
+		}
+
+		/* the clock is read only for unmuted states */
+		if(now == 0) {
+			now = getNanoseconds();
+		}
+
+		std::uint64_t reportedCount = 0;
+		if(count == 1 && slot.reportedCount.compare_exchange_strong(reportedCount, 1)) {
+			logDetails = true;
+			slot.reportedTime.store(now, std::memory_order_relaxed);
+			continue;
+		}
+
+		std::int64_t reportedTime = slot.reportedTime.load(std::memory_order_relaxed);
+		if(now - reportedTime < logInterval.load(std::memory_order_relaxed) * 1000000
+				|| !slot.reportedTime.compare_exchange_strong(reportedTime, now, std::memory_order_relaxed)) {
+			continue;
+		}
+
+		/* this thread reports the occurrences since the last report */
+		reportedCount = slot.reportedCount.exchange(count);
+		if(count > reportedCount) {
+			summaries[summariesCount].state = slot.state.load(std::memory_order_relaxed);
+			summaries[summariesCount].count = count - reportedCount;
+			summaries[summariesCount].totalCount = count;
+			++summariesCount;
+		}
+	}
+
+	if(!logDetails && summariesCount == 0) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+
+	if(logDetails) {
+		logOperation(operation);
+		logger.warn << " returned SQL_SUCCESS_WITH_INFO:\n";
+		Diagnostics diagnostics(type, handle);
+		diagnostics.dump(logger.warn);
+	}
+
+	for(std::size_t i = 0; i < summariesCount; ++i) {
+		logOperation(operation);
+		logger.warn << " returned SQL_SUCCESS_WITH_INFO with SQLSTATE \"" << unpackState(summaries[i].state) << "\" "
+				<< summaries[i].count << " times since last report (" << summaries[i].totalCount << " times in total)\n";
+	}
+}
+
+std::vector<esl::database::ODBCInfoDiagnostics::Counter> InfoDiagnostics::getCounters() const {
+	std::vector<esl::database::ODBCInfoDiagnostics::Counter> counters;
+
+	for(std::size_t function = 0; function < esl::database::ODBCCallCounters::functionCount; ++function) {
+		for(const auto& slot : slots[function]) {
+			std::uint64_t count = slot.count.load(std::memory_order_relaxed);
+			if(count == 0) {
+				continue;
+			}
+
+			esl::database::ODBCInfoDiagnostics::Counter counter;
+			counter.operation = esl::database::ODBCCallCounters::getFunctionName(static_cast<Function>(function));
+			counter.state = unpackState(slot.state.load(std::memory_order_relaxed));
+			counter.count = count;
+			counter.reportedCount = slot.reportedCount.load(std::memory_order_relaxed);
+			counters.push_back(std::move(counter));
+		}
+	}
+
+	return counters;
+}
+
+void InfoDiagnostics::resetCounters() {
+	std::lock_guard<std::mutex> lock(mutex);
+	clear();
+}
+
+void InfoDiagnostics::mute(const std::string& state) {
+	std::uint64_t packedState = packState(reinterpret_cast<const SQLCHAR*>(state.c_str()));
+
+	std::lock_guard<std::mutex> lock(mutex);
+	if(isMuted(packedState)) {
+		return;
+	}
+	for(auto& mutedState : mutedStates) {
+		if(mutedState.load() == emptyState) {
+			mutedState.store(packedState);
+			return;
+		}
+	}
+	throw esl::system::Stacktrace::add(std::runtime_error("Cannot mute SQLSTATE \"" + state + "\", at most " + std::to_string(maximumMutedStates) + " SQLSTATEs can be muted."));
+}
+
+void InfoDiagnostics::unmute(const std::string& state) {
+	std::uint64_t packedState = packState(reinterpret_cast<const SQLCHAR*>(state.c_str()));
+
+	std::lock_guard<std::mutex> lock(mutex);
+	for(auto& mutedState : mutedStates) {
+		if(mutedState.load() == packedState) {
+			mutedState.store(emptyState);
+		}
+	}
+}
+
+void InfoDiagnostics::setLogInterval(std::chrono::milliseconds aLogInterval) {
+	logInterval.store(aLogInterval.count());
+}
+
+void InfoDiagnostics::logSummary() {
+	std::int64_t now = getNanoseconds();
+
+	std::lock_guard<std::mutex> lock(mutex);
+	for(std::size_t function = 0; function < esl::database::ODBCCallCounters::functionCount; ++function) {
+		for(auto& slot : slots[function]) {
+			std::uint64_t state = slot.state.load();
+			if(state == emptyState || isMuted(state)) {
+				continue;
+			}
+
+			std::uint64_t count = slot.count.load();
+			std::uint64_t reportedCount = slot.reportedCount.exchange(count);
+			if(count <= reportedCount) {
+				continue;
+			}
+			slot.reportedTime.store(now, std::memory_order_relaxed);
+
+			logOperation(esl::database::ODBCCallCounters::getFunctionName(static_cast<Function>(function)));
+			logger.warn << " returned SQL_SUCCESS_WITH_INFO with SQLSTATE \"" << unpackState(state) << "\" "
+					<< (count - reportedCount) << " times since last report (" << count << " times in total)\n";
+		}
+	}
+}
+
+InfoDiagnostics::Slot& InfoDiagnostics::getSlot(Function function, std::uint64_t state) noexcept {
+	Slot (&functionSlots)[statesPerFunction] = slots[static_cast<std::size_t>(function)];
+
+	for(std::size_t i = 0; i + 1 < statesPerFunction; ++i) {
+		std::uint64_t slotState = functionSlots[i].state.load(std::memory_order_acquire);
+		if(slotState == emptyState && functionSlots[i].state.compare_exchange_strong(slotState, state, std::memory_order_acq_rel)) {
+			return functionSlots[i];
+		}
+		/* slotState is the state of the slot, even if another thread has set it in the meantime */
+		if(slotState == state) {
+			return functionSlots[i];
+		}
+	}
+
+	return functionSlots[statesPerFunction - 1];
+}
+
+bool InfoDiagnostics::isMuted(std::uint64_t state) const noexcept {
+	for(const auto& mutedState : mutedStates) {
+		if(mutedState.load(std::memory_order_relaxed) == state) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void InfoDiagnostics::clear() noexcept {
+	for(auto& functionSlots : slots) {
+		for(std::size_t i = 0; i < statesPerFunction; ++i) {
+			functionSlots[i].state.store(i + 1 < statesPerFunction ? emptyState : otherState);
+			functionSlots[i].count.store(0);
+			functionSlots[i].reportedCount.store(0);
+			functionSlots[i].reportedTime.store(0);
+		}
+	}
+}
+
+std::uint64_t InfoDiagnostics::packState(const SQLCHAR* state) noexcept {
+	std::uint64_t packedState = 0;
+
+	for(std::size_t i = 0; i < SQL_SQLSTATE_SIZE && state[i] != 0; ++i) {
+		packedState |= static_cast<std::uint64_t>(state[i]) << (8 * i);
+	}
+
+	return packedState;
+}
+
+std::string InfoDiagnostics::unpackState(std::uint64_t packedState) {
+	std::string state;
+
+	if(packedState == otherState) {
+		return "other";
+	}
+
+	for(; packedState != 0; packedState >>= 8) {
+		state += static_cast<char>(packedState & 0xff);
+	}
+
+	return state;
+}
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
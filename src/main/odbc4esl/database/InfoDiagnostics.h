@@ -0,0 +1,101 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ODBC4ESL_DATABASE_INFODIAGNOSTICS_H_
+#define ODBC4ESL_DATABASE_INFODIAGNOSTICS_H_
+
+#include <esl/database/ODBCCallCounters.h>
+#include <esl/database/ODBCInfoDiagnostics.h>
+
+#include <sqlext.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+class InfoDiagnostics {
+public:
+	using Function = esl::database::ODBCCallCounters::Function;
+
+	static InfoDiagnostics& getInfoDiagnostics();
+
+	/* Called for every function that returned SQL_SUCCESS_WITH_INFO. Occurrences are counted with atomics,
+	 * the mutex is only locked if something has to be logged. */
+	void add(SQLSMALLINT type, SQLHANDLE handle, Function function, const char* operation);
+
+	std::vector<esl::database::ODBCInfoDiagnostics::Counter> getCounters() const;
+
+	/* Occurrences counted by other threads during the reset may get lost */
+	void resetCounters();
+
+	void mute(const std::string& state);
+	void unmute(const std::string& state);
+
+	void setLogInterval(std::chrono::milliseconds logInterval);
+
+	void logSummary();
+
+private:
+	/* Counter of one SQLSTATE of one function, the state is set once by the first thread that needs the slot */
+	struct Slot {
+		std::atomic<std::uint64_t> state;
+		std::atomic<std::uint64_t> count;
+		std::atomic<std::uint64_t> reportedCount;
+		std::atomic<std::int64_t> reportedTime;
+	};
+
+	/* the last slot of a function counts the SQLSTATEs that do not fit into the other slots */
+	static constexpr std::size_t statesPerFunction = 8;
+	static constexpr std::size_t maximumMutedStates = 16;
+
+	/* packed SQLSTATEs have at most 40 bits, so these values are never a packed SQLSTATE */
+	static constexpr std::uint64_t emptyState = ~static_cast<std::uint64_t>(0);
+	static constexpr std::uint64_t otherState = ~static_cast<std::uint64_t>(1);
+
+	InfoDiagnostics();
+
+	Slot& getSlot(Function function, std::uint64_t state) noexcept;
+	bool isMuted(std::uint64_t state) const noexcept;
+	void clear() noexcept;
+
+	static std::uint64_t packState(const SQLCHAR* state) noexcept;
+	static std::string unpackState(std::uint64_t state);
+
+	Slot slots[esl::database::ODBCCallCounters::functionCount][statesPerFunction];
+	std::atomic<std::uint64_t> mutedStates[maximumMutedStates];
+
+	/* milliseconds */
+	std::atomic<std::int64_t> logInterval;
+
+	/* serializes logging and changes of the settings */
+	std::mutex mutex;
+};
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
+
+#endif /* ODBC4ESL_DATABASE_INFODIAGNOSTICS_H_ */
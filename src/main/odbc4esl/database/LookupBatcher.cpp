@@ -0,0 +1,148 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <odbc4esl/database/LookupBatcher.h>
+
+#include <esl/database/ODBCResultSet.h>
+#include <esl/Logger.h>
+
+#include <esl/system/Stacktrace.h>
+
+#include <chrono>
+#include <stdexcept>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+namespace {
+esl::Logger logger("odbc4esl::database::LookupBatcher");
+
+/* values of CHAR(n) key columns are padded with blanks, so "ab" has to match "ab  " */
+std::string getKeyString(const esl::database::Field& field) {
+	std::string str = field.asString();
+	str.erase(str.find_last_not_of(' ') + 1);
+	return str;
+}
+}
+
+LookupBatcher::LookupBatcher(std::unique_ptr<esl::database::ODBCConnection> aConnection, const std::string& sql, std::size_t aKeyColumn, const Settings& aSettings)
+: connection(std::move(aConnection)),
+  keyColumn(aKeyColumn),
+  settings(aSettings)
+{
+	if(!connection) {
+		throw esl::system::Stacktrace::add(std::runtime_error("Lookup batcher requires a connection."));
+	}
+	if(settings.maximumBatchSize == 0) {
+		throw esl::system::Stacktrace::add(std::runtime_error("Maximum batch size of lookup batcher must not be 0."));
+	}
+
+	/* unused values of the IN list repeat the last key */
+	inListStatements.reset(new InListStatements(*connection, sql, settings.maximumBatchSize, InListStatements::Padding::repeatLast));
+}
+
+std::vector<std::vector<esl::database::Field>> LookupBatcher::lookup(const esl::database::Field& key) {
+	if(key.isNull()) {
+		return std::vector<std::vector<esl::database::Field>>();
+	}
+	std::string keyString = getKeyString(key);
+
+	std::unique_lock<std::mutex> lock(mutex);
+
+	std::shared_ptr<Batch> batch = openBatch;
+	bool executing = false;
+	if(!batch) {
+		batch = std::make_shared<Batch>();
+		openBatch = batch;
+		executing = true;
+	}
+
+	Entry& entry = batch->entries[keyString];
+	if(entry.waiters == 0) {
+		batch->keys.push_back(key);
+	}
+	++entry.waiters;
+
+	if(batch->keys.size() >= settings.maximumBatchSize) {
+		openBatch.reset();
+		batchClosed.notify_all();
+	}
+
+	if(executing) {
+		batchClosed.wait_for(lock, settings.maximumDelay, [&] { return openBatch != batch; });
+		if(openBatch == batch) {
+			openBatch.reset();
+		}
+
+		lock.unlock();
+		execute(*batch);
+		lock.lock();
+
+		batch->done = true;
+		batchDone.notify_all();
+	}
+	else {
+		batchDone.wait(lock, [&] { return batch->done; });
+	}
+
+	if(batch->exception) {
+		std::rethrow_exception(batch->exception);
+	}
+
+	/* the last caller of a key takes the rows, the others get a copy */
+	Entry& result = batch->entries[keyString];
+	if(--result.waiters == 0) {
+		return std::move(result.rows);
+	}
+	return result.rows;
+}
+
+void LookupBatcher::execute(Batch& batch) {
+	std::lock_guard<std::mutex> executeLock(executeMutex);
+
+	try {
+		logger.trace << "Execute batch of " << batch.keys.size() << " keys with IN list of size " << inListStatements->getBucketSize(batch.keys.size()) << "\n";
+
+		std::unique_ptr<esl::database::ODBCResultSet> resultSet = inListStatements->executeODBC(std::vector<esl::database::Field>(), batch.keys);
+		if(!resultSet) {
+			return;
+		}
+		if(keyColumn >= resultSet->getColumns().size()) {
+			throw esl::system::Stacktrace::add(std::runtime_error("Key column " + std::to_string(keyColumn) + " of lookup batcher does not exist, the result has " + std::to_string(resultSet->getColumns().size()) + " columns."));
+		}
+
+		std::vector<esl::database::Field> row(resultSet->getColumns().size());
+		while(resultSet->fetch(row)) {
+			if(row[keyColumn].isNull()) {
+				continue;
+			}
+			auto iter = batch.entries.find(getKeyString(row[keyColumn]));
+			if(iter != batch.entries.end()) {
+				iter->second.rows.push_back(row);
+			}
+		}
+	}
+	catch(...) {
+		batch.exception = std::current_exception();
+	}
+}
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
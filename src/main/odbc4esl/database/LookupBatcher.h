@@ -0,0 +1,82 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ODBC4ESL_DATABASE_LOOKUPBATCHER_H_
+#define ODBC4ESL_DATABASE_LOOKUPBATCHER_H_
+
+#include <odbc4esl/database/InListStatements.h>
+
+#include <esl/database/Field.h>
+#include <esl/database/ODBCConnection.h>
+#include <esl/database/ODBCLookupBatcher.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+class LookupBatcher : public esl::database::ODBCLookupBatcher {
+public:
+	LookupBatcher(std::unique_ptr<esl::database::ODBCConnection> connection, const std::string& sql, std::size_t keyColumn, const Settings& settings);
+
+	std::vector<std::vector<esl::database::Field>> lookup(const esl::database::Field& key) override;
+
+private:
+	struct Entry {
+		std::vector<std::vector<esl::database::Field>> rows;
+		std::size_t waiters = 0;
+	};
+
+	/* Keys of the callers are collected as long as the batch is open. After it has been closed
+	 * only the executing caller writes the rows, the other callers read them after done is set. */
+	struct Batch {
+		std::vector<esl::database::Field> keys;
+		std::unordered_map<std::string, Entry> entries;
+		bool done = false;
+		std::exception_ptr exception;
+	};
+
+	void execute(Batch& batch);
+
+	std::unique_ptr<esl::database::ODBCConnection> connection;
+	const std::size_t keyColumn;
+	const Settings settings;
+
+	std::mutex mutex;
+	std::condition_variable batchClosed;
+	std::condition_variable batchDone;
+	std::shared_ptr<Batch> openBatch;
+
+	/* serializes the executions on the connection */
+	std::mutex executeMutex;
+	std::unique_ptr<InListStatements> inListStatements;
+};
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
+
+#endif /* ODBC4ESL_DATABASE_LOOKUPBATCHER_H_ */
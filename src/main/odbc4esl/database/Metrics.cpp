@@ -0,0 +1,273 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <odbc4esl/database/Metrics.h>
+
+#include <cctype>
+#include <utility>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+namespace {
+bool isIdentifierCharacter(char c) {
+	return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '$';
+}
+
+/* appends a '?' and merges it with a preceding "?," or "?, " to a single '?' */
+void appendPlaceholder(std::string& fingerprint) {
+	std::size_t size = fingerprint.size();
+	if(size >= 3 && fingerprint[size-1] == ' ' && fingerprint[size-2] == ',' && fingerprint[size-3] == '?') {
+		fingerprint.resize(size-2);
+		return;
+	}
+	if(size >= 2 && fingerprint[size-1] == ',' && fingerprint[size-2] == '?') {
+		fingerprint.resize(size-1);
+		return;
+	}
+	fingerprint += '?';
+}
+}
+
+Metrics::Histogram::Histogram() noexcept {
+	reset();
+}
+
+void Metrics::Histogram::add(std::chrono::steady_clock::duration duration) noexcept {
+	std::uint64_t nanoseconds = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+	std::uint64_t microseconds = nanoseconds / 1000;
+
+	std::size_t bucket = 0;
+	for(; microseconds > 0 && bucket+1 < esl::database::ODBCMetrics::Histogram::bucketCount; microseconds >>= 1) {
+		++bucket;
+	}
+
+	buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+	count.fetch_add(1, std::memory_order_relaxed);
+	sumNanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+}
+
+void Metrics::Histogram::getSnapshot(esl::database::ODBCMetrics::Histogram& histogram) const {
+	histogram.buckets.resize(esl::database::ODBCMetrics::Histogram::bucketCount);
+	for(std::size_t i = 0; i < esl::database::ODBCMetrics::Histogram::bucketCount; ++i) {
+		histogram.buckets[i] = buckets[i].load(std::memory_order_relaxed);
+	}
+	histogram.count = count.load(std::memory_order_relaxed);
+	histogram.sumNanoseconds = sumNanoseconds.load(std::memory_order_relaxed);
+}
+
+void Metrics::Histogram::reset() noexcept {
+	for(auto& bucket : buckets) {
+		bucket.store(0, std::memory_order_relaxed);
+	}
+	count.store(0, std::memory_order_relaxed);
+	sumNanoseconds.store(0, std::memory_order_relaxed);
+}
+
+Metrics::Statement::Statement(std::string aFingerprint)
+: fingerprint(std::move(aFingerprint)),
+  rows(0),
+  bytes(0),
+  errors(0)
+{ }
+
+void Metrics::Statement::reset() noexcept {
+	prepare.reset();
+	execute.reset();
+	firstRow.reset();
+	drain.reset();
+	rows.store(0, std::memory_order_relaxed);
+	bytes.store(0, std::memory_order_relaxed);
+	errors.store(0, std::memory_order_relaxed);
+}
+
+Metrics::Metrics()
+: transactionErrors(0),
+  enabled(true)
+{ }
+
+Metrics& Metrics::getMetrics() {
+	static Metrics metrics;
+	return metrics;
+}
+
+std::string Metrics::createFingerprint(const std::string& sql) {
+	std::string fingerprint;
+	fingerprint.reserve(sql.size());
+
+	bool pendingSpace = false;
+	for(std::size_t i = 0; i < sql.size();) {
+		char c = sql[i];
+
+		// whitespace and comments
+		if(std::isspace(static_cast<unsigned char>(c))) {
+			pendingSpace = true;
+			++i;
+			continue;
+		}
+		if(c == '-' && i+1 < sql.size() && sql[i+1] == '-') {
+			for(; i < sql.size() && sql[i] != '\n'; ++i) { }
+			pendingSpace = true;
+			continue;
+		}
+		if(c == '/' && i+1 < sql.size() && sql[i+1] == '*') {
+			std::size_t end = sql.find("*/", i+2);
+			i = (end == std::string::npos) ? sql.size() : end+2;
+			pendingSpace = true;
+			continue;
+		}
+
+		if(pendingSpace && !fingerprint.empty()) {
+			fingerprint += ' ';
+		}
+		pendingSpace = false;
+
+		// string literals
+		if(c == '\'') {
+			for(++i; i < sql.size(); ++i) {
+				if(sql[i] == '\'') {
+					if(i+1 < sql.size() && sql[i+1] == '\'') {
+						++i;
+						continue;
+					}
+					++i;
+					break;
+				}
+			}
+			appendPlaceholder(fingerprint);
+			continue;
+		}
+
+		// quoted identifiers are kept as they are
+		if(c == '"') {
+			std::size_t end = sql.find('"', i+1);
+			end = (end == std::string::npos) ? sql.size() : end+1;
+			fingerprint.append(sql, i, end-i);
+			i = end;
+			continue;
+		}
+
+		// numeric literals, but not digits that are part of an identifier
+		if(std::isdigit(static_cast<unsigned char>(c)) && (fingerprint.empty() || !isIdentifierCharacter(fingerprint.back()))) {
+			for(++i; i < sql.size(); ++i) {
+				char n = sql[i];
+				if(std::isdigit(static_cast<unsigned char>(n)) || n == '.') {
+					continue;
+				}
+				if((n == 'e' || n == 'E') && i+1 < sql.size() && (std::isdigit(static_cast<unsigned char>(sql[i+1])) || sql[i+1] == '+' || sql[i+1] == '-')) {
+					++i;
+					continue;
+				}
+				break;
+			}
+			appendPlaceholder(fingerprint);
+			continue;
+		}
+
+		if(c == '?') {
+			appendPlaceholder(fingerprint);
+		}
+		else {
+			fingerprint += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+		}
+		++i;
+	}
+
+	return fingerprint;
+}
+
+bool Metrics::isEnabled() const noexcept {
+	return enabled.load(std::memory_order_relaxed);
+}
+
+void Metrics::setEnabled(bool aEnabled) noexcept {
+	enabled.store(aEnabled, std::memory_order_relaxed);
+}
+
+std::shared_ptr<Metrics::Statement> Metrics::getStatement(const std::string& sql) {
+	std::string fingerprint = createFingerprint(sql);
+
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto iter = statements.find(fingerprint);
+	if(iter != statements.end()) {
+		return iter->second;
+	}
+
+	/* the map is not allowed to grow without bound, further statements share the overflow bucket */
+	if(statements.size() >= esl::database::ODBCMetrics::maximumStatements) {
+		fingerprint = esl::database::ODBCMetrics::otherFingerprint;
+	}
+
+	std::shared_ptr<Statement>& statement = statements[fingerprint];
+	if(!statement) {
+		statement.reset(new Statement(std::move(fingerprint)));
+	}
+
+	return statement;
+}
+
+esl::database::ODBCMetrics::Snapshot Metrics::getSnapshot() const {
+	esl::database::ODBCMetrics::Snapshot snapshot;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		snapshot.statements.reserve(statements.size());
+		for(const auto& entry : statements) {
+			const Statement& statement = *entry.second;
+
+			esl::database::ODBCMetrics::Statement statementSnapshot;
+			statementSnapshot.fingerprint = statement.fingerprint;
+			statement.prepare.getSnapshot(statementSnapshot.prepare);
+			statement.execute.getSnapshot(statementSnapshot.execute);
+			statement.firstRow.getSnapshot(statementSnapshot.firstRow);
+			statement.drain.getSnapshot(statementSnapshot.drain);
+			statementSnapshot.rows = statement.rows.load(std::memory_order_relaxed);
+			statementSnapshot.bytes = statement.bytes.load(std::memory_order_relaxed);
+			statementSnapshot.errors = statement.errors.load(std::memory_order_relaxed);
+
+			snapshot.statements.push_back(std::move(statementSnapshot));
+		}
+	}
+
+	commit.getSnapshot(snapshot.commit);
+	rollback.getSnapshot(snapshot.rollback);
+	snapshot.transactionErrors = transactionErrors.load(std::memory_order_relaxed);
+
+	return snapshot;
+}
+
+void Metrics::reset() {
+	{
+		/* statements are still referenced by prepared statements, so they are reset instead of removed */
+		std::lock_guard<std::mutex> lock(mutex);
+		for(auto& entry : statements) {
+			entry.second->reset();
+		}
+	}
+
+	commit.reset();
+	rollback.reset();
+	transactionErrors.store(0, std::memory_order_relaxed);
+}
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
@@ -0,0 +1,102 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ODBC4ESL_DATABASE_METRICS_H_
+#define ODBC4ESL_DATABASE_METRICS_H_
+
+#include <esl/database/ODBCMetrics.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+class Metrics {
+public:
+	class Histogram {
+	public:
+		Histogram() noexcept;
+
+		Histogram(const Histogram&) = delete;
+		Histogram& operator=(const Histogram&) = delete;
+
+		void add(std::chrono::steady_clock::duration duration) noexcept;
+		void getSnapshot(esl::database::ODBCMetrics::Histogram& histogram) const;
+		void reset() noexcept;
+
+	private:
+		std::atomic<std::uint64_t> buckets[esl::database::ODBCMetrics::Histogram::bucketCount];
+		std::atomic<std::uint64_t> count;
+		std::atomic<std::uint64_t> sumNanoseconds;
+	};
+
+	struct Statement {
+		Statement(std::string fingerprint);
+
+		void reset() noexcept;
+
+		const std::string fingerprint;
+
+		Histogram prepare;
+		Histogram execute;
+		Histogram firstRow;
+		Histogram drain;
+
+		std::atomic<std::uint64_t> rows;
+		std::atomic<std::uint64_t> bytes;
+		std::atomic<std::uint64_t> errors;
+	};
+
+	static Metrics& getMetrics();
+
+	/* Normalizes SQL by replacing literals with '?', collapsing lists of '?' and whitespace and removing comments */
+	static std::string createFingerprint(const std::string& sql);
+
+	bool isEnabled() const noexcept;
+	void setEnabled(bool enabled) noexcept;
+
+	std::shared_ptr<Statement> getStatement(const std::string& sql);
+
+	esl::database::ODBCMetrics::Snapshot getSnapshot() const;
+	void reset();
+
+	Histogram commit;
+	Histogram rollback;
+	std::atomic<std::uint64_t> transactionErrors;
+
+private:
+	Metrics();
+
+	std::atomic<bool> enabled;
+
+	mutable std::mutex mutex;
+	std::map<std::string, std::shared_ptr<Statement>> statements;
+};
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
+
+#endif /* ODBC4ESL_DATABASE_METRICS_H_ */
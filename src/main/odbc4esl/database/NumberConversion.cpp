@@ -0,0 +1,197 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <odbc4esl/database/NumberConversion.h>
+
+#include <clocale>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#endif
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+namespace {
+bool isBlank(char c) noexcept {
+	return c == ' ' || c == '\t';
+}
+
+void trim(const char*& begin, const char*& end) noexcept {
+	for(; begin != end && isBlank(*begin); ++begin) { }
+	for(; begin != end && isBlank(*(end-1)); --end) { }
+}
+
+#if !defined(__cpp_lib_to_chars)
+char getLocaleDecimalPoint() noexcept {
+	const std::lconv* lconv = std::localeconv();
+	if(lconv && lconv->decimal_point && lconv->decimal_point[0] != 0) {
+		return lconv->decimal_point[0];
+	}
+	return '.';
+}
+#endif
+}
+
+constexpr std::size_t NumberConversion::maximumLength;
+
+std::size_t NumberConversion::formatInteger(std::int64_t value, char* buffer) noexcept {
+	/* negate as unsigned value to handle the minimum of std::int64_t */
+	std::uint64_t unsignedValue = value < 0 ? (~static_cast<std::uint64_t>(value) + 1) : static_cast<std::uint64_t>(value);
+
+	char digits[20];
+	std::size_t digitCount = 0;
+	do {
+		digits[digitCount++] = static_cast<char>('0' + unsignedValue % 10);
+		unsignedValue /= 10;
+	} while(unsignedValue > 0);
+
+	std::size_t length = 0;
+	if(value < 0) {
+		buffer[length++] = '-';
+	}
+	while(digitCount > 0) {
+		buffer[length++] = digits[--digitCount];
+	}
+
+	return length;
+}
+
+std::size_t NumberConversion::formatDouble(double value, char* buffer) noexcept {
+	if(std::isnan(value)) {
+		std::memcpy(buffer, "NaN", 3);
+		return 3;
+	}
+	if(std::isinf(value)) {
+		if(value < 0) {
+			std::memcpy(buffer, "-Infinity", 9);
+			return 9;
+		}
+		std::memcpy(buffer, "Infinity", 8);
+		return 8;
+	}
+
+#if defined(__cpp_lib_to_chars)
+	std::to_chars_result result = std::to_chars(buffer, buffer + maximumLength, value);
+	return static_cast<std::size_t>(result.ptr - buffer);
+#else
+	/* The shortest precision that reads back as the same value gives the same digits as std::to_chars.
+	 * snprintf and strtod use the decimal point of the C locale, so the shortest precision is searched in
+	 * locale representation and the decimal point is replaced afterwards. */
+	int length = 0;
+	for(int precision = 1; precision <= std::numeric_limits<double>::max_digits10; ++precision) {
+		length = std::snprintf(buffer, maximumLength, "%.*g", precision, value);
+		if(std::strtod(buffer, nullptr) == value) {
+			break;
+		}
+	}
+
+	/* %g uses the exponent form for integral values with more digits than the precision, e.g. "1e+02" for 100.
+	 * Like std::to_chars the fixed form is used instead if it is not longer. */
+	if(std::memchr(buffer, 'e', static_cast<std::size_t>(length)) && std::fabs(value) >= 1.0 && std::fabs(value) < 1e17) {
+		char fixed[maximumLength];
+		int fixedLength = std::snprintf(fixed, maximumLength, "%.0f", value);
+		if(fixedLength <= length) {
+			std::memcpy(buffer, fixed, static_cast<std::size_t>(fixedLength));
+			length = fixedLength;
+		}
+	}
+
+	char decimalPoint = getLocaleDecimalPoint();
+	if(decimalPoint != '.') {
+		for(int i = 0; i < length; ++i) {
+			if(buffer[i] == decimalPoint) {
+				buffer[i] = '.';
+				break;
+			}
+		}
+	}
+
+	return static_cast<std::size_t>(length);
+#endif
+}
+
+bool NumberConversion::parseInteger(const char* begin, const char* end, std::int64_t& value) noexcept {
+	trim(begin, end);
+
+	bool negative = false;
+	if(begin != end && (*begin == '-' || *begin == '+')) {
+		negative = (*begin == '-');
+		++begin;
+	}
+	if(begin == end) {
+		return false;
+	}
+
+	const std::uint64_t limit = negative ? static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()) + 1 : static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max());
+	std::uint64_t unsignedValue = 0;
+	for(; begin != end; ++begin) {
+		if(*begin < '0' || *begin > '9') {
+			return false;
+		}
+		std::uint64_t digit = static_cast<std::uint64_t>(*begin - '0');
+		if(unsignedValue > (limit - digit) / 10) {
+			return false;
+		}
+		unsignedValue = unsignedValue * 10 + digit;
+	}
+
+	value = negative ? static_cast<std::int64_t>(~unsignedValue + 1) : static_cast<std::int64_t>(unsignedValue);
+	return true;
+}
+
+bool NumberConversion::parseDouble(const char* begin, const char* end, double& value) noexcept {
+	trim(begin, end);
+
+	if(begin == end || static_cast<std::size_t>(end - begin) > 2 * maximumLength) {
+		return false;
+	}
+
+#if defined(__cpp_lib_to_chars)
+	if(*begin == '+') {
+		++begin;
+	}
+	std::from_chars_result result = std::from_chars(begin, end, value);
+	return result.ec == std::errc() && result.ptr == end;
+#else
+	/* strtod needs a NUL terminated string in locale representation */
+	char buffer[2 * maximumLength + 1];
+	char decimalPoint = getLocaleDecimalPoint();
+	std::size_t length = static_cast<std::size_t>(end - begin);
+	for(std::size_t i = 0; i < length; ++i) {
+		buffer[i] = (begin[i] == '.') ? decimalPoint : begin[i];
+	}
+	buffer[length] = 0;
+
+	char* parsedEnd = nullptr;
+	value = std::strtod(buffer, &parsedEnd);
+	return parsedEnd == buffer + length;
+#endif
+}
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
@@ -0,0 +1,51 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ODBC4ESL_DATABASE_NUMBERCONVERSION_H_
+#define ODBC4ESL_DATABASE_NUMBERCONVERSION_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+/* Locale independent conversions between numbers and text without allocations.
+ * Text is written to and read from the bind buffers directly. */
+class NumberConversion {
+public:
+	/* Maximum number of characters written by formatInteger and formatDouble, without terminating NUL */
+	static constexpr std::size_t maximumLength = 32;
+
+	/* Both return the number of characters written to buffer, which must have at least maximumLength bytes */
+	static std::size_t formatInteger(std::int64_t value, char* buffer) noexcept;
+
+	/* Shortest text that is parsed back to the same value, with '.' as decimal point */
+	static std::size_t formatDouble(double value, char* buffer) noexcept;
+
+	/* Both return false if [begin, end) is not a complete number. Leading and trailing blanks are ignored. */
+	static bool parseInteger(const char* begin, const char* end, std::int64_t& value) noexcept;
+	static bool parseDouble(const char* begin, const char* end, double& value) noexcept;
+};
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
+
+#endif /* ODBC4ESL_DATABASE_NUMBERCONVERSION_H_ */
@@ -18,7 +18,9 @@
 
 #include <odbc4esl/database/PreparedBulkStatementBinding.h>
 #include <odbc4esl/database/BindVariable.h>
+#include <odbc4esl/database/Deadline.h>
 #include <odbc4esl/database/Driver.h>
+#include <odbc4esl/database/StatementTiming.h>
 
 #include <esl/Logger.h>
 
@@ -26,6 +28,7 @@
 
 #include <sqlext.h>
 
+#include <chrono>
 #include <memory>
 #include <stdexcept>
 
@@ -40,8 +43,11 @@ esl::Logger logger("odbc4esl::database::PreparedBulkStatementBinding");
 PreparedBulkStatementBinding::PreparedBulkStatementBinding(const Connection& aConnection, const std::string& aSql, std::size_t defaultBufferSize, std::size_t maximumBufferSize)
 : connection(aConnection),
   sql(aSql),
-  statementHandle(Driver::getDriver().prepare(connection, sql))
+  statementMetrics(Metrics::getMetrics().isEnabled() ? Metrics::getMetrics().getStatement(sql) : nullptr)
 {
+	std::chrono::steady_clock::time_point prepareStart = std::chrono::steady_clock::now();
+	statementHandle = Driver::getDriver().prepare(connection, sql);
+
 	// Get number of result columns from prepared statement
 	SQLSMALLINT resultColumnCount = Driver::getDriver().numResultCols(statementHandle);
 	if(resultColumnCount > 0) {
@@ -58,8 +64,9 @@ PreparedBulkStatementBinding::PreparedBulkStatementBinding(const Connection& aCo
 		std::size_t parameterValueCharacterLength;
 		std::size_t parameterValueDecimalDigits;
 		bool parameterValueNullable;
+		SQLSMALLINT parameterSqlType;
 
-		Driver::getDriver().describeParam(statementHandle, i+1, parameterColumnType, parameterValueCharacterLength, parameterValueDecimalDigits, parameterValueNullable);
+		Driver::getDriver().describeParam(statementHandle, i+1, parameterColumnType, parameterValueCharacterLength, parameterValueDecimalDigits, parameterValueNullable, parameterSqlType);
 
 		if(logger.trace) {
 			logger.trace << "Column " << i << ":\n";
@@ -135,8 +142,13 @@ PreparedBulkStatementBinding::PreparedBulkStatementBinding(const Connection& aCo
 		}
 
 		parameterColumns.emplace_back("", parameterColumnType, parameterValueNullable, defaultBufferSize, maximumBufferSize, parameterValueDecimalDigits, parameterValueCharacterLength, parameterValueCharacterLength);
+		parameterSqlTypes.push_back(parameterSqlType);
     }
 	logger.trace << "-----------------------------------------------\n\n";
+
+	if(statementMetrics) {
+		statementMetrics->prepare.add(std::chrono::steady_clock::now() - prepareStart);
+	}
 }
 
 const std::vector<esl::database::Column>& PreparedBulkStatementBinding::getParameterColumns() const {
@@ -144,33 +156,64 @@ const std::vector<esl::database::Column>& PreparedBulkStatementBinding::getParam
 }
 
 void PreparedBulkStatementBinding::execute(const std::vector<esl::database::Field>& parameterValues) {
+	bindParameters(parameterValues);
+
+	StatementTiming statementTiming(statementMetrics, connection.getSlowStatementSettings(), sql, parameterValues);
+	Driver::getDriver().execute(statementHandle);
+	statementTiming.executed(true);
+}
+
+void* PreparedBulkStatementBinding::getNativeHandle() const {
+	if(statementHandle) {
+		return statementHandle.getHandle();
+	}
+	return nullptr;
+}
+
+esl::database::ODBCStatus PreparedBulkStatementBinding::tryExecute(const std::vector<esl::database::Field>& parameterValues, bool withMessage) {
+	bindParameters(parameterValues);
+
+	StatementTiming statementTiming(statementMetrics, connection.getSlowStatementSettings(), sql, parameterValues);
+
+	esl::database::ODBCStatus status;
+	Driver::getDriver().tryExecute(statementHandle, status, withMessage);
+	statementTiming.executed(status.success);
+
+	return status;
+}
+
+void PreparedBulkStatementBinding::bindParameters(const std::vector<esl::database::Field>& parameterValues) {
 	if(!statementHandle) {
 		logger.trace << "RE-Create statement handle\n";
+		std::chrono::steady_clock::time_point prepareStart = std::chrono::steady_clock::now();
 		statementHandle = StatementHandle(Driver::getDriver().prepare(connection, sql));
+		statementQueryTimeout = 0;
+		if(statementMetrics) {
+			statementMetrics->prepare.add(std::chrono::steady_clock::now() - prepareStart);
+		}
+	}
+
+	std::size_t timeout = Deadline::getQueryTimeout(0, "SQLExecute");
+	if(timeout != statementQueryTimeout) {
+		Driver::getDriver().setStmtAttr(statementHandle, SQL_ATTR_QUERY_TIMEOUT, reinterpret_cast<SQLPOINTER>(static_cast<SQLULEN>(timeout)), 0);
+		statementHandle.setAttributesChanged();
+		statementQueryTimeout = timeout;
 	}
 
 	if(parameterColumns.size() != parameterValues.size()) {
 	    throw esl::system::Stacktrace::add(std::runtime_error("Wrong number of arguments. Given " + std::to_string(parameterValues.size()) + " parameters but required " + std::to_string(parameterColumns.size()) + " parameters."));
 	}
 
-	std::vector<std::unique_ptr<BindVariable>> parameterVariables(parameterValues.size());
+	if(parameterVariables.size() != parameterColumns.size()) {
+		parameterVariables.resize(parameterColumns.size());
+		for(std::size_t i=0; i<parameterColumns.size(); ++i) {
+			parameterVariables[i].reset(new BindVariable(statementHandle, parameterColumns[i], i, parameterSqlTypes[i]));
+		}
+	}
 
 	for(std::size_t i=0; i<parameterValues.size(); ++i) {
-		parameterVariables[i].reset(new BindVariable(statementHandle, parameterColumns[i], i));
 		parameterVariables[i]->getField(parameterValues[i]);
 	}
-
-	/* ResultSetBinding makes the "execute" */
-	Driver::getDriver().execute(statementHandle);
-
-	esl::database::ResultSet resultSet;
-}
-
-void* PreparedBulkStatementBinding::getNativeHandle() const {
-	if(statementHandle) {
-		return statementHandle.getHandle();
-	}
-	return nullptr;
 }
 
 } /* namespace database */
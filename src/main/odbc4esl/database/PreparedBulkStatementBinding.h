@@ -19,13 +19,18 @@
 #ifndef ODBC4ESL_DATABASE_PREPAREDBULKSTATEMENTBINDING_H_
 #define ODBC4ESL_DATABASE_PREPAREDBULKSTATEMENTBINDING_H_
 
+#include <odbc4esl/database/BindVariable.h>
 #include <odbc4esl/database/Connection.h>
+#include <odbc4esl/database/Metrics.h>
 #include <odbc4esl/database/StatementHandle.h>
 
-#include <esl/database/PreparedBulkStatement.h>
 #include <esl/database/Column.h>
 #include <esl/database/Field.h>
+#include <esl/database/ODBCPreparedBulkStatement.h>
+#include <esl/database/ODBCStatus.h>
 
+#include <chrono>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -33,7 +38,7 @@ namespace odbc4esl {
 inline namespace v1_6 {
 namespace database {
 
-class PreparedBulkStatementBinding : public esl::database::PreparedBulkStatement::Binding {
+class PreparedBulkStatementBinding : public esl::database::ODBCPreparedBulkStatement {
 public:
 	PreparedBulkStatementBinding(const Connection& connection, const std::string& sql, std::size_t defaultBufferSize, std::size_t maximumBufferSize);
 
@@ -41,11 +46,25 @@ public:
 	void execute(const std::vector<esl::database::Field>& fields) override;
 	void* getNativeHandle() const override;
 
+	esl::database::ODBCStatus tryExecute(const std::vector<esl::database::Field>& fields, bool withMessage) override;
+
 private:
+	void bindParameters(const std::vector<esl::database::Field>& parameterValues);
+
 	const Connection& connection;
 	std::string sql;
+	std::shared_ptr<Metrics::Statement> statementMetrics;
 	StatementHandle statementHandle;
+
+	/* SQL_ATTR_QUERY_TIMEOUT set on statementHandle from the deadline of the last execution */
+	std::size_t statementQueryTimeout = 0;
 	std::vector<esl::database::Column> parameterColumns;
+
+	/* SQL types as described by the driver, e.g. SQL_BIGINT is bound as SQL_BIGINT instead of SQL_INTEGER */
+	std::vector<SQLSMALLINT> parameterSqlTypes;
+
+	/* created once and reused by every execution to avoid allocations per execute */
+	std::vector<std::unique_ptr<BindVariable>> parameterVariables;
 };
 
 } /* namespace database */
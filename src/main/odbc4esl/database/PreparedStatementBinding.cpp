@@ -18,8 +18,11 @@
 
 #include <odbc4esl/database/PreparedStatementBinding.h>
 #include <odbc4esl/database/BindVariable.h>
+#include <odbc4esl/database/Deadline.h>
 #include <odbc4esl/database/Driver.h>
 #include <odbc4esl/database/ResultSetBinding.h>
+#include <odbc4esl/database/RowFetcher.h>
+#include <odbc4esl/database/StatementTiming.h>
 
 #include <esl/Logger.h>
 
@@ -41,101 +44,16 @@ esl::Logger logger("odbc4esl::database::PreparedStatementBinding");
 PreparedStatementBinding::PreparedStatementBinding(const Connection& aConnection, const std::string& aSql, std::size_t defaultBufferSize, std::size_t maximumBufferSize)
 : connection(aConnection),
   sql(aSql),
-  statementHandle(Driver::getDriver().prepare(connection, sql))
+  statementMetrics(Metrics::getMetrics().isEnabled() ? Metrics::getMetrics().getStatement(sql) : nullptr)
 {
-	// Get number of result columns from prepared statement
-	SQLSMALLINT resultColumnCount = Driver::getDriver().numResultCols(statementHandle);
+	std::chrono::steady_clock::time_point prepareStart = std::chrono::steady_clock::now();
+	statementHandle = Driver::getDriver().prepare(connection, sql);
+	cancelHandle.set(statementHandle);
 
-	logger.trace << "Result columns from SQL \"" << sql << "\" (" << resultColumnCount << "):\n";
-	logger.trace << "-----------------------------------------------\n";
-	for(SQLSMALLINT i=0; i<resultColumnCount; ++i) {
-		std::string resultColumnName;
-		esl::database::Column::Type resultColumnType;
-		bool resultValueNullable;
-		std::size_t resultValueCharacterLength;
-		std::size_t resultValueDecimalDigits;
-		std::size_t resultValueDisplayLength;
-
-		Driver::getDriver().describeCol(statementHandle, i+1, resultColumnName, resultColumnType, resultValueCharacterLength, resultValueDecimalDigits, resultValueNullable);
-		Driver::getDriver().colAttributeDisplaySize(statementHandle, i+1, resultValueDisplayLength);
-
-		if(logger.trace) {
-			logger.trace << "Column " << i << ":\n";
-			logger.trace << "    Name: \"" << resultColumnName << "\"\n";
-			switch(resultColumnType) {
-			case esl::database::Column::Type::sqlBoolean:
-				logger.trace << "    Type: sqlBoolean\n";
-				break;
-			case esl::database::Column::Type::sqlInteger:
-				logger.trace << "    Type: sqlInteger\n";
-				break;
-			case esl::database::Column::Type::sqlSmallInt:
-				logger.trace << "    Type: sqlSmallInt\n";
-				break;
-			case esl::database::Column::Type::sqlDouble:
-				logger.trace << "    Type: sqlDouble\n";
-				break;
-			case esl::database::Column::Type::sqlNumeric:
-				logger.trace << "    Type: sqlNumeric\n";
-				break;
-			case esl::database::Column::Type::sqlDecimal:
-				logger.trace << "    Type: sqlDecimal\n";
-				break;
-			case esl::database::Column::Type::sqlFloat:
-				logger.trace << "    Type: sqlFloat\n";
-				break;
-			case esl::database::Column::Type::sqlReal:
-				logger.trace << "    Type: sqlReal\n";
-				break;
-			case esl::database::Column::Type::sqlVarChar:
-				logger.trace << "    Type: sqlVarChar\n";
-				break;
-			case esl::database::Column::Type::sqlChar:
-				logger.trace << "    Type: sqlChar\n";
-				break;
-			case esl::database::Column::Type::sqlDateTime:
-				logger.trace << "    Type: sqlDateTime\n";
-				break;
-			case esl::database::Column::Type::sqlDate:
-				logger.trace << "    Type: sqlDate\n";
-				break;
-			case esl::database::Column::Type::sqlTime:
-				logger.trace << "    Type: sqlTime\n";
-				break;
-			case esl::database::Column::Type::sqlTimestamp:
-				logger.trace << "    Type: sqlTimestamp\n";
-				break;
-			case esl::database::Column::Type::sqlWChar:
-				logger.trace << "    Type: sqlWChar\n";
-				break;
-			case esl::database::Column::Type::sqlWVarChar:
-				logger.trace << "    Type: sqlWVarChar\n";
-				break;
-			case esl::database::Column::Type::sqlWLongVarChar:
-				logger.trace << "    Type: sqlWLongVarChar\n";
-				break;
-			default:
-				logger.trace << "    Type: sqlUnknown\n";
-				break;
-			}
-
-			if(resultValueNullable) {
-				logger.trace << "    Nullable: true\n";
-			}
-			else {
-				logger.trace << "    Nullable: false\n";
-			}
-
-			logger.trace << "    CharacterLength: " << resultValueCharacterLength << "\n";
-
-			logger.trace << "    DecimalDigits: " << resultValueDecimalDigits << "\n";
-
-			logger.trace << "    DisplayLength: " << resultValueDisplayLength << "\n";
-		}
-
-		resultColumns.emplace_back(std::move(resultColumnName), resultColumnType, resultValueNullable, defaultBufferSize, maximumBufferSize, resultValueCharacterLength, resultValueDecimalDigits, resultValueDisplayLength);
-    }
-	logger.trace << "-----------------------------------------------\n\n";
+	logger.trace << "Result columns from SQL \"" << sql << "\":\n";
+	resultColumns = ResultSetBinding::describeColumns(statementHandle, defaultBufferSize, maximumBufferSize);
+	decodePlan = BindResult::createDecodePlan(resultColumns);
+	resultBufferSizes = std::make_shared<std::vector<std::size_t>>(resultColumns.size(), 0);
 
 	// Get number of parameters from prepared statement
 	SQLSMALLINT parameterCount = Driver::getDriver().numParams(statementHandle);
@@ -147,8 +65,9 @@ PreparedStatementBinding::PreparedStatementBinding(const Connection& aConnection
 		std::size_t parameterValueCharacterLength;
 		std::size_t parameterValueDecimalDigits;
 		bool parameterValueNullable;
+		SQLSMALLINT parameterSqlType;
 
-		Driver::getDriver().describeParam(statementHandle, i+1, parameterColumnType, parameterValueCharacterLength, parameterValueDecimalDigits, parameterValueNullable);
+		Driver::getDriver().describeParam(statementHandle, i+1, parameterColumnType, parameterValueCharacterLength, parameterValueDecimalDigits, parameterValueNullable, parameterSqlType);
 
 		if(logger.trace) {
 			logger.trace << "Column " << i << ":\n";
@@ -224,8 +143,17 @@ PreparedStatementBinding::PreparedStatementBinding(const Connection& aConnection
 		}
 
 		parameterColumns.emplace_back("", parameterColumnType, parameterValueNullable, defaultBufferSize, maximumBufferSize, parameterValueDecimalDigits, parameterValueCharacterLength, parameterValueCharacterLength);
+		parameterSqlTypes.push_back(parameterSqlType);
     }
 	logger.trace << "-----------------------------------------------\n\n";
+
+	if(statementMetrics) {
+		statementMetrics->prepare.add(std::chrono::steady_clock::now() - prepareStart);
+	}
+}
+
+PreparedStatementBinding::~PreparedStatementBinding() {
+	cancelHandle.reset();
 }
 
 const std::vector<esl::database::Column>& PreparedStatementBinding::getParameterColumns() const {
@@ -237,30 +165,196 @@ const std::vector<esl::database::Column>& PreparedStatementBinding::getResultCol
 }
 
 esl::database::ResultSet PreparedStatementBinding::execute(const std::vector<esl::database::Field>& parameterValues) {
+	std::chrono::steady_clock::time_point executeStart;
+	std::unique_ptr<SlowStatementLog> slowStatementLog = executeStatement(parameterValues, executeStart);
+
+	return createResultSet(executeStart, std::move(slowStatementLog));
+}
+
+std::unique_ptr<esl::database::ODBCResultSet> PreparedStatementBinding::executeODBC(const std::vector<esl::database::Field>& parameterValues) {
+	return executeODBC(parameterValues, esl::database::ODBCProjection());
+}
+
+std::unique_ptr<esl::database::ODBCResultSet> PreparedStatementBinding::executeODBC(const std::vector<esl::database::Field>& parameterValues, const esl::database::ODBCProjection& projection) {
+	std::chrono::steady_clock::time_point executeStart;
+	std::unique_ptr<SlowStatementLog> slowStatementLog = executeStatement(parameterValues, executeStart, projection.maximumLength);
+
+	if(!resultColumns.empty()) {
+		return std::unique_ptr<esl::database::ODBCResultSet>(new ResultSetBinding(releaseStatementHandle(), resultColumns, statementMetrics, executeStart, std::move(slowStatementLog), decodePlan, resultBufferSizes, projection));
+	}
+
+	/* a batch might start with statements without result set or the driver cannot describe result columns before execution */
+	std::vector<esl::database::Column> columns = ResultSetBinding::describeColumns(statementHandle, connection.getDefaultBufferSize(), connection.getMaximumBufferSize());
+	while(columns.empty()) {
+		if(!Driver::getDriver().moreResults(statementHandle)) {
+			return nullptr;
+		}
+		columns = ResultSetBinding::describeColumns(statementHandle, connection.getDefaultBufferSize(), connection.getMaximumBufferSize());
+	}
+
+	return std::unique_ptr<esl::database::ODBCResultSet>(new ResultSetBinding(releaseStatementHandle(), columns, statementMetrics, executeStart, std::move(slowStatementLog), nullptr, nullptr, projection));
+}
+
+std::unique_ptr<esl::database::ODBCRowFetcher> PreparedStatementBinding::executeRows(const std::vector<esl::database::Field>& parameterValues, std::size_t rowSize, const std::vector<esl::database::ODBCRowColumn>& rowColumns) {
+	std::chrono::steady_clock::time_point executeStart;
+	std::unique_ptr<SlowStatementLog> slowStatementLog = executeStatement(parameterValues, executeStart);
+
+	std::size_t columnCount = resultColumns.size();
+	if(columnCount == 0) {
+		columnCount = static_cast<std::size_t>(Driver::getDriver().numResultCols(statementHandle));
+	}
+	if(columnCount < rowColumns.size()) {
+		Driver::getDriver().freeStmt(statementHandle, SQL_CLOSE);
+		throw esl::system::Stacktrace::add(std::runtime_error("Row has " + std::to_string(rowColumns.size()) + " columns, but the result of the statement has " + std::to_string(columnCount) + " columns."));
+	}
+
+	return std::unique_ptr<esl::database::ODBCRowFetcher>(new RowFetcher(releaseStatementHandle(), rowSize, rowColumns, statementMetrics, executeStart, std::move(slowStatementLog)));
+}
+
+esl::database::ODBCStatus PreparedStatementBinding::tryExecute(const std::vector<esl::database::Field>& parameterValues, esl::database::ResultSet& resultSet, bool withMessage) {
+	bindParameters(parameterValues);
+
+	StatementTiming statementTiming(statementMetrics, connection.getSlowStatementSettings(), sql, parameterValues);
+
+	esl::database::ODBCStatus status;
+	Driver::getDriver().tryExecute(statementHandle, status, withMessage);
+	statementTiming.executed(status.success);
+
+	if(status.success) {
+		resultSet = createResultSet(statementTiming.getExecuteStart(), statementTiming.releaseSlowStatementLog());
+	}
+
+	return status;
+}
+
+void* PreparedStatementBinding::getNativeHandle() const {
+	if(statementHandle) {
+		return statementHandle.getHandle();
+	}
+	return nullptr;
+}
+
+void PreparedStatementBinding::bindParameters(const std::vector<esl::database::Field>& parameterValues, std::size_t maximumLength) {
 	if(!statementHandle) {
 		logger.trace << "RE-Create statement handle\n";
+		std::chrono::steady_clock::time_point prepareStart = std::chrono::steady_clock::now();
 		statementHandle = StatementHandle(Driver::getDriver().prepare(connection, sql));
+		statementMaximumLength = 0;
+		statementQueryTimeout = 0;
+		cancelHandle.set(statementHandle);
+		if(statementMetrics) {
+			statementMetrics->prepare.add(std::chrono::steady_clock::now() - prepareStart);
+		}
+	}
+
+	if(maximumLength != statementMaximumLength) {
+		Driver::getDriver().setStmtAttr(statementHandle, SQL_ATTR_MAX_LENGTH, reinterpret_cast<SQLPOINTER>(static_cast<SQLULEN>(maximumLength)), 0);
+		statementHandle.setAttributesChanged();
+		statementMaximumLength = maximumLength;
+	}
+
+	/* the attribute is set only if the timeout changes, but with a deadline the remaining time changes for most executions */
+	std::size_t timeout = Deadline::getQueryTimeout(queryTimeout, "SQLExecute");
+	if(timeout != statementQueryTimeout) {
+		Driver::getDriver().setStmtAttr(statementHandle, SQL_ATTR_QUERY_TIMEOUT, reinterpret_cast<SQLPOINTER>(static_cast<SQLULEN>(timeout)), 0);
+		statementHandle.setAttributesChanged();
+		statementQueryTimeout = timeout;
 	}
 
 	if(parameterColumns.size() != parameterValues.size()) {
 	    throw esl::system::Stacktrace::add(std::runtime_error("Wrong number of arguments. Given " + std::to_string(parameterValues.size()) + " parameters but required " + std::to_string(parameterColumns.size()) + " parameters."));
 	}
 
-	std::vector<std::unique_ptr<BindVariable>> parameterVariables(parameterValues.size());
+	if(parameterVariables.size() != parameterColumns.size()) {
+		parameterVariables.resize(parameterColumns.size());
+		for(std::size_t i=0; i<parameterColumns.size(); ++i) {
+			parameterVariables[i].reset(new BindVariable(statementHandle, parameterColumns[i], i, parameterSqlTypes[i]));
+		}
+	}
 
 	for(std::size_t i=0; i<parameterValues.size(); ++i) {
-		parameterVariables[i].reset(new BindVariable(statementHandle, parameterColumns[i], i));
 		parameterVariables[i]->getField(parameterValues[i]);
 	}
+}
+
+std::unique_ptr<SlowStatementLog> PreparedStatementBinding::executeStatement(const std::vector<esl::database::Field>& parameterValues, std::chrono::steady_clock::time_point& executeStart, std::size_t maximumLength) {
+	bindParameters(parameterValues, maximumLength);
 
-	/* ResultSetBinding makes the "execute" */
+	StatementTiming statementTiming(statementMetrics, connection.getSlowStatementSettings(), sql, parameterValues);
 	Driver::getDriver().execute(statementHandle);
+	statementTiming.executed(true);
 
+	executeStart = statementTiming.getExecuteStart();
+	return statementTiming.releaseSlowStatementLog();
+}
+
+bool PreparedStatementBinding::queryRow(const std::vector<esl::database::Field>& parameterValues, bool (*read)(esl::database::ODBCRow& row, void* context), void* context) {
+	std::chrono::steady_clock::time_point executeStart;
+	std::unique_ptr<SlowStatementLog> slowStatementLog = executeStatement(parameterValues, executeStart);
+
+	bool fetched = false;
+	bool found = false;
+	try {
+		if(!singleRowBinding) {
+			/* some drivers describe the result columns only after execution */
+			std::vector<esl::database::Column> columns = resultColumns.empty() ? ResultSetBinding::describeColumns(statementHandle, connection.getDefaultBufferSize(), connection.getMaximumBufferSize()) : resultColumns;
+			if(columns.empty()) {
+				throw esl::system::Stacktrace::add(std::runtime_error("Statement has no result set to query a row from."));
+			}
+			singleRowBinding.reset(new SingleRowBinding(statementHandle, std::move(columns), resultColumns.empty() ? nullptr : decodePlan, connection.getMaximumBufferSize()));
+		}
+
+		fetched = Driver::getDriver().fetch(statementHandle);
+		if(fetched && statementMetrics) {
+			statementMetrics->firstRow.add(std::chrono::steady_clock::now() - executeStart);
+			statementMetrics->bytes += singleRowBinding->getRowSize();
+		}
+		found = fetched && read(*singleRowBinding, context);
+	}
+	catch(...) {
+		Driver::getDriver().freeStmt(statementHandle, SQL_CLOSE);
+		throw;
+	}
+
+	/* remaining rows are discarded, the handle stays with the prepared statement */
+	Driver::getDriver().freeStmt(statementHandle, SQL_CLOSE);
+
+	if(statementMetrics) {
+		statementMetrics->drain.add(std::chrono::steady_clock::now() - executeStart);
+		statementMetrics->rows += fetched ? 1 : 0;
+	}
+	if(slowStatementLog) {
+		slowStatementLog->drained(fetched ? 1 : 0);
+	}
+
+	return found;
+}
+
+void PreparedStatementBinding::setQueryTimeout(std::chrono::seconds aQueryTimeout) {
+	queryTimeout = static_cast<std::size_t>(aQueryTimeout.count());
+}
+
+void PreparedStatementBinding::cancel() {
+	cancelHandle.cancel();
+}
+
+StatementHandle PreparedStatementBinding::releaseStatementHandle() {
+	cancelHandle.reset();
+
+	/* the driver must not write into buffers of the single row binding anymore */
+	if(singleRowBinding) {
+		Driver::getDriver().freeStmt(statementHandle, SQL_UNBIND);
+		singleRowBinding.reset();
+	}
+	return std::move(statementHandle);
+}
+
+esl::database::ResultSet PreparedStatementBinding::createResultSet(std::chrono::steady_clock::time_point executeStart, std::unique_ptr<SlowStatementLog> slowStatementLog) {
 	esl::database::ResultSet resultSet;
 
 	/* make a fetch, if SQL statement has result set (e.g. no INSERT, UPDATE, DELETE) */
 	if(!resultColumns.empty()) {
-		std::unique_ptr<esl::database::ResultSet::Binding> resultSetBinding(new ResultSetBinding(std::move(statementHandle), resultColumns));
+		std::unique_ptr<esl::database::ResultSet::Binding> resultSetBinding(new ResultSetBinding(releaseStatementHandle(), resultColumns, statementMetrics, executeStart, std::move(slowStatementLog), decodePlan, resultBufferSizes));
 
 		/* this makes a fetch */
 		resultSet = esl::database::ResultSet(std::unique_ptr<esl::database::ResultSet::Binding>(std::move(resultSetBinding)));
@@ -269,13 +363,6 @@ esl::database::ResultSet PreparedStatementBinding::execute(const std::vector<esl
 	return resultSet;
 }
 
-void* PreparedStatementBinding::getNativeHandle() const {
-	if(statementHandle) {
-		return statementHandle.getHandle();
-	}
-	return nullptr;
-}
-
 } /* namespace database */
 } /* inline namespace v1_6 */
 } /* namespace odbc4esl */
@@ -19,13 +19,23 @@
 #ifndef ODBC4ESL_DATABASE_PREPAREDSTATEMENTBINDING_H_
 #define ODBC4ESL_DATABASE_PREPAREDSTATEMENTBINDING_H_
 
+#include <odbc4esl/database/BindResult.h>
+#include <odbc4esl/database/BindVariable.h>
+#include <odbc4esl/database/CancelHandle.h>
 #include <odbc4esl/database/Connection.h>
+#include <odbc4esl/database/Metrics.h>
+#include <odbc4esl/database/SingleRowBinding.h>
+#include <odbc4esl/database/SlowStatementLog.h>
 #include <odbc4esl/database/StatementHandle.h>
 
-#include <esl/database/PreparedStatement.h>
 #include <esl/database/Column.h>
 #include <esl/database/Field.h>
+#include <esl/database/ODBCPreparedStatement.h>
+#include <esl/database/ODBCStatus.h>
+#include <esl/database/ResultSet.h>
 
+#include <chrono>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -33,21 +43,63 @@ namespace odbc4esl {
 inline namespace v1_6 {
 namespace database {
 
-class PreparedStatementBinding : public esl::database::PreparedStatement::Binding {
+class PreparedStatementBinding : public esl::database::ODBCPreparedStatement {
 public:
 	PreparedStatementBinding(const Connection& connection, const std::string& sql, std::size_t defaultBufferSize, std::size_t maximumBufferSize);
+	~PreparedStatementBinding();
 
 	const std::vector<esl::database::Column>& getParameterColumns() const override;
 	const std::vector<esl::database::Column>& getResultColumns() const override;
 	esl::database::ResultSet execute(const std::vector<esl::database::Field>& fields) override;
 	void* getNativeHandle() const override;
 
+	void setQueryTimeout(std::chrono::seconds queryTimeout) override;
+	void cancel() override;
+
+	using esl::database::ODBCPreparedStatement::tryExecute;
+	esl::database::ODBCStatus tryExecute(const std::vector<esl::database::Field>& fields, esl::database::ResultSet& resultSet, bool withMessage) override;
+	std::unique_ptr<esl::database::ODBCResultSet> executeODBC(const std::vector<esl::database::Field>& fields) override;
+	std::unique_ptr<esl::database::ODBCResultSet> executeODBC(const std::vector<esl::database::Field>& fields, const esl::database::ODBCProjection& projection) override;
+
+	using esl::database::ODBCPreparedStatement::executeRows;
+	std::unique_ptr<esl::database::ODBCRowFetcher> executeRows(const std::vector<esl::database::Field>& fields, std::size_t rowSize, const std::vector<esl::database::ODBCRowColumn>& rowColumns) override;
+
+protected:
+	bool queryRow(const std::vector<esl::database::Field>& fields, bool (*read)(esl::database::ODBCRow& row, void* context), void* context) override;
+
 private:
+	StatementHandle releaseStatementHandle();
+	void bindParameters(const std::vector<esl::database::Field>& parameterValues, std::size_t maximumLength = 0);
+	std::unique_ptr<SlowStatementLog> executeStatement(const std::vector<esl::database::Field>& parameterValues, std::chrono::steady_clock::time_point& executeStart, std::size_t maximumLength = 0);
+	esl::database::ResultSet createResultSet(std::chrono::steady_clock::time_point executeStart, std::unique_ptr<SlowStatementLog> slowStatementLog);
+
 	const Connection& connection;
 	std::string sql;
+	std::shared_ptr<Metrics::Statement> statementMetrics;
 	StatementHandle statementHandle;
 	std::vector<esl::database::Column> parameterColumns;
+
+	/* SQL_ATTR_MAX_LENGTH and SQL_ATTR_QUERY_TIMEOUT set on statementHandle by the last execution */
+	std::size_t statementMaximumLength = 0;
+	std::size_t statementQueryTimeout = 0;
+	std::size_t queryTimeout = 0;
+
+	/* allows cancel() from other threads while statementHandle is owned by this object */
+	CancelHandle cancelHandle;
+
+	/* SQL types as described by the driver, e.g. SQL_BIGINT is bound as SQL_BIGINT instead of SQL_INTEGER */
+	std::vector<SQLSMALLINT> parameterSqlTypes;
+
+	/* created once and reused by every execution to avoid allocations per execute */
+	std::vector<std::unique_ptr<BindVariable>> parameterVariables;
 	std::vector<esl::database::Column> resultColumns;
+	std::shared_ptr<const BindResult::DecodePlan> decodePlan;
+
+	/* buffer sizes of the result columns learned from the values of previous executions */
+	std::shared_ptr<std::vector<std::size_t>> resultBufferSizes;
+
+	/* result columns bound to statementHandle by queryRow(), they are unbound before the handle is given away */
+	std::unique_ptr<SingleRowBinding> singleRowBinding;
 };
 
 } /* namespace database */
@@ -17,7 +17,10 @@
  */
 
 #include <odbc4esl/database/ResultSetBinding.h>
+#include <odbc4esl/database/Connection.h>
+#include <odbc4esl/database/Deadline.h>
 #include <odbc4esl/database/Driver.h>
+#include <odbc4esl/database/HotPathTrace.h>
 
 #include <esl/Logger.h>
 
@@ -25,6 +28,7 @@
 
 #include <stdexcept>
 #include <limits>
+#include <new>
 
 namespace odbc4esl {
 inline namespace v1_6 {
@@ -34,17 +38,170 @@ namespace {
 esl::Logger logger("odbc4esl::database::ResultSetBinding");
 }
 
-ResultSetBinding::ResultSetBinding(StatementHandle&& aStatementHandle, const std::vector<esl::database::Column>& resultColumns/*, const std::vector<esl::database::Column>& parameterColumns, const std::vector<esl::database::Field>& parameterFields*/)
-: esl::database::ResultSet::Binding(resultColumns),
+ResultSetBinding::ResultSetBinding(StatementHandle&& aStatementHandle, const std::vector<esl::database::Column>& resultColumns, std::shared_ptr<const BindResult::DecodePlan> aDecodePlan, std::shared_ptr<std::vector<std::size_t>> aBufferSizes, const esl::database::ODBCProjection& projection)
+: esl::database::ODBCResultSet(resultColumns),
   statementHandle(std::move(aStatementHandle)),
-  bindResult(resultColumns.size())
+  decodePlan(aDecodePlan && aDecodePlan->size() == resultColumns.size() ? std::move(aDecodePlan) : BindResult::createDecodePlan(resultColumns)),
+  bufferSizes(aBufferSizes && aBufferSizes->size() == resultColumns.size() ? std::move(aBufferSizes) : nullptr),
+  lazy(projection.lazy)
 {
+	/* selected columns are bound in ascending order, because lazy columns must be read in this order by SQLGetData */
+	std::vector<std::size_t> selectedColumns;
+	if(!projection.columns.empty()) {
+		bindResultSlots.assign(resultColumns.size(), resultColumns.size());
+		for(std::size_t column : projection.columns) {
+			if(column >= resultColumns.size()) {
+				throw esl::system::Stacktrace::add(std::runtime_error("Projection contains column " + std::to_string(column) + ", but the result has " + std::to_string(resultColumns.size()) + " columns."));
+			}
+			bindResultSlots[column] = 0;
+		}
+		for(std::size_t column = 0; column < resultColumns.size(); ++column) {
+			if(bindResultSlots[column] == 0) {
+				bindResultSlots[column] = selectedColumns.size();
+				selectedColumns.push_back(column);
+			}
+			else {
+				unselectedColumns.push_back(column);
+			}
+		}
+	}
+	std::size_t selectedCount = projection.columns.empty() ? resultColumns.size() : selectedColumns.size();
+	bindResultStorage.reset(new BindResultStorage[selectedCount]);
+
+	const Connection* connection = statementHandle.getConnection();
+	std::size_t maximumBufferSize = connection ? connection->getMaximumBufferSize() : 0;
+
 	logger.trace << "Bind result variables\":\n";
 	logger.trace << "-----------------------------------------------\n";
-	for(std::size_t i=0; i<getColumns().size(); ++i) {
-		bindResult[i].reset(new BindResult(statementHandle, getColumns()[i], i));
+	try {
+		for(; bindResultCount<selectedCount; ++bindResultCount) {
+			std::size_t column = projection.columns.empty() ? bindResultCount : selectedColumns[bindResultCount];
+			std::size_t initialBufferSize = bufferSizes ? (*bufferSizes)[column] : 0;
+			new (&bindResultStorage[bindResultCount]) BindResult(statementHandle, getColumns()[column], column, initialBufferSize, maximumBufferSize, !lazy);
+		}
+	}
+	catch(...) {
+		clearBindResults();
+		throw;
 	}
 	logger.trace << "-----------------------------------------------\n\n";
+
+	cancelHandle.set(statementHandle);
+}
+
+ResultSetBinding::ResultSetBinding(StatementHandle&& aStatementHandle, const std::vector<esl::database::Column>& resultColumns, std::shared_ptr<Metrics::Statement> aStatementMetrics, std::chrono::steady_clock::time_point aExecuteStart, std::unique_ptr<SlowStatementLog> aSlowStatementLog, std::shared_ptr<const BindResult::DecodePlan> aDecodePlan, std::shared_ptr<std::vector<std::size_t>> aBufferSizes, const esl::database::ODBCProjection& projection)
+: ResultSetBinding(std::move(aStatementHandle), resultColumns, std::move(aDecodePlan), std::move(aBufferSizes), projection)
+{
+	statementMetrics = std::move(aStatementMetrics);
+	executeStart = aExecuteStart;
+	slowStatementLog = std::move(aSlowStatementLog);
+}
+
+ResultSetBinding::~ResultSetBinding() {
+	flushMetrics();
+	storeBufferSizes();
+	clearBindResults();
+	cancelHandle.reset();
+}
+
+std::vector<esl::database::Column> ResultSetBinding::describeColumns(const StatementHandle& statementHandle, std::size_t defaultBufferSize, std::size_t maximumBufferSize) {
+	std::vector<esl::database::Column> resultColumns;
+
+	// Get number of result columns of the prepared statement or of the current result
+	SQLSMALLINT resultColumnCount = Driver::getDriver().numResultCols(statementHandle);
+
+	logger.trace << "Result columns (" << resultColumnCount << "):\n";
+	logger.trace << "-----------------------------------------------\n";
+	for(SQLSMALLINT i=0; i<resultColumnCount; ++i) {
+		std::string resultColumnName;
+		esl::database::Column::Type resultColumnType;
+		bool resultValueNullable;
+		std::size_t resultValueCharacterLength;
+		std::size_t resultValueDecimalDigits;
+		std::size_t resultValueDisplayLength;
+
+		Driver::getDriver().describeCol(statementHandle, i+1, resultColumnName, resultColumnType, resultValueCharacterLength, resultValueDecimalDigits, resultValueNullable);
+		Driver::getDriver().colAttributeDisplaySize(statementHandle, i+1, resultValueDisplayLength);
+
+		if(logger.trace) {
+			logger.trace << "Column " << i << ":\n";
+			logger.trace << "    Name: \"" << resultColumnName << "\"\n";
+			switch(resultColumnType) {
+			case esl::database::Column::Type::sqlBoolean:
+				logger.trace << "    Type: sqlBoolean\n";
+				break;
+			case esl::database::Column::Type::sqlInteger:
+				logger.trace << "    Type: sqlInteger\n";
+				break;
+			case esl::database::Column::Type::sqlSmallInt:
+				logger.trace << "    Type: sqlSmallInt\n";
+				break;
+			case esl::database::Column::Type::sqlDouble:
+				logger.trace << "    Type: sqlDouble\n";
+				break;
+			case esl::database::Column::Type::sqlNumeric:
+				logger.trace << "    Type: sqlNumeric\n";
+				break;
+			case esl::database::Column::Type::sqlDecimal:
+				logger.trace << "    Type: sqlDecimal\n";
+				break;
+			case esl::database::Column::Type::sqlFloat:
+				logger.trace << "    Type: sqlFloat\n";
+				break;
+			case esl::database::Column::Type::sqlReal:
+				logger.trace << "    Type: sqlReal\n";
+				break;
+			case esl::database::Column::Type::sqlVarChar:
+				logger.trace << "    Type: sqlVarChar\n";
+				break;
+			case esl::database::Column::Type::sqlChar:
+				logger.trace << "    Type: sqlChar\n";
+				break;
+			case esl::database::Column::Type::sqlDateTime:
+				logger.trace << "    Type: sqlDateTime\n";
+				break;
+			case esl::database::Column::Type::sqlDate:
+				logger.trace << "    Type: sqlDate\n";
+				break;
+			case esl::database::Column::Type::sqlTime:
+				logger.trace << "    Type: sqlTime\n";
+				break;
+			case esl::database::Column::Type::sqlTimestamp:
+				logger.trace << "    Type: sqlTimestamp\n";
+				break;
+			case esl::database::Column::Type::sqlWChar:
+				logger.trace << "    Type: sqlWChar\n";
+				break;
+			case esl::database::Column::Type::sqlWVarChar:
+				logger.trace << "    Type: sqlWVarChar\n";
+				break;
+			case esl::database::Column::Type::sqlWLongVarChar:
+				logger.trace << "    Type: sqlWLongVarChar\n";
+				break;
+			default:
+				logger.trace << "    Type: sqlUnknown\n";
+				break;
+			}
+
+			if(resultValueNullable) {
+				logger.trace << "    Nullable: true\n";
+			}
+			else {
+				logger.trace << "    Nullable: false\n";
+			}
+
+			logger.trace << "    CharacterLength: " << resultValueCharacterLength << "\n";
+
+			logger.trace << "    DecimalDigits: " << resultValueDecimalDigits << "\n";
+
+			logger.trace << "    DisplayLength: " << resultValueDisplayLength << "\n";
+		}
+
+		resultColumns.emplace_back(std::move(resultColumnName), resultColumnType, resultValueNullable, defaultBufferSize, maximumBufferSize, resultValueCharacterLength, resultValueDecimalDigits, resultValueDisplayLength);
+    }
+	logger.trace << "-----------------------------------------------\n\n";
+
+	return resultColumns;
 }
 
 bool ResultSetBinding::fetch(std::vector<esl::database::Field>& fields) {
@@ -52,14 +209,23 @@ bool ResultSetBinding::fetch(std::vector<esl::database::Field>& fields) {
 		throw esl::system::Stacktrace::add(std::runtime_error("Called 'fetch' with wrong number of fields. Given " + std::to_string(fields.size()) + " fields, but it should be " + std::to_string(getColumns().size()) + " fields."));
 	}
 
-	if(Driver::getDriver().fetch(statementHandle) == false) {
+	if(!fetchRow()) {
 		return false;
 	}
 
-	logger.trace << "Fetch, set fields (" << getColumns().size() << "):\n";
-	logger.trace << "-----------------------------------------------\n";
-	for(std::size_t i=0; i<getColumns().size(); ++i) {
-		if(logger.trace) {
+	const BindResult::DecodePlan& decoders = *decodePlan;
+
+	for(std::size_t i : unselectedColumns) {
+		fields[i] = nullptr;
+	}
+
+	ODBC4ESL__HOT_PATH_TRACE << "Fetch, set fields (" << bindResultCount << "):\n";
+	ODBC4ESL__HOT_PATH_TRACE << "-----------------------------------------------\n";
+	for(std::size_t slot=0; slot<bindResultCount; ++slot) {
+		BindResult& result = getBindResult(slot);
+		std::size_t i = result.getIndex();
+
+		if(ODBC4ESL__HOT_PATH_TRACE_ENABLED) {
 			logger.trace << "Column " << i << ":\n";
 			logger.trace << "    Name: \"" << getColumns()[i].getName() << "\"\n";
 			switch(getColumns()[i].getType()) {
@@ -120,14 +286,74 @@ bool ResultSetBinding::fetch(std::vector<esl::database::Field>& fields) {
 			}
 		}
 
+		if(lazy && slot >= loadedCount) {
+			result.load();
+			loadedCount = slot + 1;
+		}
+		(result.*decoders[i])(fields[i]);
+		if(statementMetrics) {
+			bytes += result.getFieldSize();
+		}
+	}
+	ODBC4ESL__HOT_PATH_TRACE << "-----------------------------------------------\n\n";
+
+	return true;
+}
+
+bool ResultSetBinding::fetchRow() {
+	Deadline::check("SQLFetch");
 
-		bindResult[i]->setField(fields[i]);
+	if(Driver::getDriver().fetch(statementHandle) == false) {
+		if(statementMetrics) {
+			statementMetrics->drain.add(std::chrono::steady_clock::now() - executeStart);
+			flushMetrics();
+		}
+		if(slowStatementLog) {
+			slowStatementLog->drained(rows);
+			slowStatementLog.reset();
+		}
+		return false;
 	}
-	logger.trace << "-----------------------------------------------\n\n";
+
+	if(statementMetrics && rows == 0) {
+		statementMetrics->firstRow.add(std::chrono::steady_clock::now() - executeStart);
+	}
+
+	++rows;
+	loadedCount = 0;
 
 	return true;
 }
 
+void ResultSetBinding::cancel() {
+	cancelHandle.cancel();
+}
+
+bool ResultSetBinding::getInteger(std::size_t column, std::int64_t& value) {
+	BindResult& result = getColumnResult(column);
+	if(statementMetrics) {
+		bytes += result.getFieldSize();
+	}
+	return result.getInteger(value);
+}
+
+bool ResultSetBinding::getDouble(std::size_t column, double& value) {
+	BindResult& result = getColumnResult(column);
+	if(statementMetrics) {
+		bytes += result.getFieldSize();
+	}
+	return result.getDouble(value);
+}
+
+bool ResultSetBinding::getString(std::size_t column, std::string& value) {
+	BindResult& result = getColumnResult(column);
+	bool isNotNull = result.getString(value);
+	if(statementMetrics) {
+		bytes += result.getFieldSize();
+	}
+	return isNotNull;
+}
+
 bool ResultSetBinding::isEditable(std::size_t columnIndex) {
 	return false;
 }
@@ -140,6 +366,84 @@ void ResultSetBinding::save(std::vector<esl::database::Field>& fields) {
     throw esl::system::Stacktrace::add(std::runtime_error("save not allowed for query result set."));
 }
 
+std::unique_ptr<esl::database::ODBCResultSet> ResultSetBinding::nextResultSet() {
+	if(!statementHandle) {
+		return nullptr;
+	}
+
+	/* metrics and slow statement log cover the first result set only */
+	flushMetrics();
+	slowStatementLog.reset();
+
+	/* columns of the next result set might be less, so no column must stay bound to buffers of this result set */
+	Driver::getDriver().freeStmt(statementHandle, SQL_UNBIND);
+	storeBufferSizes();
+	clearBindResults();
+	bufferSizes.reset();
+
+	const Connection* connection = statementHandle.getConnection();
+	if(!connection) {
+		throw esl::system::Stacktrace::add(std::runtime_error("Cannot describe next result set of a statement handle without connection."));
+	}
+
+	while(Driver::getDriver().moreResults(statementHandle)) {
+		std::vector<esl::database::Column> columns = describeColumns(statementHandle, connection->getDefaultBufferSize(), connection->getMaximumBufferSize());
+		if(!columns.empty()) {
+			cancelHandle.reset();
+			return std::unique_ptr<esl::database::ODBCResultSet>(new ResultSetBinding(std::move(statementHandle), columns));
+		}
+		logger.trace << "Skip result without columns\n";
+	}
+
+	return nullptr;
+}
+
+BindResult& ResultSetBinding::getBindResult(std::size_t index) noexcept {
+	return *reinterpret_cast<BindResult*>(&bindResultStorage[index]);
+}
+
+BindResult& ResultSetBinding::getColumnResult(std::size_t column) {
+	std::size_t slot = column;
+	if(!bindResultSlots.empty()) {
+		if(column >= bindResultSlots.size() || bindResultSlots[column] >= bindResultCount) {
+			throw esl::system::Stacktrace::add(std::runtime_error("Column " + std::to_string(column) + " is not part of the projection."));
+		}
+		slot = bindResultSlots[column];
+	}
+
+	/* SQLGetData requires ascending column order, so columns in front of the requested one are read as well */
+	if(lazy) {
+		for(; loadedCount <= slot; ++loadedCount) {
+			getBindResult(loadedCount).load();
+		}
+	}
+
+	return getBindResult(slot);
+}
+
+void ResultSetBinding::clearBindResults() noexcept {
+	for(; bindResultCount > 0; --bindResultCount) {
+		getBindResult(bindResultCount-1).~BindResult();
+	}
+}
+
+void ResultSetBinding::storeBufferSizes() noexcept {
+	/* bufferSizes is indexed by result column, bind results of a projection are not */
+	if(bufferSizes) {
+		for(std::size_t i = 0; i < bindResultCount; ++i) {
+			(*bufferSizes)[getBindResult(i).getIndex()] = getBindResult(i).getBufferSize();
+		}
+	}
+}
+
+void ResultSetBinding::flushMetrics() noexcept {
+	if(statementMetrics) {
+		statementMetrics->rows += rows;
+		statementMetrics->bytes += bytes;
+		statementMetrics.reset();
+	}
+}
+
 } /* namespace database */
 } /* inline namespace v1_6 */
 } /* namespace odbc4esl */
@@ -21,12 +21,22 @@
 
 #include <odbc4esl/database/StatementHandle.h>
 #include <odbc4esl/database/BindResult.h>
+#include <odbc4esl/database/CancelHandle.h>
 #include <odbc4esl/database/BindVariable.h>
+#include <odbc4esl/database/Metrics.h>
+#include <odbc4esl/database/SlowStatementLog.h>
 
+#include <esl/database/ODBCProjection.h>
+#include <esl/database/ODBCResultSet.h>
 #include <esl/database/ResultSet.h>
 #include <esl/database/Column.h>
 #include <esl/database/Field.h>
 
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
 #include <vector>
 
 namespace odbc4esl {
@@ -35,18 +45,62 @@ namespace database {
 
 class Environment;
 
-class ResultSetBinding : public esl::database::ResultSet::Binding {
+class ResultSetBinding : public esl::database::ODBCResultSet {
 public:
-	ResultSetBinding(StatementHandle&& statementHandle, const std::vector<esl::database::Column>& resultColumns);
+	/* Describes the result columns of a prepared statement or of the current result after execution */
+	static std::vector<esl::database::Column> describeColumns(const StatementHandle& statementHandle, std::size_t defaultBufferSize, std::size_t maximumBufferSize);
+
+	/* decodePlan is created from the result columns if it is not given.
+	 * bufferSizes contains the buffer sizes learned by previous executions and gets the sizes of this result set when it is destroyed. */
+	ResultSetBinding(StatementHandle&& statementHandle, const std::vector<esl::database::Column>& resultColumns, std::shared_ptr<const BindResult::DecodePlan> decodePlan = nullptr, std::shared_ptr<std::vector<std::size_t>> bufferSizes = nullptr, const esl::database::ODBCProjection& projection = esl::database::ODBCProjection());
+	ResultSetBinding(StatementHandle&& statementHandle, const std::vector<esl::database::Column>& resultColumns, std::shared_ptr<Metrics::Statement> statementMetrics, std::chrono::steady_clock::time_point executeStart, std::unique_ptr<SlowStatementLog> slowStatementLog, std::shared_ptr<const BindResult::DecodePlan> decodePlan = nullptr, std::shared_ptr<std::vector<std::size_t>> bufferSizes = nullptr, const esl::database::ODBCProjection& projection = esl::database::ODBCProjection());
+	~ResultSetBinding();
 
 	bool fetch(std::vector<esl::database::Field>& fields) override;
 	bool isEditable(std::size_t columnIndex) override;
 	void add(std::vector<esl::database::Field>& fields) override;
 	void save(std::vector<esl::database::Field>& fields) override;
 
+	std::unique_ptr<esl::database::ODBCResultSet> nextResultSet() override;
+
+	bool fetchRow() override;
+	void cancel() override;
+	bool getInteger(std::size_t column, std::int64_t& value) override;
+	bool getDouble(std::size_t column, double& value) override;
+	bool getString(std::size_t column, std::string& value) override;
+
 private:
+	using BindResultStorage = std::aligned_storage<sizeof(BindResult), alignof(BindResult)>::type;
+
+	BindResult& getBindResult(std::size_t index) noexcept;
+	BindResult& getColumnResult(std::size_t column);
+	void clearBindResults() noexcept;
+	void storeBufferSizes() noexcept;
+	void flushMetrics() noexcept;
+
 	StatementHandle statementHandle;
-	std::vector<std::unique_ptr<BindResult>> bindResult;
+
+	/* all bind results are placed in one contiguous block instead of one allocation per column */
+	std::unique_ptr<BindResultStorage[]> bindResultStorage;
+	std::size_t bindResultCount = 0;
+	std::shared_ptr<const BindResult::DecodePlan> decodePlan;
+	std::shared_ptr<std::vector<std::size_t>> bufferSizes;
+
+	/* with a projection only the selected columns have a bind result, these are the others */
+	std::vector<std::size_t> unselectedColumns;
+	std::vector<std::size_t> bindResultSlots;
+	bool lazy = false;
+	std::size_t loadedCount = 0;
+
+	CancelHandle cancelHandle;
+
+	/* counters are collected locally and flushed once to avoid atomic operations per row */
+	std::shared_ptr<Metrics::Statement> statementMetrics;
+	std::chrono::steady_clock::time_point executeStart;
+	std::uint64_t rows = 0;
+	std::uint64_t bytes = 0;
+
+	std::unique_ptr<SlowStatementLog> slowStatementLog;
 };
 
 } /* namespace database */
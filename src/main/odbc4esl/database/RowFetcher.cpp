@@ -0,0 +1,146 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <odbc4esl/database/RowFetcher.h>
+#include <odbc4esl/database/Deadline.h>
+#include <odbc4esl/database/Driver.h>
+
+#include <esl/Logger.h>
+
+#include <esl/system/Stacktrace.h>
+
+#include <stdexcept>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+namespace {
+esl::Logger logger("odbc4esl::database::RowFetcher");
+
+static_assert(sizeof(esl::database::ODBCRowIndicator) == sizeof(SQLLEN), "ODBCRowIndicator must have the size of SQLLEN");
+static_assert(esl::database::ODBCRowColumn::nullData == SQL_NULL_DATA, "ODBCRowColumn::nullData must be SQL_NULL_DATA");
+}
+
+RowFetcher::RowFetcher(StatementHandle&& aStatementHandle, std::size_t aRowSize, const std::vector<esl::database::ODBCRowColumn>& aRowColumns, std::shared_ptr<Metrics::Statement> aStatementMetrics, std::chrono::steady_clock::time_point aExecuteStart, std::unique_ptr<SlowStatementLog> aSlowStatementLog)
+: statementHandle(std::move(aStatementHandle)),
+  rowSize(aRowSize),
+  rowColumns(aRowColumns),
+  statementMetrics(std::move(aStatementMetrics)),
+  executeStart(aExecuteStart),
+  slowStatementLog(std::move(aSlowStatementLog))
+{
+	for(const auto& rowColumn : rowColumns) {
+		if(rowColumn.valueOffset + rowColumn.valueSize > rowSize || rowColumn.indicatorOffset + sizeof(SQLLEN) > rowSize) {
+			throw esl::system::Stacktrace::add(std::runtime_error("Row column exceeds the row size of " + std::to_string(rowSize) + " bytes"));
+		}
+	}
+
+	/* row-wise binding attributes are reset when the handle is given back to the pool */
+	statementHandle.setAttributesChanged();
+	Driver::getDriver().setStmtAttr(statementHandle, SQL_ATTR_ROW_BIND_TYPE, reinterpret_cast<SQLPOINTER>(static_cast<SQLULEN>(rowSize)), 0);
+	Driver::getDriver().setStmtAttr(statementHandle, SQL_ATTR_ROWS_FETCHED_PTR, static_cast<SQLPOINTER>(&rowsFetched), 0);
+	Driver::getDriver().setStmtAttr(statementHandle, SQL_ATTR_ROW_BIND_OFFSET_PTR, static_cast<SQLPOINTER>(&rowBindOffset), 0);
+}
+
+RowFetcher::~RowFetcher() {
+	if(statementMetrics) {
+		statementMetrics->rows += rows;
+	}
+
+	/* the destructor of statementHandle gives it back to the pool, that unbinds the rows and resets row-wise binding */
+}
+
+std::size_t RowFetcher::fetch(void* aRows, std::size_t rowCount) {
+	if(done || rowCount == 0) {
+		return 0;
+	}
+	Deadline::check("SQLFetch");
+
+	if(rowCount != rowArraySize) {
+		Driver::getDriver().setStmtAttr(statementHandle, SQL_ATTR_ROW_ARRAY_SIZE, reinterpret_cast<SQLPOINTER>(static_cast<SQLULEN>(rowCount)), 0);
+		rowArraySize = rowCount;
+	}
+	/* the offset is unsigned, so a row array below the bound one is bound again */
+	char* rowArray = static_cast<char*>(aRows);
+	if(boundRows == nullptr || rowArray < boundRows) {
+		bindColumns(rowArray);
+	}
+	rowBindOffset = static_cast<SQLULEN>(rowArray - boundRows);
+
+	rowsFetched = 0;
+	if(Driver::getDriver().fetch(statementHandle) == false) {
+		finished();
+		return 0;
+	}
+
+	if(statementMetrics && rows == 0 && rowsFetched > 0) {
+		statementMetrics->firstRow.add(std::chrono::steady_clock::now() - executeStart);
+	}
+	rows += rowsFetched;
+
+	/* a partial row set is the last one */
+	if(rowsFetched < rowCount) {
+		finished();
+	}
+
+	return static_cast<std::size_t>(rowsFetched);
+}
+
+void RowFetcher::bindColumns(char* row) {
+
+	for(std::size_t i=0; i<rowColumns.size(); ++i) {
+		const esl::database::ODBCRowColumn& rowColumn = rowColumns[i];
+		SQLLEN* indicator = reinterpret_cast<SQLLEN*>(row + rowColumn.indicatorOffset);
+
+		switch(rowColumn.type) {
+		case esl::database::ODBCRowColumn::Type::integer:
+			Driver::getDriver().bindCol(statementHandle, i, SQL_C_SBIGINT, row + rowColumn.valueOffset, 0, indicator);
+			break;
+		case esl::database::ODBCRowColumn::Type::floatingPoint:
+			Driver::getDriver().bindCol(statementHandle, i, SQL_C_DOUBLE, row + rowColumn.valueOffset, 0, indicator);
+			break;
+		case esl::database::ODBCRowColumn::Type::character:
+			Driver::getDriver().bindCol(statementHandle, i, SQL_C_CHAR, row + rowColumn.valueOffset, static_cast<SQLLEN>(rowColumn.valueSize), indicator);
+			break;
+		}
+	}
+
+	boundRows = row;
+}
+
+void RowFetcher::finished() {
+	if(done) {
+		return;
+	}
+	done = true;
+
+	if(statementMetrics) {
+		statementMetrics->drain.add(std::chrono::steady_clock::now() - executeStart);
+		statementMetrics->rows += rows;
+		statementMetrics.reset();
+	}
+	if(slowStatementLog) {
+		slowStatementLog->drained(rows);
+		slowStatementLog.reset();
+	}
+}
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
@@ -0,0 +1,76 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ODBC4ESL_DATABASE_ROWFETCHER_H_
+#define ODBC4ESL_DATABASE_ROWFETCHER_H_
+
+#include <odbc4esl/database/Metrics.h>
+#include <odbc4esl/database/SlowStatementLog.h>
+#include <odbc4esl/database/StatementHandle.h>
+
+#include <esl/database/ODBCRowFetcher.h>
+#include <esl/database/ODBCRowLayout.h>
+
+#include <sqlext.h>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+/* Row-wise binding by SQL_ATTR_ROW_BIND_TYPE and SQL_ATTR_ROW_ARRAY_SIZE. Columns are bound once, another row array
+ * is addressed by SQL_ATTR_ROW_BIND_OFFSET_PTR. Columns are bound again only if a row array lies below the bound one.
+ * The statement attributes are reset by the statement handle pool, so the handle can be reused. */
+class RowFetcher : public esl::database::ODBCRowFetcher {
+public:
+	RowFetcher(StatementHandle&& statementHandle, std::size_t rowSize, const std::vector<esl::database::ODBCRowColumn>& rowColumns, std::shared_ptr<Metrics::Statement> statementMetrics, std::chrono::steady_clock::time_point executeStart, std::unique_ptr<SlowStatementLog> slowStatementLog);
+	~RowFetcher();
+
+	using esl::database::ODBCRowFetcher::fetch;
+	std::size_t fetch(void* rows, std::size_t rowCount) override;
+
+private:
+	void bindColumns(char* row);
+	void finished();
+
+	StatementHandle statementHandle;
+	const std::size_t rowSize;
+	const std::vector<esl::database::ODBCRowColumn> rowColumns;
+
+	char* boundRows = nullptr;
+	SQLULEN rowBindOffset = 0;
+	std::size_t rowArraySize = 1;
+	SQLULEN rowsFetched = 0;
+	bool done = false;
+
+	std::shared_ptr<Metrics::Statement> statementMetrics;
+	std::chrono::steady_clock::time_point executeStart;
+	std::uint64_t rows = 0;
+
+	std::unique_ptr<SlowStatementLog> slowStatementLog;
+};
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
+
+#endif /* ODBC4ESL_DATABASE_ROWFETCHER_H_ */
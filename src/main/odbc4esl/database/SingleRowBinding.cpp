@@ -0,0 +1,83 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <odbc4esl/database/SingleRowBinding.h>
+
+#include <esl/Logger.h>
+
+#include <esl/system/Stacktrace.h>
+
+#include <stdexcept>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+namespace {
+esl::Logger logger("odbc4esl::database::SingleRowBinding");
+}
+
+SingleRowBinding::SingleRowBinding(const StatementHandle& statementHandle, std::vector<esl::database::Column> aColumns, std::shared_ptr<const BindResult::DecodePlan> aDecodePlan, std::size_t maximumBufferSize)
+: columns(std::move(aColumns)),
+  decodePlan(aDecodePlan && aDecodePlan->size() == columns.size() ? std::move(aDecodePlan) : BindResult::createDecodePlan(columns))
+{
+	logger.trace << "Bind single row result variables:\n";
+	bindResults.reserve(columns.size());
+	for(std::size_t i=0; i<columns.size(); ++i) {
+		bindResults.emplace_back(new BindResult(statementHandle, columns[i], i, 0, maximumBufferSize));
+	}
+}
+
+const std::vector<esl::database::Column>& SingleRowBinding::getColumns() const {
+	return columns;
+}
+
+bool SingleRowBinding::getInteger(std::size_t column, std::int64_t& value) {
+	return bindResults.at(column)->getInteger(value);
+}
+
+bool SingleRowBinding::getDouble(std::size_t column, double& value) {
+	return bindResults.at(column)->getDouble(value);
+}
+
+bool SingleRowBinding::getString(std::size_t column, std::string& value) {
+	return bindResults.at(column)->getString(value);
+}
+
+void SingleRowBinding::getFields(std::vector<esl::database::Field>& fields) {
+	if(fields.size() != columns.size()) {
+		throw esl::system::Stacktrace::add(std::runtime_error("Called 'getFields' with wrong number of fields. Given " + std::to_string(fields.size()) + " fields, but it should be " + std::to_string(columns.size()) + " fields."));
+	}
+
+	const BindResult::DecodePlan& decoders = *decodePlan;
+	for(std::size_t i=0; i<bindResults.size(); ++i) {
+		(bindResults[i].get()->*decoders[i])(fields[i]);
+	}
+}
+
+std::size_t SingleRowBinding::getRowSize() const noexcept {
+	std::size_t size = 0;
+	for(const auto& bindResult : bindResults) {
+		size += bindResult->getFieldSize();
+	}
+	return size;
+}
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
@@ -0,0 +1,66 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ODBC4ESL_DATABASE_SINGLEROWBINDING_H_
+#define ODBC4ESL_DATABASE_SINGLEROWBINDING_H_
+
+#include <odbc4esl/database/BindResult.h>
+#include <odbc4esl/database/StatementHandle.h>
+
+#include <esl/database/Column.h>
+#include <esl/database/Field.h>
+#include <esl/database/ODBCRow.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+/* Result columns of a prepared statement that stay bound to its statement handle over all executions,
+ * so single row queries do not create a result set and bind the columns per execution.
+ * The columns must be unbound before the statement handle is used by anything else. */
+class SingleRowBinding : public esl::database::ODBCRow {
+public:
+	SingleRowBinding(const StatementHandle& statementHandle, std::vector<esl::database::Column> columns, std::shared_ptr<const BindResult::DecodePlan> decodePlan, std::size_t maximumBufferSize);
+
+	const std::vector<esl::database::Column>& getColumns() const override;
+
+	bool getInteger(std::size_t column, std::int64_t& value) override;
+	bool getDouble(std::size_t column, double& value) override;
+	bool getString(std::size_t column, std::string& value) override;
+	void getFields(std::vector<esl::database::Field>& fields) override;
+
+	/* Number of bytes the driver reported for all values of the fetched row */
+	std::size_t getRowSize() const noexcept;
+
+private:
+	const std::vector<esl::database::Column> columns;
+	std::shared_ptr<const BindResult::DecodePlan> decodePlan;
+	std::vector<std::unique_ptr<BindResult>> bindResults;
+};
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
+
+#endif /* ODBC4ESL_DATABASE_SINGLEROWBINDING_H_ */
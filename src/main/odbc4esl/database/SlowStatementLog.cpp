@@ -0,0 +1,113 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <odbc4esl/database/SlowStatementLog.h>
+
+#include <esl/Logger.h>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+namespace {
+esl::Logger logger("odbc4esl::database::SlowStatementLog");
+
+constexpr std::size_t maxParameterLength = 256;
+}
+
+SlowStatementLog::Settings::operator bool() const noexcept {
+	return threshold > std::chrono::milliseconds::zero();
+}
+
+SlowStatementLog::SlowStatementLog(const Settings& aSettings, const std::string& aSql, const std::vector<esl::database::Field>& aParameterValues, std::chrono::steady_clock::time_point aExecuteStart)
+: settings(aSettings),
+  sql(aSql),
+  executeStart(aExecuteStart)
+{
+	/* parameters are copied only and formatted lazy if the statement turns out to be slow */
+	if(settings.captureParameters) {
+		parameterValues = aParameterValues;
+	}
+}
+
+void SlowStatementLog::executed(bool success) {
+	std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - executeStart;
+	if(elapsed > settings.threshold) {
+		log(success ? "execute" : "failed execute", nullptr, elapsed);
+		logged = true;
+	}
+}
+
+void SlowStatementLog::drained(std::uint64_t rows) {
+	if(logged) {
+		return;
+	}
+
+	std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - executeStart;
+	if(elapsed > settings.threshold) {
+		log("execute and drain", &rows, elapsed);
+		logged = true;
+	}
+}
+
+void SlowStatementLog::log(const char* phase, const std::uint64_t* rows, std::chrono::steady_clock::duration elapsed) const {
+	if(!logger.warn) {
+		return;
+	}
+
+	logger.warn << "Slow statement (" << phase << "): " << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() << " ms";
+	if(rows) {
+		logger.warn << ", " << *rows << " rows";
+	}
+	logger.warn << "\n";
+	logger.warn << "    SQL: " << sql << "\n";
+
+	if(!settings.captureParameters) {
+		return;
+	}
+
+	for(std::size_t i=0; i<parameterValues.size(); ++i) {
+		logger.warn << "    Parameter " << (i+1) << ": ";
+		if(parameterValues[i].isNull()) {
+			logger.warn << "NULL\n";
+		}
+		else if(settings.redactParameters) {
+			logger.warn << "<" << parameterValues[i].getTypeName() << ">\n";
+		}
+		else {
+			std::string value = parameterValues[i].asString();
+			if(value.size() > maxParameterLength) {
+				logger.warn << "\"" << value.substr(0, maxParameterLength) << "\"... (" << value.size() << " characters)\n";
+			}
+			else {
+				logger.warn << "\"" << value << "\"\n";
+			}
+		}
+	}
+}
+
+std::unique_ptr<SlowStatementLog> createSlowStatementLog(const SlowStatementLog::Settings& settings, const std::string& sql, const std::vector<esl::database::Field>& parameterValues, std::chrono::steady_clock::time_point executeStart) {
+	if(!settings) {
+		return nullptr;
+	}
+	return std::unique_ptr<SlowStatementLog>(new SlowStatementLog(settings, sql, parameterValues, executeStart));
+}
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
@@ -0,0 +1,73 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ODBC4ESL_DATABASE_SLOWSTATEMENTLOG_H_
+#define ODBC4ESL_DATABASE_SLOWSTATEMENTLOG_H_
+
+#include <esl/database/Field.h>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+/* Created for each execution while the slow statement log is enabled. Logs the statement
+ * if the execute call or the execute call including the full drain of its result set
+ * exceeded the threshold. */
+class SlowStatementLog {
+public:
+	struct Settings {
+		/* zero disables the slow statement log */
+		std::chrono::milliseconds threshold = std::chrono::milliseconds::zero();
+		bool captureParameters = false;
+		bool redactParameters = false;
+
+		explicit operator bool() const noexcept;
+	};
+
+	SlowStatementLog(const Settings& settings, const std::string& sql, const std::vector<esl::database::Field>& parameterValues, std::chrono::steady_clock::time_point executeStart);
+
+	SlowStatementLog(const SlowStatementLog&) = delete;
+	SlowStatementLog& operator=(const SlowStatementLog&) = delete;
+
+	void executed(bool success);
+	void drained(std::uint64_t rows);
+
+private:
+	void log(const char* phase, const std::uint64_t* rows, std::chrono::steady_clock::duration elapsed) const;
+
+	const Settings settings;
+	const std::string sql;
+	std::vector<esl::database::Field> parameterValues;
+	const std::chrono::steady_clock::time_point executeStart;
+	bool logged = false;
+};
+
+/* nullptr if the slow statement log is disabled by settings */
+std::unique_ptr<SlowStatementLog> createSlowStatementLog(const SlowStatementLog::Settings& settings, const std::string& sql, const std::vector<esl::database::Field>& parameterValues, std::chrono::steady_clock::time_point executeStart);
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
+
+#endif /* ODBC4ESL_DATABASE_SLOWSTATEMENTLOG_H_ */
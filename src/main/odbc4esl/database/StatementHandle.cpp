@@ -18,6 +18,7 @@
 
 #include <odbc4esl/database/StatementHandle.h>
 #include <odbc4esl/database/Driver.h>
+#include <odbc4esl/database/StatementHandlePool.h>
 
 #include <esl/Logger.h>
 
@@ -34,9 +35,12 @@ esl::Logger logger("odbc4esl::database::PreparedHandle");
 }
 
 StatementHandle::StatementHandle(StatementHandle&& other)
-: handle(other.handle)
+: handle(other.handle),
+  pool(std::move(other.pool)),
+  attributesChanged(other.attributesChanged)
 {
 	other.handle = SQL_NULL_HSTMT;
+	other.attributesChanged = false;
 	logger.trace << "Statement handle constructed (moved)\n";
 }
 
@@ -44,6 +48,11 @@ StatementHandle::StatementHandle(SQLHANDLE aHandle)
 : handle(aHandle)
 { }
 
+StatementHandle::StatementHandle(SQLHANDLE aHandle, std::shared_ptr<StatementHandlePool> aPool)
+: handle(aHandle),
+  pool(std::move(aPool))
+{ }
+
 StatementHandle::~StatementHandle() {
 	if(handle == SQL_NULL_HSTMT) {
 		return;
@@ -56,9 +65,18 @@ StatementHandle::~StatementHandle() {
 	location.function = __func__;
 
 	try {
-		// free statement handle
-		Driver::getDriver().freeHandle(*this);
-		handle = SQL_NULL_HSTMT;
+		if(pool) {
+			// give statement handle back to the pool, it frees the handle if its connection has been closed
+			SQLHANDLE pooledHandle = handle;
+			handle = SQL_NULL_HSTMT;
+			std::shared_ptr<StatementHandlePool> releasePool(std::move(pool));
+			releasePool->release(pooledHandle, attributesChanged);
+		}
+		else {
+			// free statement handle
+			Driver::getDriver().freeHandle(*this);
+			handle = SQL_NULL_HSTMT;
+		}
 	}
 	catch (const esl::database::exception::SqlError& e) {
 		ESL__LOGGER_WARN_THIS("esl::database::exception::SqlError exception occured\n");
@@ -97,7 +115,10 @@ StatementHandle::~StatementHandle() {
 
 StatementHandle& StatementHandle::operator=(StatementHandle&& other) {
 	handle = other.handle;
+	pool = std::move(other.pool);
+	attributesChanged = other.attributesChanged;
 	other.handle = SQL_NULL_HSTMT;
+	other.attributesChanged = false;
 	logger.trace << "Statement handle moved\n";
 	return *this;
 }
@@ -110,6 +131,26 @@ SQLHANDLE StatementHandle::getHandle() const noexcept {
 	return handle;
 }
 
+const Connection* StatementHandle::getConnection() const noexcept {
+	return pool ? pool->getConnection() : nullptr;
+}
+
+const std::shared_ptr<StatementHandlePool>& StatementHandle::getPool() const noexcept {
+	return pool;
+}
+
+SQLHANDLE StatementHandle::release() noexcept {
+	SQLHANDLE releasedHandle = handle;
+	handle = SQL_NULL_HSTMT;
+	pool.reset();
+	attributesChanged = false;
+	return releasedHandle;
+}
+
+void StatementHandle::setAttributesChanged() noexcept {
+	attributesChanged = true;
+}
+
 } /* namespace database */
 } /* inline namespace v1_6 */
 } /* namespace odbc4esl */
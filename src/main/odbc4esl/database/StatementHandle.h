@@ -21,10 +21,15 @@
 
 #include <sqlext.h>
 
+#include <memory>
+
 namespace odbc4esl {
 inline namespace v1_6 {
 namespace database {
 
+class Connection;
+class StatementHandlePool;
+
 class StatementHandle {
 public:
 	StatementHandle() = default;
@@ -32,6 +37,9 @@ public:
 	StatementHandle(StatementHandle&& statementHandle);
 	StatementHandle(SQLHANDLE handle);
 
+	/* Handle will be given back to the pool instead of freeing it */
+	StatementHandle(SQLHANDLE handle, std::shared_ptr<StatementHandlePool> pool);
+
 	~StatementHandle();
 
 	StatementHandle& operator=(const StatementHandle&) = delete;
@@ -41,8 +49,22 @@ public:
 
 	SQLHANDLE getHandle() const noexcept;
 
+	/* Connection the handle belongs to, nullptr if it is not known or has been closed */
+	const Connection* getConnection() const noexcept;
+
+	/* Pool the handle is given back to, nullptr if the handle is freed */
+	const std::shared_ptr<StatementHandlePool>& getPool() const noexcept;
+
+	/* Returns the handle without freeing it. The object does not own the handle anymore. */
+	SQLHANDLE release() noexcept;
+
+	/* Marks that SQL_ATTR_QUERY_TIMEOUT or SQL_ATTR_MAX_LENGTH has been set, so they are reset before the handle is pooled */
+	void setAttributesChanged() noexcept;
+
 protected:
 	SQLHANDLE handle = SQL_NULL_HANDLE;
+	std::shared_ptr<StatementHandlePool> pool;
+	bool attributesChanged = false;
 };
 
 } /* namespace database */
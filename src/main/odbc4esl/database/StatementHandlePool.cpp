@@ -0,0 +1,103 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <odbc4esl/database/StatementHandlePool.h>
+#include <odbc4esl/database/Connection.h>
+#include <odbc4esl/database/Driver.h>
+
+#include <esl/system/Stacktrace.h>
+
+#include <stdexcept>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+StatementHandlePool::StatementHandlePool(const Connection& aConnection, std::size_t aSize)
+: connection(&aConnection),
+  size(aSize)
+{ }
+
+const Connection* StatementHandlePool::getConnection() const noexcept {
+	return connection.load(std::memory_order_acquire);
+}
+
+StatementHandle StatementHandlePool::acquire() {
+	const Connection* currentConnection = getConnection();
+	if(currentConnection == nullptr) {
+		throw esl::system::Stacktrace::add(std::runtime_error("Cannot acquire statement handle, connection has been closed."));
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if(!handles.empty()) {
+			SQLHANDLE pooledHandle = handles.back();
+			handles.pop_back();
+			return StatementHandle(pooledHandle, shared_from_this());
+		}
+	}
+
+	return StatementHandle(Driver::getDriver().allocHandleStatement(*currentConnection), shared_from_this());
+}
+
+void StatementHandlePool::release(SQLHANDLE aStatementHandle, bool resetAttributes) {
+	// destructor of StatementHandle frees the handle if it has not been put back to the pool
+	StatementHandle statementHandle(aStatementHandle);
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if(getConnection() == nullptr || handles.size() >= size) {
+			return;
+		}
+	}
+
+	Driver::getDriver().freeStmt(statementHandle, SQL_CLOSE);
+	Driver::getDriver().freeStmt(statementHandle, SQL_UNBIND);
+	Driver::getDriver().freeStmt(statementHandle, SQL_RESET_PARAMS);
+	if(resetAttributes) {
+		Driver::getDriver().setStmtAttr(statementHandle, SQL_ATTR_QUERY_TIMEOUT, reinterpret_cast<SQLPOINTER>(static_cast<SQLULEN>(0)), 0);
+		Driver::getDriver().setStmtAttr(statementHandle, SQL_ATTR_MAX_LENGTH, reinterpret_cast<SQLPOINTER>(static_cast<SQLULEN>(0)), 0);
+		Driver::getDriver().setStmtAttr(statementHandle, SQL_ATTR_ROW_ARRAY_SIZE, reinterpret_cast<SQLPOINTER>(static_cast<SQLULEN>(1)), 0);
+		Driver::getDriver().setStmtAttr(statementHandle, SQL_ATTR_ROW_BIND_TYPE, reinterpret_cast<SQLPOINTER>(SQL_BIND_BY_COLUMN), 0);
+		Driver::getDriver().setStmtAttr(statementHandle, SQL_ATTR_ROWS_FETCHED_PTR, nullptr, 0);
+		Driver::getDriver().setStmtAttr(statementHandle, SQL_ATTR_ROW_BIND_OFFSET_PTR, nullptr, 0);
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+	if(getConnection() != nullptr && handles.size() < size) {
+		handles.push_back(statementHandle.release());
+	}
+}
+
+void StatementHandlePool::close() noexcept {
+	std::vector<SQLHANDLE> pooledHandles;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		connection.store(nullptr, std::memory_order_release);
+		pooledHandles.swap(handles);
+	}
+
+	for(auto pooledHandle : pooledHandles) {
+		// destructor of StatementHandle frees the handle
+		StatementHandle statementHandle(pooledHandle);
+	}
+}
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
@@ -0,0 +1,73 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ODBC4ESL_DATABASE_STATEMENTHANDLEPOOL_H_
+#define ODBC4ESL_DATABASE_STATEMENTHANDLEPOOL_H_
+
+#include <odbc4esl/database/StatementHandle.h>
+
+#include <sqlext.h>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+class Connection;
+
+/* Idle statement handles of a connection. Statement handles keep the pool alive by a shared pointer,
+ * so they can be given back safely also if they outlive their connection. */
+class StatementHandlePool : public std::enable_shared_from_this<StatementHandlePool> {
+public:
+	StatementHandlePool(const Connection& connection, std::size_t size);
+
+	StatementHandlePool(const StatementHandlePool&) = delete;
+	StatementHandlePool& operator=(const StatementHandlePool&) = delete;
+
+	/* Connection of the pool, nullptr after close() */
+	const Connection* getConnection() const noexcept;
+
+	/* Takes a statement handle from the pool or allocates a new one if the pool is empty */
+	StatementHandle acquire();
+
+	/* Resets the statement handle and puts it back to the pool or frees it if the pool is full or closed.
+	 * Statement attributes are reset only if resetAttributes is true to save the calls otherwise. */
+	void release(SQLHANDLE statementHandle, bool resetAttributes);
+
+	/* Frees the pooled handles. Handles released afterwards are freed instead of pooled.
+	 * Called by the connection before it disconnects. */
+	void close() noexcept;
+
+private:
+	std::atomic<const Connection*> connection;
+	const std::size_t size;
+
+	std::mutex mutex;
+	std::vector<SQLHANDLE> handles;
+};
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
+
+#endif /* ODBC4ESL_DATABASE_STATEMENTHANDLEPOOL_H_ */
@@ -0,0 +1,73 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <odbc4esl/database/StatementTiming.h>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+StatementTiming::StatementTiming(const std::shared_ptr<Metrics::Statement>& aStatementMetrics, const SlowStatementLog::Settings& slowStatementSettings, const std::string& sql, const std::vector<esl::database::Field>& parameterValues)
+: statementMetrics(aStatementMetrics.get())
+{
+	if(statementMetrics || slowStatementSettings) {
+		executeStart = std::chrono::steady_clock::now();
+	}
+	slowStatementLog = createSlowStatementLog(slowStatementSettings, sql, parameterValues, executeStart);
+}
+
+StatementTiming::~StatementTiming() {
+	if(done) {
+		return;
+	}
+
+	/* called while an exception of execute propagates, so nothing must escape */
+	try {
+		executed(false);
+	}
+	catch(...) {
+	}
+}
+
+void StatementTiming::executed(bool success) {
+	done = true;
+
+	if(statementMetrics) {
+		if(success) {
+			statementMetrics->execute.add(std::chrono::steady_clock::now() - executeStart);
+		}
+		else {
+			++statementMetrics->errors;
+		}
+	}
+	if(slowStatementLog) {
+		slowStatementLog->executed(success);
+	}
+}
+
+std::chrono::steady_clock::time_point StatementTiming::getExecuteStart() const noexcept {
+	return executeStart;
+}
+
+std::unique_ptr<SlowStatementLog> StatementTiming::releaseSlowStatementLog() noexcept {
+	return std::move(slowStatementLog);
+}
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
@@ -0,0 +1,66 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ODBC4ESL_DATABASE_STATEMENTTIMING_H_
+#define ODBC4ESL_DATABASE_STATEMENTTIMING_H_
+
+#include <odbc4esl/database/Metrics.h>
+#include <odbc4esl/database/SlowStatementLog.h>
+
+#include <esl/database/Field.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+/* Records one execute call in the statement metrics and the slow statement log.
+ * If it is destroyed before executed() has been called, e.g. because execute threw, it records a failed execution. */
+class StatementTiming {
+public:
+	StatementTiming(const std::shared_ptr<Metrics::Statement>& statementMetrics, const SlowStatementLog::Settings& slowStatementSettings, const std::string& sql, const std::vector<esl::database::Field>& parameterValues);
+	~StatementTiming();
+
+	StatementTiming(const StatementTiming&) = delete;
+	StatementTiming& operator=(const StatementTiming&) = delete;
+
+	void executed(bool success);
+
+	/* time point is set only if metrics or the slow statement log are enabled */
+	std::chrono::steady_clock::time_point getExecuteStart() const noexcept;
+
+	/* the slow statement log of a successful execution continues with the result set to log the drain */
+	std::unique_ptr<SlowStatementLog> releaseSlowStatementLog() noexcept;
+
+private:
+	/* owned by the caller, it outlives the execute call */
+	Metrics::Statement* statementMetrics;
+	std::chrono::steady_clock::time_point executeStart;
+	std::unique_ptr<SlowStatementLog> slowStatementLog;
+	bool done = false;
+};
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
+
+#endif /* ODBC4ESL_DATABASE_STATEMENTTIMING_H_ */
@@ -0,0 +1,113 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <odbc4esl/benchmark/Benchmark.h>
+#include <odbc4esl/test/AllocationCounter.h>
+
+#include <iostream>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace benchmark {
+
+namespace {
+void writeString(std::ostream& stream, const std::string& str) {
+	stream << '"';
+	for(char c : str) {
+		switch(c) {
+		case '"':
+			stream << "\\\"";
+			break;
+		case '\\':
+			stream << "\\\\";
+			break;
+		case '\n':
+			stream << "\\n";
+			break;
+		default:
+			stream << c;
+			break;
+		}
+	}
+	stream << '"';
+}
+
+double perOperation(double value, std::uint64_t operations) {
+	return operations == 0 ? 0.0 : value / static_cast<double>(operations);
+}
+}
+
+Benchmark::Benchmark(std::string aSuite, std::size_t aRows)
+: suite(std::move(aSuite)),
+  rows(aRows)
+{ }
+
+std::size_t Benchmark::getRows() const noexcept {
+	return rows;
+}
+
+void Benchmark::run(const std::string& name, const std::function<std::uint64_t()>& body) {
+	test::AllocationCounter allocationCounter;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	std::uint64_t operations = body();
+	std::chrono::nanoseconds duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+	std::uint64_t allocations = allocationCounter.getAllocations();
+
+	results.push_back(Result{name, operations, duration, allocations});
+
+	std::cerr << suite << "/" << name << ": " << operations << " operations, "
+			<< perOperation(static_cast<double>(duration.count()), operations) << " ns/op, "
+			<< perOperation(static_cast<double>(allocations), operations) << " allocations/op\n";
+}
+
+const std::vector<Benchmark::Result>& Benchmark::getResults() const noexcept {
+	return results;
+}
+
+void Benchmark::writeJSON(std::ostream& stream, const std::string& metricsJSON) const {
+	stream << "{\n";
+	stream << "  \"suite\": ";
+	writeString(stream, suite);
+	stream << ",\n";
+	stream << "  \"rows\": " << rows << ",\n";
+	stream << "  \"results\": [";
+	for(std::size_t i = 0; i < results.size(); ++i) {
+		const Result& result = results[i];
+		double nanoseconds = static_cast<double>(result.duration.count());
+
+		stream << (i == 0 ? "\n" : ",\n");
+		stream << "    {\"name\": ";
+		writeString(stream, result.name);
+		stream << ", \"operations\": " << result.operations;
+		stream << ", \"nanoseconds\": " << result.duration.count();
+		stream << ", \"nanosecondsPerOperation\": " << perOperation(nanoseconds, result.operations);
+		stream << ", \"operationsPerSecond\": " << (nanoseconds > 0 ? static_cast<double>(result.operations) * 1e9 / nanoseconds : 0.0);
+		stream << ", \"allocations\": " << result.allocations;
+		stream << ", \"allocationsPerOperation\": " << perOperation(static_cast<double>(result.allocations), result.operations);
+		stream << "}";
+	}
+	stream << "\n  ]";
+	if(!metricsJSON.empty()) {
+		stream << ",\n  \"metrics\": " << metricsJSON;
+	}
+	stream << "\n}\n";
+}
+
+} /* namespace benchmark */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
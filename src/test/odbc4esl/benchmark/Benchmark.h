@@ -0,0 +1,71 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ODBC4ESL_BENCHMARK_BENCHMARK_H_
+#define ODBC4ESL_BENCHMARK_BENCHMARK_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace benchmark {
+
+/* Runs the cases of a suite and writes their results as JSON document, so runs before and after an upgrade can be compared by tools */
+class Benchmark {
+public:
+	struct Result {
+		std::string name;
+
+		/* e.g. executions or fetched rows, depending on the case */
+		std::uint64_t operations;
+		std::chrono::nanoseconds duration;
+
+		/* calls of operator new by the benchmark thread while the case was running */
+		std::uint64_t allocations;
+	};
+
+	Benchmark(std::string suite, std::size_t rows);
+
+	/* number of rows the suite inserts and fetches per case */
+	std::size_t getRows() const noexcept;
+
+	/* Runs body once and records its duration and allocations. body returns the number of operations it has done. */
+	void run(const std::string& name, const std::function<std::uint64_t()>& body);
+
+	const std::vector<Result>& getResults() const noexcept;
+
+	/* metricsJSON is added as "metrics" member if it is not empty, see esl::database::ODBCMetrics::getJSON() */
+	void writeJSON(std::ostream& stream, const std::string& metricsJSON) const;
+
+private:
+	const std::string suite;
+	const std::size_t rows;
+	std::vector<Result> results;
+};
+
+} /* namespace benchmark */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
+
+#endif /* ODBC4ESL_BENCHMARK_BENCHMARK_H_ */
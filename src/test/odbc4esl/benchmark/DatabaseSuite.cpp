@@ -0,0 +1,170 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <odbc4esl/benchmark/DatabaseSuite.h>
+
+#include <esl/database/Field.h>
+#include <esl/database/ODBCPreparedBulkStatement.h>
+#include <esl/database/ODBCPreparedStatement.h>
+#include <esl/database/ODBCResultSet.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace benchmark {
+
+namespace {
+/* every single row case executes this number of statements */
+constexpr std::size_t singleRowExecutions = 1000;
+
+/* fetch cases are repeated, so they are not dominated by the execution of the statement */
+constexpr std::size_t fetchRepetitions = 5;
+
+std::string createString(std::size_t length, std::size_t row) {
+	std::string str = std::to_string(row);
+	str.resize(length, static_cast<char>('a' + row % 26));
+	return str;
+}
+
+void insertRows(Benchmark& benchmark, esl::database::ODBCConnection& connection) {
+	benchmark.run("bulk_insert_numeric", [&]() {
+		std::unique_ptr<esl::database::ODBCPreparedBulkStatement> statement = connection.prepareBulkODBC("INSERT INTO bench_numeric (id, a, b, c, d) VALUES (?, ?, ?, ?, ?)");
+		std::vector<esl::database::Field> fields(5);
+		for(std::size_t row = 0; row < benchmark.getRows(); ++row) {
+			fields[0] = static_cast<std::int64_t>(row);
+			fields[1] = static_cast<std::int64_t>(row * 7);
+			fields[2] = static_cast<std::int64_t>(row % 100);
+			fields[3] = static_cast<double>(row) / 3.0;
+			fields[4] = static_cast<double>(row) * 1.5;
+			statement->execute(fields);
+		}
+		connection.commit();
+		return static_cast<std::uint64_t>(benchmark.getRows());
+	});
+
+	benchmark.run("bulk_insert_string", [&]() {
+		std::unique_ptr<esl::database::ODBCPreparedBulkStatement> statement = connection.prepareBulkODBC("INSERT INTO bench_string (id, s16, s64, s256, s4096) VALUES (?, ?, ?, ?, ?)");
+		std::vector<esl::database::Field> fields(5);
+		for(std::size_t row = 0; row < benchmark.getRows(); ++row) {
+			fields[0] = static_cast<std::int64_t>(row);
+			fields[1] = createString(16, row);
+			fields[2] = createString(64, row);
+			fields[3] = createString(256, row);
+			fields[4] = createString(4096, row);
+			statement->execute(fields);
+		}
+		connection.commit();
+		return static_cast<std::uint64_t>(benchmark.getRows());
+	});
+}
+
+void runSingleRow(Benchmark& benchmark, esl::database::ODBCConnection& connection) {
+	const std::string sql = "SELECT a, c, s16 FROM bench_numeric, bench_string WHERE bench_numeric.id = ? AND bench_string.id = bench_numeric.id";
+	std::size_t rows = benchmark.getRows();
+
+	benchmark.run("single_row_execute", [&]() {
+		std::unique_ptr<esl::database::ODBCPreparedStatement> statement = connection.prepareODBC(sql);
+		std::vector<esl::database::Field> fields(1);
+		std::vector<esl::database::Field> row(3);
+		for(std::size_t i = 0; i < singleRowExecutions; ++i) {
+			fields[0] = static_cast<std::int64_t>(i % rows);
+			std::unique_ptr<esl::database::ODBCResultSet> resultSet = statement->executeODBC(fields);
+			resultSet->fetch(row);
+		}
+		return static_cast<std::uint64_t>(singleRowExecutions);
+	});
+
+	benchmark.run("single_row_query_one", [&]() {
+		std::unique_ptr<esl::database::ODBCPreparedStatement> statement = connection.prepareODBC(sql);
+		std::vector<esl::database::Field> fields(1);
+		std::vector<esl::database::Field> row(3);
+		for(std::size_t i = 0; i < singleRowExecutions; ++i) {
+			fields[0] = static_cast<std::int64_t>(i % rows);
+			statement->queryOne(fields, row);
+		}
+		return static_cast<std::uint64_t>(singleRowExecutions);
+	});
+
+	benchmark.run("single_row_prepare_execute", [&]() {
+		std::vector<esl::database::Field> fields(1);
+		std::vector<esl::database::Field> row(3);
+		for(std::size_t i = 0; i < singleRowExecutions; ++i) {
+			std::unique_ptr<esl::database::ODBCPreparedStatement> statement = connection.prepareODBC(sql);
+			fields[0] = static_cast<std::int64_t>(i % rows);
+			std::unique_ptr<esl::database::ODBCResultSet> resultSet = statement->executeODBC(fields);
+			resultSet->fetch(row);
+		}
+		return static_cast<std::uint64_t>(singleRowExecutions);
+	});
+}
+}
+
+void DatabaseSuite::run(Benchmark& benchmark, esl::database::ODBCConnection& connection) {
+	connection.executeDirect("CREATE TABLE bench_numeric (id INTEGER PRIMARY KEY, a INTEGER, b INTEGER, c DOUBLE, d DOUBLE)");
+	connection.executeDirect("CREATE TABLE bench_string (id INTEGER PRIMARY KEY, s16 VARCHAR(16), s64 VARCHAR(64), s256 VARCHAR(256), s4096 VARCHAR(4096))");
+	connection.commit();
+
+	insertRows(benchmark, connection);
+	runSingleRow(benchmark, connection);
+
+	/* fetch throughput by column type and width */
+	runFetch(benchmark, connection, "fetch_integer", "SELECT a FROM bench_numeric");
+	runFetch(benchmark, connection, "fetch_double", "SELECT c FROM bench_numeric");
+	runFetch(benchmark, connection, "fetch_varchar16", "SELECT s16 FROM bench_string");
+	runFetch(benchmark, connection, "fetch_varchar64", "SELECT s64 FROM bench_string");
+	runFetch(benchmark, connection, "fetch_varchar256", "SELECT s256 FROM bench_string");
+	runFetch(benchmark, connection, "fetch_varchar4096", "SELECT s4096 FROM bench_string");
+
+	/* same number of columns, but numeric versus string values */
+	runFetch(benchmark, connection, "fetch_numeric_heavy", "SELECT a, b, c, d FROM bench_numeric");
+	runFetch(benchmark, connection, "fetch_string_heavy", "SELECT s16, s64, s256, s4096 FROM bench_string");
+
+	connection.executeDirect("DROP TABLE bench_string");
+	connection.executeDirect("DROP TABLE bench_numeric");
+	connection.commit();
+}
+
+void DatabaseSuite::runFetch(Benchmark& benchmark, esl::database::ODBCConnection& connection, const std::string& name, const std::string& sql) {
+	std::unique_ptr<esl::database::ODBCPreparedStatement> statement = connection.prepareODBC(sql);
+
+	/* first execution binds the result columns and grows buffers, so it is not measured */
+	std::unique_ptr<esl::database::ODBCResultSet> resultSet = statement->executeODBC(std::vector<esl::database::Field>());
+	std::vector<esl::database::Field> row(resultSet->getColumns().size());
+	while(resultSet->fetch(row)) {
+	}
+	resultSet.reset();
+
+	benchmark.run(name, [&]() {
+		std::uint64_t rows = 0;
+		for(std::size_t i = 0; i < fetchRepetitions; ++i) {
+			std::unique_ptr<esl::database::ODBCResultSet> resultSet = statement->executeODBC(std::vector<esl::database::Field>());
+			while(resultSet->fetch(row)) {
+				++rows;
+			}
+		}
+		return rows;
+	});
+}
+
+} /* namespace benchmark */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
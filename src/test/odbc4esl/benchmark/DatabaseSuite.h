@@ -0,0 +1,47 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ODBC4ESL_BENCHMARK_DATABASESUITE_H_
+#define ODBC4ESL_BENCHMARK_DATABASESUITE_H_
+
+#include <odbc4esl/benchmark/Benchmark.h>
+
+#include <esl/database/ODBCConnection.h>
+
+#include <string>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace benchmark {
+
+/* Cases against a real, file based database like SQLite ODBC. They create their own tables, so the database should be empty,
+ * e.g. "DRIVER=SQLite3;Database=:memory:". */
+class DatabaseSuite {
+public:
+	static void run(Benchmark& benchmark, esl::database::ODBCConnection& connection);
+
+	/* Executes sql repeatedly and fetches all rows by ODBCResultSet::fetch(). Operations are fetched rows,
+	 * so allocationsPerOperation are allocations per row. */
+	static void runFetch(Benchmark& benchmark, esl::database::ODBCConnection& connection, const std::string& name, const std::string& sql);
+};
+
+} /* namespace benchmark */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
+
+#endif /* ODBC4ESL_BENCHMARK_DATABASESUITE_H_ */
@@ -0,0 +1,130 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <odbc4esl/benchmark/MockSuite.h>
+#include <odbc4esl/benchmark/DatabaseSuite.h>
+
+#include <esl/database/Field.h>
+#include <esl/database/ODBCPreparedBulkStatement.h>
+#include <esl/database/ODBCPreparedStatement.h>
+#include <esl/database/ODBCResultSet.h>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace benchmark {
+
+namespace {
+std::string createString(std::size_t length, std::size_t row) {
+	std::string str = std::to_string(row);
+	str.resize(length, static_cast<char>('a' + row % 26));
+	return str;
+}
+
+/* operations are executions, so allocationsPerOperation are allocations per execution */
+void runExecute(Benchmark& benchmark, esl::database::ODBCConnection& connection, const std::string& name, const std::string& sql,
+		std::size_t fieldCount, const std::function<void(std::vector<esl::database::Field>&, std::size_t)>& setFields) {
+	std::unique_ptr<esl::database::ODBCPreparedStatement> statement = connection.prepareODBC(sql);
+	std::vector<esl::database::Field> fields(fieldCount);
+
+	/* first execution binds the parameters and grows buffers, so it is not measured */
+	setFields(fields, 0);
+	statement->executeODBC(fields);
+
+	benchmark.run(name, [&]() {
+		for(std::size_t row = 0; row < benchmark.getRows(); ++row) {
+			setFields(fields, row);
+			statement->executeODBC(fields);
+		}
+		return static_cast<std::uint64_t>(benchmark.getRows());
+	});
+}
+
+void runExecutes(Benchmark& benchmark, esl::database::ODBCConnection& connection) {
+	runExecute(benchmark, connection, "execute_bind_numeric", "update=1 params=bigint,bigint,double,double ? ? ? ?", 4,
+			[](std::vector<esl::database::Field>& fields, std::size_t row) {
+		fields[0] = static_cast<std::int64_t>(row);
+		fields[1] = static_cast<std::int64_t>(row * 7);
+		fields[2] = static_cast<double>(row) / 3.0;
+		fields[3] = static_cast<double>(row) * 1.5;
+	});
+
+	runExecute(benchmark, connection, "execute_bind_varchar", "update=1 params=varchar(64),varchar(4096) ? ?", 2,
+			[](std::vector<esl::database::Field>& fields, std::size_t row) {
+		fields[0] = createString(64, row);
+		fields[1] = createString(4096, row);
+	});
+
+	benchmark.run("execute_bulk_numeric", [&]() {
+		std::unique_ptr<esl::database::ODBCPreparedBulkStatement> statement = connection.prepareBulkODBC("update=1 params=bigint,double ? ?");
+		std::vector<esl::database::Field> fields(2);
+		for(std::size_t row = 0; row < benchmark.getRows(); ++row) {
+			fields[0] = static_cast<std::int64_t>(row);
+			fields[1] = static_cast<double>(row) * 1.5;
+			statement->execute(fields);
+		}
+		return static_cast<std::uint64_t>(benchmark.getRows());
+	});
+}
+
+/* fetches by ODBCResultSet::fetchRow() and the typed getters instead of Fields */
+void runFetchRow(Benchmark& benchmark, esl::database::ODBCConnection& connection, const std::string& name, const std::string& sql) {
+	std::unique_ptr<esl::database::ODBCPreparedStatement> statement = connection.prepareODBC(sql);
+	std::int64_t integer = 0;
+	double real = 0.0;
+	std::string str;
+
+	benchmark.run(name, [&]() {
+		std::unique_ptr<esl::database::ODBCResultSet> resultSet = statement->executeODBC(std::vector<esl::database::Field>());
+		std::uint64_t rows = 0;
+		while(resultSet->fetchRow()) {
+			resultSet->getInteger(0, integer);
+			resultSet->getDouble(1, real);
+			resultSet->getString(2, str);
+			++rows;
+		}
+		return rows;
+	});
+}
+}
+
+void MockSuite::run(Benchmark& benchmark, esl::database::ODBCConnection& connection) {
+	const std::string rows = "rows=" + std::to_string(benchmark.getRows());
+
+	runExecutes(benchmark, connection);
+
+	/* bound columns, decoded into Fields */
+	DatabaseSuite::runFetch(benchmark, connection, "fetch_bound_numeric", rows + " columns=bigint,integer,double,double");
+	DatabaseSuite::runFetch(benchmark, connection, "fetch_bound_varchar16", rows + " columns=varchar(16)*16");
+	DatabaseSuite::runFetch(benchmark, connection, "fetch_bound_varchar256", rows + " columns=varchar(256)*256");
+	DatabaseSuite::runFetch(benchmark, connection, "fetch_bound_nulls", rows + " nulls columns=bigint,varchar(16)*16");
+
+	/* columns larger than maximum-buffer-size are read by SQLGetData */
+	DatabaseSuite::runFetch(benchmark, connection, "fetch_getdata_longvarchar", rows + " columns=longvarchar*4096");
+
+	runFetchRow(benchmark, connection, "fetch_row_typed", rows + " columns=bigint,double,varchar(16)*16");
+}
+
+} /* namespace benchmark */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
@@ -0,0 +1,152 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <odbc4esl/benchmark/Benchmark.h>
+#include <odbc4esl/benchmark/DatabaseSuite.h>
+#include <odbc4esl/benchmark/MockSuite.h>
+
+#include <esl/database/ODBCConnection.h>
+#include <esl/database/ODBCConnectionFactory.h>
+#include <esl/database/ODBCMetrics.h>
+
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+/* exit code to report a skipped test to CTest if there is no driver to run the suite against */
+constexpr int exitSkipped = 77;
+
+void printUsage(const char* program) {
+	std::cerr << "Usage: " << program << " [--suite sqlite|mock] [--connection-string <string>] [--rows <n>] [--metrics] [--output <file>]\n";
+	std::cerr << "\n";
+	std::cerr << "  --suite              suite to run (default: sqlite)\n";
+	std::cerr << "  --connection-string  ODBC connection string, default is $ODBC4ESL_BENCHMARK_CONNECTION_STRING\n";
+	std::cerr << "                       or \"DRIVER=SQLite3;Database=:memory:\" for suite sqlite\n";
+	std::cerr << "                       or the mock driver of the build for suite mock\n";
+	std::cerr << "  --rows               number of rows per case (default: 10000)\n";
+	std::cerr << "  --metrics            enable ODBCMetrics and add its JSON document to the output\n";
+	std::cerr << "  --output             file to write the JSON results to (default: stdout)\n";
+}
+}
+
+int main(int argc, const char* argv[]) {
+	std::string suite = "sqlite";
+	std::string connectionString;
+	std::string output;
+	std::size_t rows = 10000;
+	bool metrics = false;
+
+	if(std::getenv("ODBC4ESL_BENCHMARK_CONNECTION_STRING")) {
+		connectionString = std::getenv("ODBC4ESL_BENCHMARK_CONNECTION_STRING");
+	}
+
+	for(int i = 1; i < argc; ++i) {
+		std::string argument = argv[i];
+		if(argument == "--metrics") {
+			metrics = true;
+		}
+		else if(i+1 < argc && argument == "--suite") {
+			suite = argv[++i];
+		}
+		else if(i+1 < argc && argument == "--connection-string") {
+			connectionString = argv[++i];
+		}
+		else if(i+1 < argc && argument == "--rows") {
+			rows = std::stoul(argv[++i]);
+		}
+		else if(i+1 < argc && argument == "--output") {
+			output = argv[++i];
+		}
+		else {
+			printUsage(argv[0]);
+			return argument == "--help" ? EXIT_SUCCESS : EXIT_FAILURE;
+		}
+	}
+
+	if(suite != "sqlite" && suite != "mock") {
+		std::cerr << "Unknown suite \"" << suite << "\"\n";
+		printUsage(argv[0]);
+		return EXIT_FAILURE;
+	}
+	if(connectionString.empty() && suite == "sqlite") {
+		connectionString = "DRIVER=SQLite3;Database=:memory:";
+	}
+#ifdef ODBC4ESL_MOCK_DRIVER
+	if(connectionString.empty() && suite == "mock") {
+		connectionString = "DRIVER=" ODBC4ESL_MOCK_DRIVER;
+	}
+#endif
+	if(connectionString.empty()) {
+		std::cerr << "Suite \"" << suite << "\" skipped, there is no mock driver for this platform\n";
+		return exitSkipped;
+	}
+
+	std::vector<std::pair<std::string, std::string>> settings;
+	settings.emplace_back("connection-string", connectionString);
+	settings.emplace_back("metrics", metrics ? "true" : "false");
+
+	std::unique_ptr<esl::database::ODBCConnectionFactory> connectionFactory;
+	std::unique_ptr<esl::database::ODBCConnection> connection;
+	try {
+		connectionFactory.reset(new esl::database::ODBCConnectionFactory(esl::database::ODBCConnectionFactory::Settings(settings)));
+		connection = connectionFactory->createODBCConnection();
+	}
+	catch(const std::exception& e) {
+		std::cerr << "Suite \"" << suite << "\" skipped, cannot connect by \"" << connectionString << "\": " << e.what() << "\n";
+		return exitSkipped;
+	}
+	if(!connection) {
+		std::cerr << "Suite \"" << suite << "\" skipped, cannot connect by \"" << connectionString << "\"\n";
+		return exitSkipped;
+	}
+
+	odbc4esl::benchmark::Benchmark benchmark(suite, rows);
+	try {
+		if(suite == "mock") {
+			odbc4esl::benchmark::MockSuite::run(benchmark, *connection);
+		}
+		else {
+			odbc4esl::benchmark::DatabaseSuite::run(benchmark, *connection);
+		}
+	}
+	catch(const std::exception& e) {
+		std::cerr << "Suite \"" << suite << "\" failed: " << e.what() << "\n";
+		return EXIT_FAILURE;
+	}
+
+	std::string metricsJSON = metrics ? esl::database::ODBCMetrics::getJSON() : std::string();
+	if(output.empty()) {
+		benchmark.writeJSON(std::cout, metricsJSON);
+	}
+	else {
+		std::ofstream stream(output);
+		benchmark.writeJSON(stream, metricsJSON);
+		if(!stream) {
+			std::cerr << "Cannot write results to \"" << output << "\"\n";
+			return EXIT_FAILURE;
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,154 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Upper bounds of allocations per fetched row and per execution. A bound may only be lowered: if a change makes
+ * a path allocate more, the test fails instead of the regression being found in production profiles. */
+
+#include <odbc4esl/test/AllocationCounter.h>
+#include <odbc4esl/test/MockDatabaseTest.h>
+
+#include <esl/database/Field.h>
+#include <esl/database/ODBCConnection.h>
+#include <esl/database/ODBCPreparedBulkStatement.h>
+#include <esl/database/ODBCPreparedStatement.h>
+#include <esl/database/ODBCResultSet.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+namespace {
+constexpr std::size_t rows = 1000;
+constexpr std::size_t executions = 100;
+
+/* allocations of ODBCResultSet::fetch() per row, measured at the second execution after all buffers have grown */
+double getAllocationsPerRow(esl::database::ODBCConnection& connection, const std::string& sql) {
+	std::unique_ptr<esl::database::ODBCPreparedStatement> statement = connection.prepareODBC(sql);
+	std::unique_ptr<esl::database::ODBCResultSet> resultSet = statement->executeODBC(std::vector<esl::database::Field>());
+	std::vector<esl::database::Field> row(resultSet->getColumns().size());
+	while(resultSet->fetch(row)) {
+	}
+
+	resultSet = statement->executeODBC(std::vector<esl::database::Field>());
+	std::size_t fetchedRows = 0;
+	test::AllocationCounter allocationCounter;
+	while(resultSet->fetch(row)) {
+		++fetchedRows;
+	}
+	std::uint64_t allocations = allocationCounter.getAllocations();
+
+	EXPECT_EQ(rows, fetchedRows);
+	return static_cast<double>(allocations) / static_cast<double>(fetchedRows);
+}
+
+/* allocations of ODBCPreparedStatement::executeODBC() per execution including the destruction of its result set */
+double getAllocationsPerExecution(esl::database::ODBCConnection& connection, const std::string& sql, const std::vector<esl::database::Field>& fields) {
+	std::unique_ptr<esl::database::ODBCPreparedStatement> statement = connection.prepareODBC(sql);
+	statement->executeODBC(fields);
+
+	test::AllocationCounter allocationCounter;
+	for(std::size_t i = 0; i < executions; ++i) {
+		statement->executeODBC(fields);
+	}
+	return static_cast<double>(allocationCounter.getAllocations()) / static_cast<double>(executions);
+}
+
+class AllocationTest : public test::MockDatabaseTest {
+};
+}
+
+/* Values up to 15 characters fit into the small string buffer of esl::database::Field, longer values are one allocation.
+ * The fraction above the bound per value is a constant per result set, e.g. for the last fetch. */
+TEST_F(AllocationTest, fetchPerColumnType) {
+	const std::string rowSpec = "rows=" + std::to_string(rows);
+
+	EXPECT_LE(getAllocationsPerRow(*connection, rowSpec + " columns=bigint,bigint"), 0.01);
+	EXPECT_LE(getAllocationsPerRow(*connection, rowSpec + " columns=integer,smallint"), 0.01);
+	EXPECT_LE(getAllocationsPerRow(*connection, rowSpec + " columns=double,double"), 0.01);
+	EXPECT_LE(getAllocationsPerRow(*connection, rowSpec + " columns=varchar(8)*8"), 0.01);
+	EXPECT_LE(getAllocationsPerRow(*connection, rowSpec + " columns=varchar(256)*256"), 1.01);
+	EXPECT_LE(getAllocationsPerRow(*connection, rowSpec + " columns=varchar(64)*64,varchar(256)*256"), 2.01);
+
+	/* values larger than the bound buffer are read by SQLGetData */
+	EXPECT_LE(getAllocationsPerRow(*connection, rowSpec + " columns=longvarchar*4096"), 1.01);
+
+	/* every second row is NULL */
+	EXPECT_LE(getAllocationsPerRow(*connection, rowSpec + " nulls columns=bigint,double,varchar(64)*64"), 0.51);
+}
+
+TEST_F(AllocationTest, executePerParameterType) {
+	std::vector<esl::database::Field> numeric(2);
+	numeric[0] = static_cast<std::int64_t>(42);
+	numeric[1] = 4.2;
+	EXPECT_LE(getAllocationsPerExecution(*connection, "update=1 params=bigint,double ? ?", numeric), 0.0);
+
+	std::vector<esl::database::Field> strings(2);
+	strings[0] = std::string(8, 'x');
+	strings[1] = std::string(4096, 'x');
+	EXPECT_LE(getAllocationsPerExecution(*connection, "update=1 params=varchar(8),longvarchar ? ?", strings), 1.0);
+
+	/* result set with its column bindings */
+	std::vector<esl::database::Field> key(1);
+	key[0] = static_cast<std::int64_t>(42);
+	EXPECT_LE(getAllocationsPerExecution(*connection, "rows=1 columns=bigint,varchar(64)*64 params=bigint ?", key), 17.0);
+}
+
+TEST_F(AllocationTest, bulkExecute) {
+	std::unique_ptr<esl::database::ODBCPreparedBulkStatement> statement = connection->prepareBulkODBC("update=1 params=bigint,double ? ?");
+	std::vector<esl::database::Field> fields(2);
+	fields[0] = static_cast<std::int64_t>(42);
+	fields[1] = 4.2;
+	statement->execute(fields);
+
+	test::AllocationCounter allocationCounter;
+	for(std::size_t i = 0; i < executions; ++i) {
+		fields[0] = static_cast<std::int64_t>(i);
+		statement->execute(fields);
+	}
+	EXPECT_EQ(0u, allocationCounter.getAllocations());
+}
+
+/* queryOne and queryScalar keep the result columns bound to the statement, so no result set is created per call */
+TEST_F(AllocationTest, queryRow) {
+	std::unique_ptr<esl::database::ODBCPreparedStatement> statement = connection->prepareODBC("rows=1 columns=bigint,double params=bigint ?");
+	std::vector<esl::database::Field> key(1);
+	key[0] = static_cast<std::int64_t>(42);
+	std::vector<esl::database::Field> row(2);
+	std::int64_t value = 0;
+	statement->queryOne(key, row);
+	statement->queryScalar(key, value);
+
+	test::AllocationCounter allocationCounter;
+	for(std::size_t i = 0; i < executions; ++i) {
+		key[0] = static_cast<std::int64_t>(i);
+		EXPECT_TRUE(statement->queryOne(key, row));
+		EXPECT_TRUE(statement->queryScalar(key, value));
+	}
+	EXPECT_EQ(0u, allocationCounter.getAllocations());
+}
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
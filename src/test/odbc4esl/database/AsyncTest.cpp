@@ -0,0 +1,151 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <esl/database/ODBCAsync.h>
+
+/* The coroutine API is compiled only with the CMake option ODBC4ESL_COROUTINES */
+#if defined(ODBC4ESL_COROUTINES) && __cplusplus >= 202002L && __has_include(<coroutine>)
+
+#include <odbc4esl/test/MockDatabaseTest.h>
+
+#include <esl/database/Field.h>
+#include <esl/database/ODBCExecutor.h>
+#include <esl/database/ODBCPreparedStatement.h>
+#include <esl/database/ODBCResultSet.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+namespace {
+/* coroutine that starts immediately and is not awaited by anybody */
+struct Task {
+	struct promise_type {
+		Task get_return_object() noexcept {
+			return Task();
+		}
+		std::suspend_never initial_suspend() noexcept {
+			return std::suspend_never();
+		}
+		std::suspend_never final_suspend() noexcept {
+			return std::suspend_never();
+		}
+		void return_void() noexcept {
+		}
+		void unhandled_exception() noexcept {
+			std::terminate();
+		}
+	};
+};
+
+class AsyncTest : public test::MockDatabaseTest {
+protected:
+	void SetUp() override {
+		MockDatabaseTest::SetUp();
+		if(IsSkipped()) {
+			return;
+		}
+		esl::database::ODBCExecutor::Settings settings;
+		settings.workerCount = 2;
+		executor = esl::database::ODBCExecutor::create(database->getConnectionFactory(), settings);
+	}
+
+	/* runs the completions on this thread like an event loop until done is set */
+	void runUntil(const bool& done) {
+		const std::chrono::steady_clock::time_point timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+		while(!done && std::chrono::steady_clock::now() < timeout) {
+			if(executor->runCompletions() == 0) {
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+		}
+	}
+
+	std::unique_ptr<esl::database::ODBCExecutor> executor;
+};
+
+Task queryRows(esl::database::ODBCExecutor& executor, std::vector<std::vector<esl::database::Field>>& rows, std::vector<std::thread::id>& resumedThreads, bool& done) {
+	std::unique_ptr<esl::database::ODBCPreparedStatement> statement = co_await esl::database::prepareAsync(executor, 1, "rows=3 columns=integer");
+	resumedThreads.push_back(std::this_thread::get_id());
+
+	std::unique_ptr<esl::database::ODBCResultSet> resultSet = co_await esl::database::executeAsync(executor, 1, *statement, std::vector<esl::database::Field>());
+	resumedThreads.push_back(std::this_thread::get_id());
+
+	co_await esl::database::fetchBatchAsync(executor, 1, *resultSet, rows, 10);
+	resumedThreads.push_back(std::this_thread::get_id());
+
+	done = true;
+}
+
+Task queryError(esl::database::ODBCExecutor& executor, bool& failed, bool& done) {
+	std::unique_ptr<esl::database::ODBCPreparedStatement> statement = co_await esl::database::prepareAsync(executor, 1, "error=HY000");
+	try {
+		co_await esl::database::executeAsync(executor, 1, *statement, std::vector<esl::database::Field>());
+	}
+	catch(const std::exception&) {
+		failed = true;
+	}
+	done = true;
+}
+}
+
+TEST_F(AsyncTest, coroutineIsResumedByCompletions) {
+	std::vector<std::vector<esl::database::Field>> rows;
+	std::vector<std::thread::id> resumedThreads;
+	bool done = false;
+
+	queryRows(*executor, rows, resumedThreads, done);
+	EXPECT_FALSE(done);
+	runUntil(done);
+
+	ASSERT_TRUE(done);
+	ASSERT_EQ(3u, rows.size());
+	for(std::size_t i = 0; i < rows.size(); ++i) {
+		EXPECT_EQ(static_cast<int>(i), rows[i][0].asInteger());
+	}
+	ASSERT_EQ(3u, resumedThreads.size());
+	for(const auto& resumedThread : resumedThreads) {
+		EXPECT_EQ(std::this_thread::get_id(), resumedThread);
+	}
+}
+
+TEST_F(AsyncTest, exceptionIsThrownByCoAwait) {
+	bool failed = false;
+	bool done = false;
+
+	queryError(*executor, failed, done);
+	runUntil(done);
+
+	ASSERT_TRUE(done);
+	EXPECT_TRUE(failed);
+}
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
+
+#endif /* ODBC4ESL_COROUTINES */
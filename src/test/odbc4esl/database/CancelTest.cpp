@@ -0,0 +1,130 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <odbc4esl/test/MockDatabaseTest.h>
+
+#include <esl/database/Field.h>
+#include <esl/database/ODBCCallCounters.h>
+#include <esl/database/ODBCConnection.h>
+#include <esl/database/ODBCDeadline.h>
+#include <esl/database/ODBCPreparedStatement.h>
+#include <esl/database/ODBCResultSet.h>
+#include <esl/database/ODBCStatus.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+namespace {
+class CancelTest : public test::MockDatabaseTest {
+protected:
+	CancelTest()
+	: MockDatabaseTest(test::MockDatabase::Settings{{"call-counters", "true"}})
+	{ }
+};
+}
+
+TEST_F(CancelTest, cancelRunningExecution) {
+	std::unique_ptr<esl::database::ODBCPreparedStatement> statement = connection->prepareODBC("sleep=500 update=1");
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	std::thread canceller([&statement] {
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		statement->cancel();
+	});
+	esl::database::ODBCStatus status = statement->tryExecute(std::vector<esl::database::Field>(), true);
+	canceller.join();
+
+	EXPECT_FALSE(status.success);
+	EXPECT_TRUE(status.hasState("HY008")) << status.state;
+	EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(500));
+
+	/* the cancel does not affect the next execution */
+	EXPECT_TRUE(statement->tryExecute(std::vector<esl::database::Field>()).success);
+}
+
+TEST_F(CancelTest, queryTimeout) {
+	std::unique_ptr<esl::database::ODBCPreparedStatement> statement = connection->prepareODBC("sleep=2000 update=1");
+	statement->setQueryTimeout(std::chrono::seconds(1));
+
+	esl::database::ODBCStatus status = statement->tryExecute(std::vector<esl::database::Field>(), true);
+	EXPECT_FALSE(status.success);
+	EXPECT_TRUE(status.hasState("HYT00")) << status.state;
+}
+
+TEST_F(CancelTest, cancelFetch) {
+	std::unique_ptr<esl::database::ODBCPreparedStatement> statement = connection->prepareODBC("rows=10 columns=bigint");
+	std::unique_ptr<esl::database::ODBCResultSet> resultSet = statement->executeODBC(std::vector<esl::database::Field>());
+	ASSERT_TRUE(resultSet != nullptr);
+
+	std::vector<esl::database::Field> row(1);
+	ASSERT_TRUE(resultSet->fetch(row));
+	resultSet->cancel();
+	EXPECT_ANY_THROW(resultSet->fetch(row));
+}
+
+TEST_F(CancelTest, expiredDeadline) {
+	std::unique_ptr<esl::database::ODBCPreparedStatement> statement = connection->prepareODBC("update=1");
+
+	esl::database::ODBCCallCounters::resetThreadCounters();
+	{
+		esl::database::ODBCDeadline deadline(std::chrono::steady_clock::now() - std::chrono::milliseconds(1));
+		EXPECT_ANY_THROW(statement->executeODBC(std::vector<esl::database::Field>()));
+	}
+	EXPECT_EQ(0u, esl::database::ODBCCallCounters::getThreadCounters()[esl::database::ODBCCallCounters::Function::execute].calls);
+
+	/* without the deadline the statement is executed again */
+	EXPECT_TRUE(statement->tryExecute(std::vector<esl::database::Field>()).success);
+}
+
+TEST_F(CancelTest, nestedDeadline) {
+	std::chrono::steady_clock::time_point deadline;
+	EXPECT_FALSE(esl::database::ODBCDeadline::get(deadline));
+
+	std::chrono::steady_clock::time_point outerDeadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+	esl::database::ODBCDeadline outer(outerDeadline);
+	{
+		esl::database::ODBCDeadline inner(std::chrono::milliseconds(3600000));
+		ASSERT_TRUE(esl::database::ODBCDeadline::get(deadline));
+		EXPECT_TRUE(deadline == outerDeadline);
+
+		/* the remaining time of the outer deadline is the query timeout */
+		std::unique_ptr<esl::database::ODBCPreparedStatement> statement = connection->prepareODBC("sleep=2000 update=1");
+		esl::database::ODBCStatus status = statement->tryExecute(std::vector<esl::database::Field>(), true);
+		EXPECT_TRUE(status.hasState("HYT00")) << status.state;
+	}
+	{
+		std::chrono::steady_clock::time_point innerDeadline = outerDeadline - std::chrono::milliseconds(1);
+		esl::database::ODBCDeadline inner(innerDeadline);
+		ASSERT_TRUE(esl::database::ODBCDeadline::get(deadline));
+		EXPECT_TRUE(deadline == innerDeadline);
+	}
+	ASSERT_TRUE(esl::database::ODBCDeadline::get(deadline));
+	EXPECT_TRUE(deadline == outerDeadline);
+}
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
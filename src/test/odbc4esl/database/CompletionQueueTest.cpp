@@ -0,0 +1,90 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <odbc4esl/database/CompletionQueue.h>
+
+#include <gtest/gtest.h>
+
+#include <exception>
+#include <stdexcept>
+#include <vector>
+
+#include <poll.h>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+namespace {
+bool isReadable(int fd) {
+	pollfd pollFd;
+	pollFd.fd = fd;
+	pollFd.events = POLLIN;
+	pollFd.revents = 0;
+	return poll(&pollFd, 1, 0) == 1 && (pollFd.revents & POLLIN);
+}
+}
+
+TEST(CompletionQueueTest, fdIsReadableWhileCompletionsArePending) {
+	CompletionQueue completionQueue;
+	EXPECT_FALSE(isReadable(completionQueue.getFd()));
+
+	std::vector<int> completed;
+	completionQueue.push([&completed](std::exception_ptr) { completed.push_back(1); }, nullptr);
+	completionQueue.push([&completed](std::exception_ptr) { completed.push_back(2); }, nullptr);
+	EXPECT_TRUE(isReadable(completionQueue.getFd()));
+	EXPECT_TRUE(completed.empty());
+
+	EXPECT_EQ(2u, completionQueue.run());
+	EXPECT_EQ((std::vector<int>{1, 2}), completed);
+	EXPECT_FALSE(isReadable(completionQueue.getFd()));
+
+	EXPECT_EQ(0u, completionQueue.run());
+}
+
+TEST(CompletionQueueTest, completionGetsException) {
+	CompletionQueue completionQueue;
+
+	std::exception_ptr exception;
+	completionQueue.push([&exception](std::exception_ptr aException) { exception = aException; }, std::make_exception_ptr(std::runtime_error("job failed")));
+	EXPECT_EQ(1u, completionQueue.run());
+
+	ASSERT_TRUE(exception != nullptr);
+	EXPECT_THROW(std::rethrow_exception(exception), std::runtime_error);
+}
+
+TEST(CompletionQueueTest, remainingCompletionsStayPendingIfCompletionThrows) {
+	CompletionQueue completionQueue;
+
+	std::vector<int> completed;
+	completionQueue.push([&completed](std::exception_ptr) { completed.push_back(1); }, nullptr);
+	completionQueue.push([](std::exception_ptr) { throw std::runtime_error("completion failed"); }, nullptr);
+	completionQueue.push([&completed](std::exception_ptr) { completed.push_back(3); }, nullptr);
+
+	EXPECT_THROW(completionQueue.run(), std::runtime_error);
+	EXPECT_EQ((std::vector<int>{1}), completed);
+	EXPECT_TRUE(isReadable(completionQueue.getFd()));
+
+	EXPECT_EQ(1u, completionQueue.run());
+	EXPECT_EQ((std::vector<int>{1, 3}), completed);
+	EXPECT_FALSE(isReadable(completionQueue.getFd()));
+}
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
@@ -0,0 +1,58 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <odbc4esl/test/MockDatabaseTest.h>
+
+#include <esl/database/ODBCCallCounters.h>
+#include <esl/database/ODBCConnectionFactory.h>
+#include <esl/database/ODBCMetrics.h>
+
+#include <gtest/gtest.h>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+namespace {
+class ConnectionFactoryTest : public test::MockDatabaseTest {
+};
+}
+
+TEST_F(ConnectionFactoryTest, factoryWithoutMetricsKeepsMetricsSetting) {
+	test::MockDatabase settingsDatabase(test::MockDatabase::Settings{{"metrics", "true"}});
+	esl::database::ODBCConnectionFactory connectionFactory(esl::database::ODBCConnectionFactory::Settings({
+		{"connection-string", test::MockDatabase::getConnectionString()}
+	}));
+
+	EXPECT_TRUE(esl::database::ODBCMetrics::isEnabled());
+	esl::database::ODBCMetrics::setEnabled(false);
+}
+
+TEST_F(ConnectionFactoryTest, factoryWithoutCallCountersKeepsCallCountersEnabled) {
+	test::MockDatabase settingsDatabase(test::MockDatabase::Settings{{"call-counters", "true"}});
+	esl::database::ODBCConnectionFactory connectionFactory(esl::database::ODBCConnectionFactory::Settings({
+		{"connection-string", test::MockDatabase::getConnectionString()}
+	}));
+
+	EXPECT_TRUE(esl::database::ODBCCallCounters::isEnabled());
+	esl::database::ODBCCallCounters::setEnabled(false);
+}
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
@@ -0,0 +1,70 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <odbc4esl/test/MockDatabaseTest.h>
+
+#include <esl/database/Field.h>
+#include <esl/database/ODBCCallCounters.h>
+#include <esl/database/ODBCConnection.h>
+#include <esl/database/ODBCPreparedStatement.h>
+#include <esl/database/ODBCResultSet.h>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+namespace {
+class ConnectionTest : public test::MockDatabaseTest {
+protected:
+	ConnectionTest()
+	: MockDatabaseTest(test::MockDatabase::Settings{{"call-counters", "true"}})
+	{ }
+};
+}
+
+TEST_F(ConnectionTest, statementHandlesArePooled) {
+	std::vector<esl::database::Field> row(1);
+	connection->prepareODBC("rows=1")->queryOne(std::vector<esl::database::Field>(), row);
+
+	esl::database::ODBCCallCounters::resetThreadCounters();
+	connection->prepareODBC("rows=1")->queryOne(std::vector<esl::database::Field>(), row);
+	EXPECT_EQ(0u, esl::database::ODBCCallCounters::getThreadCounters()[esl::database::ODBCCallCounters::Function::allocHandle].calls);
+}
+
+/* The statement handles give themselves back to the pool of the connection when they are destroyed.
+ * This must not touch the connection if it has been destroyed before. */
+TEST_F(ConnectionTest, statementOutlivesConnection) {
+	std::unique_ptr<esl::database::ODBCPreparedStatement> statement = connection->prepareODBC("rows=2");
+	std::unique_ptr<esl::database::ODBCResultSet> resultSet = statement->executeODBC(std::vector<esl::database::Field>());
+	std::vector<esl::database::Field> row(1);
+	ASSERT_TRUE(resultSet->fetch(row));
+
+	connection.reset();
+
+	resultSet.reset();
+	statement.reset();
+}
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
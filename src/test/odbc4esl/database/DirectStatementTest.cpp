@@ -0,0 +1,77 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <odbc4esl/test/MockDatabaseTest.h>
+
+#include <esl/database/Field.h>
+#include <esl/database/ODBCConnection.h>
+#include <esl/database/ODBCResultSet.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+namespace {
+class DirectStatementTest : public test::MockDatabaseTest {
+};
+}
+
+TEST_F(DirectStatementTest, executeWithParameters) {
+	std::vector<esl::database::Field> parameterValues;
+	parameterValues.emplace_back(std::int64_t(7));
+	parameterValues.emplace_back(std::string("abc"));
+
+	std::unique_ptr<esl::database::ODBCResultSet> resultSet = connection->executeDirect("echo columns=varchar(16) WHERE a = ? AND b = ?", parameterValues);
+	ASSERT_TRUE(resultSet != nullptr);
+
+	std::vector<esl::database::Field> row(1);
+	std::size_t rows = 0;
+	while(resultSet->fetch(row)) {
+		EXPECT_TRUE(row[0].asString() == "7" || row[0].asString() == "abc");
+		++rows;
+	}
+	EXPECT_EQ(2u, rows);
+}
+
+/* parameter buffers are freed when executeDirect returns, the result set must not keep them bound */
+TEST_F(DirectStatementTest, resultSetHasNoBoundParameters) {
+	std::vector<esl::database::Field> parameterValues;
+	parameterValues.emplace_back(std::int64_t(1));
+
+	std::unique_ptr<esl::database::ODBCResultSet> resultSet = connection->executeDirect("boundparams WHERE id = ?", parameterValues);
+	ASSERT_TRUE(resultSet != nullptr);
+
+	std::vector<esl::database::Field> row(1);
+	ASSERT_TRUE(resultSet->fetch(row));
+	EXPECT_EQ(0, row[0].asInteger());
+}
+
+TEST_F(DirectStatementTest, executeWithoutResultSet) {
+	EXPECT_TRUE(connection->executeDirect("update=1") == nullptr);
+}
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
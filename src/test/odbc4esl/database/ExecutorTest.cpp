@@ -0,0 +1,172 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <odbc4esl/test/MockDatabaseTest.h>
+
+#include <esl/database/ODBCConnection.h>
+#include <esl/database/ODBCExecutor.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <poll.h>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+namespace {
+class ExecutorTest : public test::MockDatabaseTest {
+protected:
+	void SetUp() override {
+		MockDatabaseTest::SetUp();
+		if(IsSkipped()) {
+			return;
+		}
+		esl::database::ODBCExecutor::Settings settings;
+		settings.workerCount = 2;
+		executor = esl::database::ODBCExecutor::create(database->getConnectionFactory(), settings);
+	}
+
+	/* waits for the completion file descriptor like an event loop and runs the completions until count have run */
+	void runCompletions(std::size_t count) {
+		const std::chrono::steady_clock::time_point timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+		while(count > 0 && std::chrono::steady_clock::now() < timeout) {
+			pollfd pollFd;
+			pollFd.fd = executor->getCompletionFd();
+			pollFd.events = POLLIN;
+			pollFd.revents = 0;
+			if(poll(&pollFd, 1, 100) == 1) {
+				std::size_t ranCount = executor->runCompletions();
+				count -= ranCount < count ? ranCount : count;
+			}
+		}
+		ASSERT_EQ(0u, count);
+	}
+
+	std::unique_ptr<esl::database::ODBCExecutor> executor;
+};
+}
+
+TEST_F(ExecutorTest, completionRunsOnCallingThread) {
+	std::thread::id jobThread;
+	std::thread::id completionThread;
+	std::exception_ptr exception = std::make_exception_ptr(std::runtime_error("not completed"));
+
+	executor->submit([&jobThread](esl::database::ODBCConnection& connection) {
+		jobThread = std::this_thread::get_id();
+		connection.executeDirect("update=1");
+	}, [&completionThread, &exception](std::exception_ptr aException) {
+		completionThread = std::this_thread::get_id();
+		exception = aException;
+	});
+	runCompletions(1);
+
+	EXPECT_TRUE(exception == nullptr);
+	EXPECT_NE(std::this_thread::get_id(), jobThread);
+	EXPECT_EQ(std::this_thread::get_id(), completionThread);
+}
+
+TEST_F(ExecutorTest, completionGetsExceptionOfJob) {
+	std::exception_ptr exception;
+
+	executor->submit([](esl::database::ODBCConnection& connection) {
+		connection.executeDirect("error=HY000");
+	}, [&exception](std::exception_ptr aException) {
+		exception = aException;
+	});
+	runCompletions(1);
+
+	EXPECT_TRUE(exception != nullptr);
+}
+
+TEST_F(ExecutorTest, jobsOfAffinityKeyRunInOrderOnSameConnection) {
+	std::vector<int> order;
+	std::vector<esl::database::ODBCConnection*> connections;
+
+	for(int i = 0; i < 5; ++i) {
+		/* the first job is slow, so the following jobs would overtake it on another worker */
+		executor->submit(7, [i, &order, &connections](esl::database::ODBCConnection& connection) {
+			connection.executeDirect(i == 0 ? "sleep=50 update=1" : "update=1");
+			order.push_back(i);
+			connections.push_back(&connection);
+		}, nullptr);
+	}
+	executor->submit(7, [](esl::database::ODBCConnection&) { }, [](std::exception_ptr) { });
+	runCompletions(1);
+
+	EXPECT_EQ((std::vector<int>{0, 1, 2, 3, 4}), order);
+	ASSERT_EQ(5u, connections.size());
+	for(auto connection : connections) {
+		EXPECT_EQ(connections.front(), connection);
+	}
+}
+
+TEST_F(ExecutorTest, idleWorkerStealsJobOfBusyWorker) {
+	std::atomic<esl::database::ODBCConnection*> slowConnection(nullptr);
+	std::atomic<esl::database::ODBCConnection*> stolenConnection(nullptr);
+	std::atomic<bool> slowJobDone(false);
+	std::atomic<bool> stolenBeforeSlowJobDone(false);
+
+	/* the first job without affinity is added to the same worker as the job of affinity key 0 */
+	executor->submit(0, [&slowConnection, &slowJobDone](esl::database::ODBCConnection& connection) {
+		slowConnection = &connection;
+		connection.executeDirect("sleep=300 update=1");
+		slowJobDone = true;
+	}, [](std::exception_ptr) { });
+	executor->submit([&stolenConnection, &slowJobDone, &stolenBeforeSlowJobDone](esl::database::ODBCConnection& connection) {
+		stolenConnection = &connection;
+		stolenBeforeSlowJobDone = !slowJobDone;
+	}, [](std::exception_ptr) { });
+	runCompletions(2);
+
+	EXPECT_TRUE(stolenBeforeSlowJobDone);
+	EXPECT_NE(slowConnection.load(), stolenConnection.load());
+}
+
+TEST_F(ExecutorTest, destructorRunsRemainingJobs) {
+	std::atomic<std::size_t> ranCount(0);
+
+	for(int i = 0; i < 10; ++i) {
+		executor->submit([&ranCount](esl::database::ODBCConnection& connection) {
+			connection.executeDirect("sleep=5 update=1");
+			++ranCount;
+		}, nullptr);
+	}
+	executor.reset();
+
+	EXPECT_EQ(10u, ranCount.load());
+}
+
+TEST_F(ExecutorTest, executorNeedsWorker) {
+	esl::database::ODBCExecutor::Settings settings;
+	settings.workerCount = 0;
+	EXPECT_THROW(esl::database::ODBCExecutor::create(database->getConnectionFactory(), settings), std::runtime_error);
+}
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
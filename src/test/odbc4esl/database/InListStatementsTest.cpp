@@ -0,0 +1,124 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <odbc4esl/test/MockDatabaseTest.h>
+
+#include <esl/database/Field.h>
+#include <esl/database/ODBCConnection.h>
+#include <esl/database/ODBCInListStatements.h>
+#include <esl/database/ODBCResultSet.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+namespace {
+class InListStatementsTest : public test::MockDatabaseTest {
+protected:
+	static std::vector<esl::database::Field> createValues(std::initializer_list<std::int64_t> values) {
+		std::vector<esl::database::Field> fields;
+		for(std::int64_t value : values) {
+			fields.emplace_back(value);
+		}
+		return fields;
+	}
+};
+}
+
+TEST_F(InListStatementsTest, bucketSizes) {
+	std::unique_ptr<esl::database::ODBCInListStatements> inListStatements = esl::database::ODBCInListStatements::create(*connection, "SELECT id FROM t WHERE id IN (?)", 100);
+	EXPECT_EQ(1u, inListStatements->getBucketSize(0));
+	EXPECT_EQ(1u, inListStatements->getBucketSize(1));
+	EXPECT_EQ(4u, inListStatements->getBucketSize(3));
+	EXPECT_EQ(64u, inListStatements->getBucketSize(33));
+	EXPECT_EQ(100u, inListStatements->getBucketSize(65));
+	EXPECT_ANY_THROW(inListStatements->getBucketSize(101));
+}
+
+/* the IN list is the parenthesized parameter after IN, not the first "(?)" of the statement */
+TEST_F(InListStatementsTest, parametersAroundInList) {
+	std::unique_ptr<esl::database::ODBCInListStatements> inListStatements = esl::database::ODBCInListStatements::create(*connection,
+			"SELECT id FROM t WHERE tenant = upper(?) AND name <> '(?) in (?)' AND LOGIN (?) AND id in ( ? ) AND kind = ?");
+
+	std::vector<esl::database::Field> fields;
+	inListStatements->createFields(createValues({100, 101, 200}), createValues({1, 2, 3}), fields);
+	ASSERT_EQ(7u, fields.size());
+	EXPECT_EQ(100, fields[0].asInteger());
+	EXPECT_EQ(101, fields[1].asInteger());
+	EXPECT_EQ(1, fields[2].asInteger());
+	EXPECT_EQ(3, fields[4].asInteger());
+	EXPECT_EQ(3, fields[5].asInteger());
+	EXPECT_EQ(200, fields[6].asInteger());
+}
+
+TEST_F(InListStatementsTest, paddingWithNull) {
+	std::unique_ptr<esl::database::ODBCInListStatements> inListStatements = esl::database::ODBCInListStatements::create(*connection, "SELECT id FROM t WHERE id IN (?)", 1024, esl::database::ODBCInListStatements::Padding::null);
+
+	std::vector<esl::database::Field> fields;
+	inListStatements->createFields(std::vector<esl::database::Field>(), createValues({1, 2, 3}), fields);
+	ASSERT_EQ(4u, fields.size());
+	EXPECT_EQ(3, fields[2].asInteger());
+	EXPECT_TRUE(fields[3].isNull());
+
+	/* an empty list matches no row */
+	inListStatements->createFields(std::vector<esl::database::Field>(), std::vector<esl::database::Field>(), fields);
+	ASSERT_EQ(1u, fields.size());
+	EXPECT_TRUE(fields[0].isNull());
+}
+
+TEST_F(InListStatementsTest, statementWithoutInList) {
+	EXPECT_ANY_THROW(esl::database::ODBCInListStatements::create(*connection, "SELECT id FROM t WHERE id = upper(?)"));
+	EXPECT_ANY_THROW(esl::database::ODBCInListStatements::create(*connection, "SELECT id FROM t WHERE name = 'IN (?)'"));
+	EXPECT_ANY_THROW(esl::database::ODBCInListStatements::create(*connection, "SELECT id FROM t WHERE id IN (?)", 0));
+}
+
+/* the mock driver returns one row per distinct parameter value, so every value of the list is bound */
+TEST_F(InListStatementsTest, executeBucketStatement) {
+	std::unique_ptr<esl::database::ODBCInListStatements> inListStatements = esl::database::ODBCInListStatements::create(*connection, "SELECT echo columns=varchar(16) FROM t WHERE id IN (?)");
+
+	for(std::size_t size = 1; size <= 9; ++size) {
+		std::vector<esl::database::Field> values;
+		std::set<std::string> expected;
+		for(std::size_t i = 0; i < size; ++i) {
+			values.emplace_back(static_cast<std::int64_t>(i));
+			expected.insert(std::to_string(i));
+		}
+
+		std::unique_ptr<esl::database::ODBCResultSet> resultSet = inListStatements->executeODBC(std::vector<esl::database::Field>(), values);
+		ASSERT_TRUE(resultSet != nullptr);
+		std::vector<esl::database::Field> row(1);
+		std::set<std::string> found;
+		while(resultSet->fetch(row)) {
+			found.insert(row[0].asString());
+		}
+		EXPECT_EQ(expected, found);
+	}
+}
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
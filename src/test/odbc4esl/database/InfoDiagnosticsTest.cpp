@@ -0,0 +1,151 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <odbc4esl/test/MockDatabaseTest.h>
+
+#include <esl/database/Field.h>
+#include <esl/database/ODBCConnection.h>
+#include <esl/database/ODBCInfoDiagnostics.h>
+#include <esl/database/ODBCPreparedStatement.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+namespace {
+class InfoDiagnosticsTest : public test::MockDatabaseTest {
+protected:
+	void SetUp() override {
+		MockDatabaseTest::SetUp();
+		if(IsSkipped()) {
+			return;
+		}
+		esl::database::ODBCInfoDiagnostics::resetCounters();
+	}
+
+	void TearDown() override {
+		esl::database::ODBCInfoDiagnostics::unmute("01004");
+		esl::database::ODBCInfoDiagnostics::setLogInterval(std::chrono::milliseconds(60000));
+		esl::database::ODBCInfoDiagnostics::resetCounters();
+	}
+
+	static void execute(esl::database::ODBCConnection& connection, std::size_t count) {
+		std::unique_ptr<esl::database::ODBCPreparedStatement> statement = connection.prepareODBC("update=1 info=01004");
+		for(std::size_t i = 0; i < count; ++i) {
+			statement->execute(std::vector<esl::database::Field>());
+		}
+	}
+
+	/* counter of SQLSTATE 01004 of the ODBC function, all counts are 0 if there is none */
+	static esl::database::ODBCInfoDiagnostics::Counter getCounter(const std::string& operation) {
+		esl::database::ODBCInfoDiagnostics::Counter result;
+		for(const auto& counter : esl::database::ODBCInfoDiagnostics::getCounters()) {
+			if(counter.operation == operation && counter.state == "01004") {
+				EXPECT_EQ(0u, result.count) << "counter of " << operation << " is listed twice";
+				result = counter;
+			}
+		}
+		return result;
+	}
+};
+}
+
+TEST_F(InfoDiagnosticsTest, countsPerFunctionAndState) {
+	execute(*connection, 5);
+	connection->executeDirect("update=1 info=01004");
+	connection->executeDirect("update=1 info=01004");
+
+	EXPECT_EQ(5u, getCounter("SQLExecute").count);
+	EXPECT_EQ(2u, getCounter("SQLExecDirect").count);
+}
+
+TEST_F(InfoDiagnosticsTest, firstOccurrenceIsLoggedAndFurtherOnesOncePerInterval) {
+	esl::database::ODBCInfoDiagnostics::setLogInterval(std::chrono::hours(1));
+	execute(*connection, 5);
+
+	esl::database::ODBCInfoDiagnostics::Counter counter = getCounter("SQLExecute");
+	EXPECT_EQ(5u, counter.count);
+	EXPECT_EQ(1u, counter.reportedCount);
+
+	/* the next occurrence after the interval logs the summary of all occurrences since the first one */
+	esl::database::ODBCInfoDiagnostics::setLogInterval(std::chrono::milliseconds(0));
+	execute(*connection, 1);
+
+	counter = getCounter("SQLExecute");
+	EXPECT_EQ(6u, counter.count);
+	EXPECT_EQ(6u, counter.reportedCount);
+}
+
+TEST_F(InfoDiagnosticsTest, logSummaryReportsLastOccurrences) {
+	esl::database::ODBCInfoDiagnostics::setLogInterval(std::chrono::hours(1));
+	execute(*connection, 4);
+	EXPECT_EQ(1u, getCounter("SQLExecute").reportedCount);
+
+	esl::database::ODBCInfoDiagnostics::logSummary();
+
+	esl::database::ODBCInfoDiagnostics::Counter counter = getCounter("SQLExecute");
+	EXPECT_EQ(4u, counter.count);
+	EXPECT_EQ(4u, counter.reportedCount);
+}
+
+TEST_F(InfoDiagnosticsTest, mutedStateIsCountedButNotLogged) {
+	esl::database::ODBCInfoDiagnostics::mute("01004");
+	execute(*connection, 3);
+	esl::database::ODBCInfoDiagnostics::logSummary();
+
+	esl::database::ODBCInfoDiagnostics::Counter counter = getCounter("SQLExecute");
+	EXPECT_EQ(3u, counter.count);
+	EXPECT_EQ(0u, counter.reportedCount);
+}
+
+TEST_F(InfoDiagnosticsTest, concurrentOccurrencesAreCounted) {
+	const std::size_t threadCount = 4;
+	const std::size_t executions = 200;
+
+	std::vector<std::unique_ptr<esl::database::ODBCConnection>> connections;
+	for(std::size_t i = 0; i < threadCount; ++i) {
+		connections.push_back(database->createConnection());
+	}
+
+	std::vector<std::thread> threads;
+	for(std::size_t i = 0; i < threadCount; ++i) {
+		esl::database::ODBCConnection& threadConnection = *connections[i];
+		threads.emplace_back([&threadConnection, executions]() {
+			execute(threadConnection, executions);
+		});
+	}
+	for(auto& thread : threads) {
+		thread.join();
+	}
+
+	EXPECT_EQ(threadCount * executions, getCounter("SQLExecute").count);
+}
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
@@ -0,0 +1,135 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <odbc4esl/test/MockDatabaseTest.h>
+
+#include <esl/database/Field.h>
+#include <esl/database/ODBCCallCounters.h>
+#include <esl/database/ODBCConnection.h>
+#include <esl/database/ODBCLookupBatcher.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+namespace {
+class LookupBatcherTest : public test::MockDatabaseTest {
+protected:
+	LookupBatcherTest()
+	: MockDatabaseTest(test::MockDatabase::Settings{{"call-counters", "true"}})
+	{ }
+
+	/* the batch closes when it is full, so the delay is only reached if a key is missing */
+	std::unique_ptr<esl::database::ODBCLookupBatcher> createBatcher(const std::string& sql, std::size_t maximumBatchSize) {
+		esl::database::ODBCLookupBatcher::Settings settings;
+		settings.maximumBatchSize = maximumBatchSize;
+		settings.maximumDelay = std::chrono::seconds(10);
+		batchConnection = connection.get();
+		return esl::database::ODBCLookupBatcher::create(std::move(connection), sql, 0, settings);
+	}
+
+	std::uint64_t getExecuteCalls() const {
+		return esl::database::ODBCCallCounters::getConnectionCounters(*batchConnection)[esl::database::ODBCCallCounters::Function::execute].calls;
+	}
+
+	/* looks up key i in thread i */
+	struct Lookup {
+		std::vector<std::vector<esl::database::Field>> rows;
+		std::exception_ptr exception;
+	};
+
+	static std::vector<Lookup> lookupConcurrently(esl::database::ODBCLookupBatcher& batcher, std::size_t count) {
+		std::vector<Lookup> lookups(count);
+		std::vector<std::thread> threads;
+		for(std::size_t i = 0; i < count; ++i) {
+			threads.emplace_back([&batcher, &lookups, i] {
+				try {
+					lookups[i].rows = batcher.lookup(esl::database::Field(static_cast<std::int64_t>(i)));
+				}
+				catch(...) {
+					lookups[i].exception = std::current_exception();
+				}
+			});
+		}
+		for(std::thread& thread : threads) {
+			thread.join();
+		}
+		return lookups;
+	}
+
+	esl::database::ODBCConnection* batchConnection = nullptr;
+};
+}
+
+/* the mock driver returns one row per key with the key in every column */
+TEST_F(LookupBatcherTest, concurrentLookupsShareOneExecution) {
+	std::unique_ptr<esl::database::ODBCLookupBatcher> batcher = createBatcher("SELECT echo columns=bigint,varchar(16) FROM t WHERE id IN (?)", 8);
+	std::uint64_t executeCalls = getExecuteCalls();
+
+	std::vector<Lookup> lookups = lookupConcurrently(*batcher, 8);
+	for(std::size_t i = 0; i < lookups.size(); ++i) {
+		ASSERT_FALSE(lookups[i].exception);
+		ASSERT_EQ(1u, lookups[i].rows.size());
+		ASSERT_EQ(2u, lookups[i].rows[0].size());
+		EXPECT_EQ(static_cast<std::int64_t>(i), lookups[i].rows[0][0].asInteger());
+		EXPECT_EQ(std::to_string(i), lookups[i].rows[0][1].asString());
+	}
+	EXPECT_EQ(executeCalls + 1, getExecuteCalls());
+}
+
+TEST_F(LookupBatcherTest, failedBatchThrowsInEveryCaller) {
+	std::unique_ptr<esl::database::ODBCLookupBatcher> batcher = createBatcher("SELECT echo columns=bigint error=HY000 FROM t WHERE id IN (?)", 4);
+
+	std::vector<Lookup> lookups = lookupConcurrently(*batcher, 4);
+	for(const Lookup& lookup : lookups) {
+		EXPECT_TRUE(lookup.exception);
+		EXPECT_TRUE(lookup.rows.empty());
+	}
+}
+
+TEST_F(LookupBatcherTest, nullKey) {
+	std::unique_ptr<esl::database::ODBCLookupBatcher> batcher = createBatcher("SELECT echo columns=bigint FROM t WHERE id IN (?)", 1);
+	std::uint64_t executeCalls = getExecuteCalls();
+
+	EXPECT_TRUE(batcher->lookup(esl::database::Field()).empty());
+	EXPECT_EQ(executeCalls, getExecuteCalls());
+}
+
+/* keys are compared without trailing blanks as values of CHAR(n) columns are padded */
+TEST_F(LookupBatcherTest, keysWithTrailingBlanks) {
+	std::unique_ptr<esl::database::ODBCLookupBatcher> batcher = createBatcher("SELECT echo columns=varchar(16) FROM t WHERE id IN (?)", 1);
+
+	std::vector<std::vector<esl::database::Field>> rows = batcher->lookup(esl::database::Field(std::string("ab  ")));
+	ASSERT_EQ(1u, rows.size());
+	EXPECT_EQ("ab  ", rows[0][0].asString());
+}
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
@@ -0,0 +1,155 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <odbc4esl/test/MockDatabaseTest.h>
+
+#include <esl/database/Field.h>
+#include <esl/database/ODBCConnection.h>
+#include <esl/database/ODBCMetrics.h>
+#include <esl/database/ODBCPreparedBulkStatement.h>
+#include <esl/database/ODBCPreparedStatement.h>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+namespace {
+class MetricsTest : public test::MockDatabaseTest {
+protected:
+	MetricsTest()
+	: MockDatabaseTest(test::MockDatabase::Settings{{"metrics", "true"}})
+	{ }
+
+	void SetUp() override {
+		MockDatabaseTest::SetUp();
+		if(IsSkipped()) {
+			return;
+		}
+		esl::database::ODBCMetrics::reset();
+	}
+
+	void TearDown() override {
+		esl::database::ODBCMetrics::setEnabled(false);
+	}
+
+	/* statement of the snapshot whose fingerprint contains the given marker */
+	static esl::database::ODBCMetrics::Statement getStatement(const std::string& marker) {
+		for(const auto& statement : esl::database::ODBCMetrics::getSnapshot().statements) {
+			if(statement.fingerprint.find(marker) != std::string::npos) {
+				return statement;
+			}
+		}
+		return esl::database::ODBCMetrics::Statement();
+	}
+};
+}
+
+TEST_F(MetricsTest, executionsAreTimed) {
+	std::unique_ptr<esl::database::ODBCPreparedStatement> preparedStatement = connection->prepareODBC("update=1 timedprepared");
+	preparedStatement->execute(std::vector<esl::database::Field>());
+	preparedStatement->execute(std::vector<esl::database::Field>());
+
+	std::unique_ptr<esl::database::ODBCPreparedBulkStatement> bulkStatement = connection->prepareBulkODBC("update=1 timedbulk");
+	bulkStatement->execute(std::vector<esl::database::Field>());
+	EXPECT_TRUE(bulkStatement->tryExecute(std::vector<esl::database::Field>(), false).success);
+
+	connection->executeDirect("update=1 timeddirect");
+
+	EXPECT_EQ(2u, getStatement("timedprepared").execute.count);
+	EXPECT_EQ(2u, getStatement("timedbulk").execute.count);
+	EXPECT_EQ(1u, getStatement("timeddirect").execute.count);
+	EXPECT_EQ(0u, getStatement("timedprepared").errors + getStatement("timedbulk").errors + getStatement("timeddirect").errors);
+}
+
+TEST_F(MetricsTest, failedExecutionsAreCountedAsErrors) {
+	std::unique_ptr<esl::database::ODBCPreparedStatement> preparedStatement = connection->prepareODBC("error=HY000 failedprepared");
+	EXPECT_ANY_THROW(preparedStatement->execute(std::vector<esl::database::Field>()));
+	esl::database::ResultSet resultSet;
+	EXPECT_FALSE(preparedStatement->tryExecute(std::vector<esl::database::Field>(), resultSet, false).success);
+
+	std::unique_ptr<esl::database::ODBCPreparedBulkStatement> bulkStatement = connection->prepareBulkODBC("error=HY000 failedbulk");
+	EXPECT_ANY_THROW(bulkStatement->execute(std::vector<esl::database::Field>()));
+	EXPECT_FALSE(bulkStatement->tryExecute(std::vector<esl::database::Field>(), false).success);
+
+	EXPECT_ANY_THROW(connection->executeDirect("error=HY000 faileddirect"));
+
+	EXPECT_EQ(2u, getStatement("failedprepared").errors);
+	EXPECT_EQ(2u, getStatement("failedbulk").errors);
+	EXPECT_EQ(1u, getStatement("faileddirect").errors);
+	EXPECT_EQ(0u, getStatement("failedprepared").execute.count + getStatement("failedbulk").execute.count + getStatement("faileddirect").execute.count);
+}
+
+TEST_F(MetricsTest, statementsBeyondMaximumShareOverflowBucket) {
+	/* fingerprints replace digits, so the statements are distinguished by letters */
+	for(std::size_t i = 0; i <= esl::database::ODBCMetrics::maximumStatements; ++i) {
+		std::string name = "distinct";
+		for(std::size_t n = i; n > 0; n /= 26) {
+			name += static_cast<char>('a' + n % 26);
+		}
+		connection->executeDirect("update=1 " + name);
+	}
+
+	esl::database::ODBCMetrics::Snapshot snapshot = esl::database::ODBCMetrics::getSnapshot();
+	EXPECT_LE(snapshot.statements.size(), esl::database::ODBCMetrics::maximumStatements + 1);
+	EXPECT_LT(0u, getStatement(esl::database::ODBCMetrics::otherFingerprint).execute.count);
+}
+
+TEST(MetricsExportTest, snapshotAsJSON) {
+	esl::database::ODBCMetrics::Snapshot snapshot;
+	esl::database::ODBCMetrics::Statement statement;
+	statement.fingerprint = "SELECT \"a\"\n";
+	statement.execute.buckets = {1, 2};
+	statement.execute.count = 3;
+	statement.execute.sumNanoseconds = 5000;
+	statement.rows = 7;
+	statement.bytes = 8;
+	statement.errors = 1;
+	snapshot.statements.push_back(statement);
+	snapshot.transactionErrors = 2;
+
+	const std::string empty = R"({"count":0,"sumNanoseconds":0,"p50Microseconds":0,"p99Microseconds":0,"buckets":[]})";
+	EXPECT_EQ(R"({"statements":[{"fingerprint":"SELECT \"a\"\n","prepare":)" + empty
+			+ R"(,"execute":{"count":3,"sumNanoseconds":5000,"p50Microseconds":2,"p99Microseconds":2,"buckets":[1,2]})"
+			+ R"(,"firstRow":)" + empty + R"(,"drain":)" + empty + R"(,"rows":7,"bytes":8,"errors":1}],"commit":)" + empty
+			+ R"(,"rollback":)" + empty + R"(,"transactionErrors":2})", esl::database::ODBCMetrics::getJSON(snapshot));
+}
+
+TEST(MetricsExportTest, snapshotAsText) {
+	esl::database::ODBCMetrics::Snapshot snapshot;
+	esl::database::ODBCMetrics::Statement statement;
+	statement.fingerprint = "SELECT \"a\"\n";
+	statement.execute.buckets = {1, 2};
+	statement.execute.count = 3;
+	statement.rows = 7;
+	snapshot.statements.push_back(statement);
+
+	const std::string text = esl::database::ODBCMetrics::getText(snapshot);
+	EXPECT_NE(std::string::npos, text.find("odbc4esl_statement_execute_seconds_bucket{statement=\"SELECT \\\"a\\\"\\n\",le=\"1e-06\"} 1\n"));
+	EXPECT_NE(std::string::npos, text.find("odbc4esl_statement_execute_seconds_bucket{statement=\"SELECT \\\"a\\\"\\n\",le=\"2e-06\"} 3\n"));
+	EXPECT_NE(std::string::npos, text.find("odbc4esl_statement_rows_total{statement=\"SELECT \\\"a\\\"\\n\"} 7\n"));
+}
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
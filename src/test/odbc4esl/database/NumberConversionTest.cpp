@@ -0,0 +1,82 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <odbc4esl/database/NumberConversion.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <string>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+namespace {
+std::string formatDouble(double value) {
+	char buffer[NumberConversion::maximumLength];
+	return std::string(buffer, NumberConversion::formatDouble(value, buffer));
+}
+
+std::string formatInteger(std::int64_t value) {
+	char buffer[NumberConversion::maximumLength];
+	return std::string(buffer, NumberConversion::formatInteger(value, buffer));
+}
+}
+
+TEST(NumberConversionTest, formatDoubleIsShortest) {
+	EXPECT_EQ("0.1", formatDouble(0.1));
+	EXPECT_EQ("-2.5", formatDouble(-2.5));
+	EXPECT_EQ("100", formatDouble(100.0));
+	EXPECT_EQ("1200", formatDouble(1200.0));
+	EXPECT_EQ("1e+22", formatDouble(1e22));
+	EXPECT_EQ("5e-324", formatDouble(std::numeric_limits<double>::denorm_min()));
+	EXPECT_EQ("0.30000000000000004", formatDouble(0.1 + 0.2));
+}
+
+TEST(NumberConversionTest, formatDoubleReadsBack) {
+	const double values[] = { 1.0 / 3.0, 123456.789, -0.000125, 6.02214076e23, std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest() };
+	for(double value : values) {
+		std::string text = formatDouble(value);
+		double parsed = 0;
+		ASSERT_TRUE(NumberConversion::parseDouble(text.data(), text.data() + text.size(), parsed)) << text;
+		EXPECT_EQ(value, parsed) << text;
+	}
+}
+
+TEST(NumberConversionTest, formatInteger) {
+	EXPECT_EQ("0", formatInteger(0));
+	EXPECT_EQ("-42", formatInteger(-42));
+	EXPECT_EQ("-9223372036854775808", formatInteger(std::numeric_limits<std::int64_t>::min()));
+	EXPECT_EQ("9223372036854775807", formatInteger(std::numeric_limits<std::int64_t>::max()));
+}
+
+TEST(NumberConversionTest, parseInteger) {
+	std::int64_t value = 0;
+	std::string text = " 123 ";
+	EXPECT_TRUE(NumberConversion::parseInteger(text.data(), text.data() + text.size(), value));
+	EXPECT_EQ(123, value);
+
+	text = "12a";
+	EXPECT_FALSE(NumberConversion::parseInteger(text.data(), text.data() + text.size(), value));
+}
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
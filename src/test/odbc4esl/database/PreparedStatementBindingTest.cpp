@@ -0,0 +1,96 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <odbc4esl/test/MockDatabaseTest.h>
+
+#include <esl/database/Field.h>
+#include <esl/database/ODBCConnection.h>
+#include <esl/database/ODBCPreparedStatement.h>
+#include <esl/database/ODBCResultSet.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+namespace {
+class PreparedStatementBindingTest : public test::MockDatabaseTest {
+};
+}
+
+TEST_F(PreparedStatementBindingTest, queryOneReadsFirstRow) {
+	std::unique_ptr<esl::database::ODBCPreparedStatement> statement = connection->prepareODBC("rows=3 columns=bigint,varchar(16)*4");
+	std::vector<esl::database::Field> row(2);
+
+	for(int execution = 0; execution < 2; ++execution) {
+		ASSERT_TRUE(statement->queryOne(std::vector<esl::database::Field>(), row));
+		EXPECT_EQ(0, row[0].asInteger());
+		EXPECT_EQ("0bbb", row[1].asString());
+	}
+
+	std::tuple<std::int64_t, std::string> tuple;
+	ASSERT_TRUE(statement->queryOne(std::vector<esl::database::Field>(), tuple));
+	EXPECT_EQ(0, std::get<0>(tuple));
+	EXPECT_EQ("0bbb", std::get<1>(tuple));
+}
+
+TEST_F(PreparedStatementBindingTest, queryOneWithoutRow) {
+	std::unique_ptr<esl::database::ODBCPreparedStatement> statement = connection->prepareODBC("rows=0 columns=bigint");
+	std::vector<esl::database::Field> row(1);
+	EXPECT_FALSE(statement->queryOne(std::vector<esl::database::Field>(), row));
+}
+
+/* the bound parameters and result columns are reused, every execution reads the value of its own parameter */
+TEST_F(PreparedStatementBindingTest, queryScalarPerParameter) {
+	std::unique_ptr<esl::database::ODBCPreparedStatement> statement = connection->prepareODBC("echo columns=bigint params=bigint WHERE id = ?");
+	std::vector<esl::database::Field> key(1);
+
+	for(std::int64_t id = 40; id < 45; ++id) {
+		key[0] = id;
+		std::int64_t value = 0;
+		ASSERT_TRUE(statement->queryScalar(key, value));
+		EXPECT_EQ(id, value);
+	}
+
+	/* no row for a NULL parameter */
+	key[0] = nullptr;
+	std::int64_t value = 0;
+	EXPECT_FALSE(statement->queryScalar(key, value));
+}
+
+TEST_F(PreparedStatementBindingTest, queryScalarTypeMismatch) {
+	std::unique_ptr<esl::database::ODBCPreparedStatement> statement = connection->prepareODBC("rows=1 columns=bigint");
+	std::string value;
+	EXPECT_ANY_THROW(statement->queryScalar(std::vector<esl::database::Field>(), value));
+
+	/* the cursor has been closed, so the statement can be executed again */
+	std::int64_t integer = 1;
+	EXPECT_TRUE(statement->queryScalar(std::vector<esl::database::Field>(), integer));
+	EXPECT_EQ(0, integer);
+}
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
@@ -0,0 +1,168 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <odbc4esl/test/MockDatabaseTest.h>
+
+#include <esl/database/Field.h>
+#include <esl/database/ODBCCallCounters.h>
+#include <esl/database/ODBCConnection.h>
+#include <esl/database/ODBCPreparedStatement.h>
+#include <esl/database/ODBCProjection.h>
+#include <esl/database/ODBCResultSet.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+namespace {
+class ResultSetBindingTest : public test::MockDatabaseTest {
+protected:
+	ResultSetBindingTest()
+	: MockDatabaseTest(test::MockDatabase::Settings{{"default-buffer-size", "1024"}, {"maximum-buffer-size", "65536"}, {"call-counters", "true"}})
+	{ }
+};
+}
+
+/* Values larger than the bound buffer are read by SQLGetData. After repeated overflows the buffer grows,
+ * so following rows of the same result set are fetched into the bound buffer. */
+TEST_F(ResultSetBindingTest, bufferGrowsAfterRepeatedOverflows) {
+	std::unique_ptr<esl::database::ODBCPreparedStatement> statement = connection->prepareODBC("rows=10 columns=varchar(8192)*4096");
+
+	esl::database::ODBCCallCounters::resetThreadCounters();
+	std::unique_ptr<esl::database::ODBCResultSet> resultSet = statement->executeODBC(std::vector<esl::database::Field>());
+	std::vector<esl::database::Field> row(1);
+	std::size_t rows = 0;
+	while(resultSet->fetch(row)) {
+		std::string expected = std::to_string(rows);
+		expected.resize(4096, 'a');
+		EXPECT_EQ(expected, row[0].asString());
+		++rows;
+	}
+	EXPECT_EQ(10u, rows);
+	EXPECT_EQ(2u, esl::database::ODBCCallCounters::getThreadCounters()[esl::database::ODBCCallCounters::Function::getData].calls);
+}
+
+/* values larger than maximum-buffer-size never fit, so every one of them is read by SQLGetData */
+TEST_F(ResultSetBindingTest, bufferDoesNotGrowBeyondMaximum) {
+	test::MockDatabase smallDatabase(test::MockDatabase::Settings{{"default-buffer-size", "1024"}, {"maximum-buffer-size", "2048"}, {"call-counters", "true"}});
+	std::unique_ptr<esl::database::ODBCConnection> smallConnection = smallDatabase.createConnection();
+	std::unique_ptr<esl::database::ODBCPreparedStatement> statement = smallConnection->prepareODBC("rows=5 columns=varchar(8192)*4096");
+
+	esl::database::ODBCCallCounters::resetThreadCounters();
+	std::unique_ptr<esl::database::ODBCResultSet> resultSet = statement->executeODBC(std::vector<esl::database::Field>());
+	std::vector<esl::database::Field> row(1);
+	std::size_t rows = 0;
+	while(resultSet->fetch(row)) {
+		EXPECT_EQ(4096u, row[0].asString().size());
+		++rows;
+	}
+	EXPECT_EQ(5u, rows);
+	EXPECT_EQ(5u, esl::database::ODBCCallCounters::getThreadCounters()[esl::database::ODBCCallCounters::Function::getData].calls);
+}
+
+/* Values larger than the bound buffer are read by SQLGetData until the buffer grows. The next execution binds
+ * a buffer of the learned size, also if the column is not the first bind result of a projection. */
+TEST_F(ResultSetBindingTest, projectionLearnsBufferSizeOfSelectedColumn) {
+	std::unique_ptr<esl::database::ODBCPreparedStatement> statement = connection->prepareODBC("rows=2 columns=bigint,varchar(8192)*4096");
+	esl::database::ODBCProjection projection;
+	projection.columns.push_back(1);
+
+	for(int execution = 0; execution < 2; ++execution) {
+		esl::database::ODBCCallCounters::resetThreadCounters();
+
+		std::unique_ptr<esl::database::ODBCResultSet> resultSet = statement->executeODBC(std::vector<esl::database::Field>(), projection);
+		std::vector<esl::database::Field> row(2);
+		std::size_t rows = 0;
+		while(resultSet->fetch(row)) {
+			EXPECT_EQ(4096u, row[1].asString().size());
+			++rows;
+		}
+		EXPECT_EQ(2u, rows);
+
+		std::uint64_t getDataCalls = esl::database::ODBCCallCounters::getThreadCounters()[esl::database::ODBCCallCounters::Function::getData].calls;
+		if(execution == 0) {
+			EXPECT_LT(0u, getDataCalls);
+		}
+		else {
+			EXPECT_EQ(0u, getDataCalls);
+		}
+	}
+}
+
+TEST_F(ResultSetBindingTest, nextResultSetSkipsResultsWithoutColumns) {
+	std::unique_ptr<esl::database::ODBCPreparedStatement> statement = connection->prepareODBC("update=1 ; rows=2 columns=bigint ; update=3 ; rows=3 columns=varchar(16)*4,bigint");
+
+	/* the row count of the first statement of the batch is skipped already by executeODBC */
+	std::unique_ptr<esl::database::ODBCResultSet> resultSet = statement->executeODBC(std::vector<esl::database::Field>());
+	ASSERT_TRUE(resultSet != nullptr);
+	ASSERT_EQ(1u, resultSet->getColumns().size());
+
+	std::vector<esl::database::Field> row(1);
+	std::size_t rows = 0;
+	while(resultSet->fetch(row)) {
+		EXPECT_EQ(static_cast<std::int64_t>(rows), row[0].asInteger());
+		++rows;
+	}
+	EXPECT_EQ(2u, rows);
+
+	resultSet = resultSet->nextResultSet();
+	ASSERT_TRUE(resultSet != nullptr);
+	ASSERT_EQ(2u, resultSet->getColumns().size());
+
+	row.resize(2);
+	rows = 0;
+	while(resultSet->fetch(row)) {
+		EXPECT_EQ(4u, row[0].asString().size());
+		EXPECT_EQ(static_cast<std::int64_t>(rows), row[1].asInteger());
+		++rows;
+	}
+	EXPECT_EQ(3u, rows);
+
+	EXPECT_TRUE(resultSet->nextResultSet() == nullptr);
+}
+
+TEST_F(ResultSetBindingTest, nextResultSetDiscardsRemainingRows) {
+	std::unique_ptr<esl::database::ODBCPreparedStatement> statement = connection->prepareODBC("rows=5 columns=bigint ; rows=1 columns=double");
+
+	std::unique_ptr<esl::database::ODBCResultSet> resultSet = statement->executeODBC(std::vector<esl::database::Field>());
+	std::vector<esl::database::Field> row(1);
+	ASSERT_TRUE(resultSet->fetch(row));
+
+	resultSet = resultSet->nextResultSet();
+	ASSERT_TRUE(resultSet != nullptr);
+	ASSERT_TRUE(resultSet->fetch(row));
+	EXPECT_DOUBLE_EQ(0.5, row[0].asDouble());
+	EXPECT_FALSE(resultSet->fetch(row));
+	EXPECT_TRUE(resultSet->nextResultSet() == nullptr);
+
+	/* the statement can be executed again after all results have been read */
+	resultSet = statement->executeODBC(std::vector<esl::database::Field>());
+	ASSERT_TRUE(resultSet != nullptr);
+	EXPECT_TRUE(resultSet->fetch(row));
+}
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
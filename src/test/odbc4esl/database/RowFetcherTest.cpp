@@ -0,0 +1,143 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <odbc4esl/test/MockDatabaseTest.h>
+
+#include <esl/database/Field.h>
+#include <esl/database/ODBCCallCounters.h>
+#include <esl/database/ODBCConnection.h>
+#include <esl/database/ODBCPreparedStatement.h>
+#include <esl/database/ODBCResultSet.h>
+#include <esl/database/ODBCRowFetcher.h>
+#include <esl/database/ODBCRowLayout.h>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+namespace {
+struct Row {
+	std::int64_t id;
+	esl::database::ODBCRowIndicator idIndicator;
+	double value;
+	esl::database::ODBCRowIndicator valueIndicator;
+	char name[16];
+	esl::database::ODBCRowIndicator nameIndicator;
+};
+}
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
+
+namespace esl {
+inline namespace v1_6 {
+namespace database {
+
+template<>
+struct ODBCRowLayout<odbc4esl::database::Row> {
+	static const std::vector<ODBCRowColumn>& getColumns() {
+		static const std::vector<ODBCRowColumn> columns {
+			ODBC4ESL__ROW_COLUMN(odbc4esl::database::Row, id, idIndicator),
+			ODBC4ESL__ROW_COLUMN(odbc4esl::database::Row, value, valueIndicator),
+			ODBC4ESL__ROW_COLUMN(odbc4esl::database::Row, name, nameIndicator)
+		};
+		return columns;
+	}
+};
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace esl */
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace database {
+
+namespace {
+class RowFetcherTest : public test::MockDatabaseTest {
+protected:
+	RowFetcherTest()
+	: MockDatabaseTest(test::MockDatabase::Settings{{"call-counters", "true"}})
+	{ }
+};
+}
+
+/* every batch of fetchAll is written to another position of the vector, it is addressed by the bind offset */
+TEST_F(RowFetcherTest, fetchAllBindsColumnsOnce) {
+	std::unique_ptr<esl::database::ODBCPreparedStatement> statement = connection->prepareODBC("rows=1000 columns=bigint,double,varchar(16)*4");
+	std::unique_ptr<esl::database::ODBCRowFetcher> rowFetcher = statement->executeRows<Row>(std::vector<esl::database::Field>());
+
+	std::vector<Row> rows;
+	rows.reserve(1100);
+
+	esl::database::ODBCCallCounters::resetThreadCounters();
+	EXPECT_EQ(1000u, rowFetcher->fetchAll(rows, 100));
+	EXPECT_EQ(3u, esl::database::ODBCCallCounters::getThreadCounters()[esl::database::ODBCCallCounters::Function::bindCol].calls);
+
+	ASSERT_EQ(1000u, rows.size());
+	for(std::size_t i = 0; i < rows.size(); ++i) {
+		EXPECT_EQ(static_cast<std::int64_t>(i), rows[i].id);
+		EXPECT_DOUBLE_EQ(static_cast<double>(i) + 0.5, rows[i].value);
+		EXPECT_EQ(std::to_string(i), std::string(rows[i].name, std::strspn(rows[i].name, "0123456789")));
+	}
+}
+
+TEST_F(RowFetcherTest, fetchAllIntoGrowingVector) {
+	std::unique_ptr<esl::database::ODBCPreparedStatement> statement = connection->prepareODBC("rows=1000 columns=bigint,double,varchar(16)*4");
+	std::unique_ptr<esl::database::ODBCRowFetcher> rowFetcher = statement->executeRows<Row>(std::vector<esl::database::Field>());
+
+	std::vector<Row> rows;
+	EXPECT_EQ(1000u, rowFetcher->fetchAll(rows, 64));
+	ASSERT_EQ(1000u, rows.size());
+	for(std::size_t i = 0; i < rows.size(); ++i) {
+		EXPECT_EQ(static_cast<std::int64_t>(i), rows[i].id);
+	}
+}
+
+/* row-wise binding attributes must not stay on the pooled handle used by the next statement */
+TEST_F(RowFetcherTest, pooledHandleIsResetForColumnWiseBinding) {
+	{
+		std::unique_ptr<esl::database::ODBCPreparedStatement> statement = connection->prepareODBC("rows=10 columns=bigint,double,varchar(16)");
+		std::unique_ptr<esl::database::ODBCRowFetcher> rowFetcher = statement->executeRows<Row>(std::vector<esl::database::Field>());
+		Row rows[4];
+		EXPECT_EQ(4u, rowFetcher->fetch(rows, 4));
+	}
+
+	std::unique_ptr<esl::database::ODBCResultSet> resultSet = connection->executeDirect("rows=3 columns=bigint");
+	ASSERT_TRUE(resultSet != nullptr);
+	std::vector<esl::database::Field> row(1);
+	std::size_t count = 0;
+	while(resultSet->fetch(row)) {
+		EXPECT_EQ(static_cast<std::int64_t>(count), row[0].asInteger());
+		++count;
+	}
+	EXPECT_EQ(3u, count);
+}
+
+} /* namespace database */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
@@ -0,0 +1,921 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <odbc4esl/mockdriver/Handles.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_set>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace mockdriver {
+
+namespace {
+/* all allocated handles, so freeing a handle twice is detected like the driver manager does */
+std::mutex& getHandlesMutex() {
+	static std::mutex mutex;
+	return mutex;
+}
+
+std::unordered_set<Handle*>& getHandles() {
+	static std::unordered_set<Handle*> handles;
+	return handles;
+}
+
+std::size_t getFixedSize(SQLSMALLINT cType) noexcept {
+	switch(cType) {
+	case SQL_C_SBIGINT:
+	case SQL_C_UBIGINT:
+		return sizeof(std::int64_t);
+	case SQL_C_DOUBLE:
+		return sizeof(double);
+	case SQL_C_LONG:
+	case SQL_C_SLONG:
+		return sizeof(SQLINTEGER);
+	case SQL_C_SHORT:
+	case SQL_C_SSHORT:
+		return sizeof(SQLSMALLINT);
+	default:
+		break;
+	}
+	return 0;
+}
+
+SQLRETURN writeString(const char* str, SQLCHAR* buffer, SQLSMALLINT bufferLength, SQLSMALLINT* length) noexcept {
+	std::size_t size = std::strlen(str);
+	if(length) {
+		*length = static_cast<SQLSMALLINT>(size);
+	}
+	if(buffer && bufferLength > 0) {
+		std::size_t n = std::min(size, static_cast<std::size_t>(bufferLength - 1));
+		std::memcpy(buffer, str, n);
+		buffer[n] = 0;
+		if(n < size) {
+			return SQL_SUCCESS_WITH_INFO;
+		}
+	}
+	return SQL_SUCCESS;
+}
+}
+
+Handle::Handle(Type aType)
+: type(aType)
+{
+	diagnostics.reserve(8);
+
+	std::lock_guard<std::mutex> lock(getHandlesMutex());
+	getHandles().insert(this);
+}
+
+Handle::~Handle() {
+	std::lock_guard<std::mutex> lock(getHandlesMutex());
+	getHandles().erase(this);
+}
+
+Handle* Handle::get(SQLHANDLE sqlHandle, Type type) {
+	Handle* handle = static_cast<Handle*>(sqlHandle);
+
+	std::lock_guard<std::mutex> lock(getHandlesMutex());
+	if(handle == nullptr || getHandles().count(handle) == 0 || handle->type != type) {
+		return nullptr;
+	}
+	return handle;
+}
+
+void Handle::clearDiagnostics() noexcept {
+	diagnostics.clear();
+}
+
+SQLRETURN Handle::addDiagnostic(SQLRETURN rc, const char* state, const char* message) noexcept {
+	if(diagnostics.size() < diagnostics.capacity()) {
+		Diagnostic diagnostic;
+		std::strncpy(diagnostic.state, state, SQL_SQLSTATE_SIZE);
+		diagnostic.state[SQL_SQLSTATE_SIZE] = 0;
+		diagnostic.message = message;
+		diagnostics.push_back(diagnostic);
+	}
+	return rc;
+}
+
+SQLRETURN Handle::getDiagRec(SQLSMALLINT record, SQLCHAR* state, SQLINTEGER* nativeError, SQLCHAR* message, SQLSMALLINT bufferLength, SQLSMALLINT* textLength) const noexcept {
+	if(record < 1) {
+		return SQL_ERROR;
+	}
+	if(static_cast<std::size_t>(record) > diagnostics.size()) {
+		return SQL_NO_DATA;
+	}
+
+	const Diagnostic& diagnostic = diagnostics[record-1];
+	if(state) {
+		std::memcpy(state, diagnostic.state, SQL_SQLSTATE_SIZE + 1);
+	}
+	if(nativeError) {
+		*nativeError = 0;
+	}
+	if(message == nullptr || bufferLength <= 0) {
+		if(textLength) {
+			*textLength = static_cast<SQLSMALLINT>(std::strlen(diagnostic.message));
+		}
+		return SQL_SUCCESS_WITH_INFO;
+	}
+	return writeString(diagnostic.message, message, bufferLength, textLength);
+}
+
+SQLRETURN Handle::getDiagField(SQLSMALLINT record, SQLSMALLINT identifier, SQLPOINTER value, SQLSMALLINT bufferLength, SQLSMALLINT* stringLength) const noexcept {
+	if(record == 0) {
+		switch(identifier) {
+		case SQL_DIAG_NUMBER:
+			if(value) {
+				*static_cast<SQLINTEGER*>(value) = static_cast<SQLINTEGER>(diagnostics.size());
+			}
+			return SQL_SUCCESS;
+		case SQL_DIAG_RETURNCODE:
+			if(value) {
+				*static_cast<SQLRETURN*>(value) = SQL_SUCCESS;
+			}
+			return SQL_SUCCESS;
+		case SQL_DIAG_ROW_COUNT:
+			if(value) {
+				*static_cast<SQLLEN*>(value) = 0;
+			}
+			return SQL_SUCCESS;
+		default:
+			break;
+		}
+		return SQL_ERROR;
+	}
+
+	if(record < 0) {
+		return SQL_ERROR;
+	}
+	if(static_cast<std::size_t>(record) > diagnostics.size()) {
+		return SQL_NO_DATA;
+	}
+
+	const Diagnostic& diagnostic = diagnostics[record-1];
+	switch(identifier) {
+	case SQL_DIAG_SQLSTATE:
+		return writeString(diagnostic.state, static_cast<SQLCHAR*>(value), bufferLength, stringLength);
+	case SQL_DIAG_MESSAGE_TEXT:
+		return writeString(diagnostic.message, static_cast<SQLCHAR*>(value), bufferLength, stringLength);
+	case SQL_DIAG_NATIVE:
+		if(value) {
+			*static_cast<SQLINTEGER*>(value) = 0;
+		}
+		return SQL_SUCCESS;
+	case SQL_DIAG_CLASS_ORIGIN:
+	case SQL_DIAG_SUBCLASS_ORIGIN:
+		return writeString("ISO 9075", static_cast<SQLCHAR*>(value), bufferLength, stringLength);
+	case SQL_DIAG_CONNECTION_NAME:
+	case SQL_DIAG_SERVER_NAME:
+		return writeString("", static_cast<SQLCHAR*>(value), bufferLength, stringLength);
+	case SQL_DIAG_COLUMN_NUMBER:
+	case SQL_DIAG_ROW_NUMBER:
+		if(value) {
+			*static_cast<SQLLEN*>(value) = SQL_NO_ROW_NUMBER;
+		}
+		return SQL_SUCCESS;
+	default:
+		break;
+	}
+	return SQL_ERROR;
+}
+
+Environment::Environment()
+: Handle(Type::environment)
+{ }
+
+Descriptor::Descriptor()
+: Handle(Type::descriptor)
+{ }
+
+Connection::Connection(Environment& aEnvironment)
+: Handle(Type::connection),
+  environment(aEnvironment)
+{ }
+
+Connection::~Connection() {
+	freeStatements();
+}
+
+void Connection::freeStatements() {
+	std::set<Statement*> freedStatements;
+	freedStatements.swap(statements);
+	for(Statement* statement : freedStatements) {
+		delete statement;
+	}
+}
+
+Statement::Statement(Connection& aConnection)
+: Handle(Type::statement),
+  connection(aConnection),
+  cancelled(false)
+{ }
+
+SQLRETURN Statement::prepare(const std::string& sql) {
+	try {
+		spec = StatementSpec::parse(sql);
+	}
+	catch(const std::exception&) {
+		prepared = false;
+		return addDiagnostic(SQL_ERROR, "42000", "Syntax error in mock statement specification");
+	}
+
+	prepared = true;
+	executed = false;
+	positioned = false;
+	if(parameters.size() < spec.parameters.size()) {
+		parameters.resize(spec.parameters.size());
+	}
+	return SQL_SUCCESS;
+}
+
+SQLRETURN Statement::execute() {
+	if(!prepared) {
+		return addDiagnostic(SQL_ERROR, "HY010", "Function sequence error");
+	}
+	/* results without columns do not open a cursor, so they do not have to be closed before the next execution */
+	if(executed && !spec.results[result].columns.empty()) {
+		return addDiagnostic(SQL_ERROR, "24000", "Invalid cursor state");
+	}
+
+	/* a cancel of the previous execution does not affect this one */
+	cancelled = false;
+
+	SQLRETURN rc = readParameters();
+	if(rc != SQL_SUCCESS) {
+		return rc;
+	}
+
+	if(spec.sleep > std::chrono::milliseconds::zero()) {
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		while(std::chrono::steady_clock::now() - start < spec.sleep) {
+			if(cancelled) {
+				return addDiagnostic(SQL_ERROR, "HY008", "Operation canceled");
+			}
+			if(queryTimeout > 0 && std::chrono::steady_clock::now() - start >= std::chrono::seconds(queryTimeout)) {
+				return addDiagnostic(SQL_ERROR, "HYT00", "Timeout expired");
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+
+	if(!spec.error.empty()) {
+		return addDiagnostic(SQL_ERROR, spec.error.c_str(), "Error requested by mock statement specification");
+	}
+
+	executed = true;
+	result = 0;
+	nextRow = 0;
+	positioned = false;
+	getDataColumn = 0;
+
+	if(!spec.info.empty()) {
+		return addDiagnostic(SQL_SUCCESS_WITH_INFO, spec.info.c_str(), "Info requested by mock statement specification");
+	}
+	return SQL_SUCCESS;
+}
+
+SQLRETURN Statement::readParameters() {
+	bool echo = false;
+	for(const ResultSpec& resultSpec : spec.results) {
+		echo = echo || resultSpec.echo;
+	}
+	if(echo) {
+		echoValues.clear();
+	}
+
+	/* every value is read, even if it is not used, so a parameter bound to a buffer that does not exist anymore
+	 * is detected by the address sanitizer */
+	volatile unsigned char checksum = 0;
+	for(std::size_t i = 0; i < spec.parameters.size(); ++i) {
+		const Parameter& parameter = parameters[i];
+		if(!parameter.bound) {
+			return addDiagnostic(SQL_ERROR, "07002", "COUNT field incorrect");
+		}
+		if(parameter.indicator && *parameter.indicator == SQL_NULL_DATA) {
+			continue;
+		}
+
+		const char* data = static_cast<const char*>(parameter.value);
+		std::size_t size = getFixedSize(parameter.cType);
+		if(size == 0) {
+			if(parameter.indicator == nullptr || *parameter.indicator == SQL_NTS) {
+				size = std::strlen(data);
+			}
+			else {
+				size = static_cast<std::size_t>(*parameter.indicator);
+			}
+		}
+		for(std::size_t j = 0; j < size; ++j) {
+			checksum = checksum ^ static_cast<unsigned char>(data[j]);
+		}
+
+		if(!echo) {
+			continue;
+		}
+
+		std::string str;
+		switch(parameter.cType) {
+		case SQL_C_SBIGINT:
+			str = std::to_string(*static_cast<const std::int64_t*>(parameter.value));
+			break;
+		case SQL_C_LONG:
+		case SQL_C_SLONG:
+			str = std::to_string(*static_cast<const SQLINTEGER*>(parameter.value));
+			break;
+		case SQL_C_SHORT:
+		case SQL_C_SSHORT:
+			str = std::to_string(*static_cast<const SQLSMALLINT*>(parameter.value));
+			break;
+		case SQL_C_DOUBLE: {
+			char buffer[32];
+			std::snprintf(buffer, sizeof(buffer), "%.15g", *static_cast<const double*>(parameter.value));
+			str = buffer;
+			break;
+		}
+		default:
+			str.assign(data, size);
+			break;
+		}
+		if(std::find(echoValues.begin(), echoValues.end(), str) == echoValues.end()) {
+			echoValues.push_back(str);
+		}
+	}
+
+	return SQL_SUCCESS;
+}
+
+const std::vector<ColumnSpec>* Statement::getColumns() const noexcept {
+	if(executed) {
+		return &spec.results[result].columns;
+	}
+	if(prepared && spec.describeBeforeExecute && !spec.results.empty()) {
+		return &spec.results[0].columns;
+	}
+	return nullptr;
+}
+
+std::size_t Statement::getRowCount() const noexcept {
+	const ResultSpec& resultSpec = spec.results[result];
+	if(resultSpec.echo) {
+		return echoValues.size();
+	}
+	return resultSpec.rows;
+}
+
+SQLRETURN Statement::numResultCols(SQLSMALLINT* columnCount) {
+	const std::vector<ColumnSpec>* columns = getColumns();
+	if(columnCount) {
+		*columnCount = columns ? static_cast<SQLSMALLINT>(columns->size()) : 0;
+	}
+	return SQL_SUCCESS;
+}
+
+SQLRETURN Statement::describeCol(SQLUSMALLINT column, SQLCHAR* name, SQLSMALLINT bufferLength, SQLSMALLINT* nameLength, SQLSMALLINT* dataType, SQLULEN* columnSize, SQLSMALLINT* decimalDigits, SQLSMALLINT* nullable) {
+	const std::vector<ColumnSpec>* columns = getColumns();
+	if(columns == nullptr || column < 1 || column > columns->size()) {
+		return addDiagnostic(SQL_ERROR, "07009", "Invalid descriptor index");
+	}
+
+	const ColumnSpec& columnSpec = (*columns)[column-1];
+	char columnName[16];
+	std::snprintf(columnName, sizeof(columnName), "c%u", static_cast<unsigned>(column-1));
+	SQLRETURN rc = writeString(columnName, name, bufferLength, nameLength);
+
+	if(dataType) {
+		*dataType = columnSpec.sqlType;
+	}
+	if(columnSize) {
+		*columnSize = columnSpec.size;
+	}
+	if(decimalDigits) {
+		*decimalDigits = 0;
+	}
+	if(nullable) {
+		*nullable = SQL_NULLABLE;
+	}
+	return rc;
+}
+
+SQLRETURN Statement::colAttribute(SQLUSMALLINT column, SQLUSMALLINT field, SQLPOINTER characterAttribute, SQLSMALLINT bufferLength, SQLSMALLINT* stringLength, SQLLEN* numericAttribute) {
+	const std::vector<ColumnSpec>* columns = getColumns();
+	if(columns == nullptr || column < 1 || column > columns->size()) {
+		return addDiagnostic(SQL_ERROR, "07009", "Invalid descriptor index");
+	}
+
+	const ColumnSpec& columnSpec = (*columns)[column-1];
+	SQLLEN numeric = 0;
+	switch(field) {
+	case SQL_DESC_DISPLAY_SIZE:
+		numeric = columnSpec.getDisplaySize();
+		break;
+	case SQL_DESC_CONCISE_TYPE:
+	case SQL_DESC_TYPE:
+		numeric = columnSpec.sqlType;
+		break;
+	case SQL_DESC_LENGTH:
+	case SQL_DESC_OCTET_LENGTH:
+		numeric = static_cast<SQLLEN>(columnSpec.size);
+		break;
+	case SQL_DESC_NULLABLE:
+		numeric = SQL_NULLABLE;
+		break;
+	case SQL_DESC_NAME:
+	case SQL_DESC_LABEL: {
+		char columnName[16];
+		std::snprintf(columnName, sizeof(columnName), "c%u", static_cast<unsigned>(column-1));
+		return writeString(columnName, static_cast<SQLCHAR*>(characterAttribute), bufferLength, stringLength);
+	}
+	default:
+		break;
+	}
+
+	if(numericAttribute) {
+		*numericAttribute = numeric;
+	}
+	return SQL_SUCCESS;
+}
+
+SQLRETURN Statement::numParams(SQLSMALLINT* parameterCount) {
+	if(!prepared) {
+		return addDiagnostic(SQL_ERROR, "HY010", "Function sequence error");
+	}
+	if(parameterCount) {
+		*parameterCount = static_cast<SQLSMALLINT>(spec.parameters.size());
+	}
+	return SQL_SUCCESS;
+}
+
+SQLRETURN Statement::describeParam(SQLUSMALLINT parameter, SQLSMALLINT* dataType, SQLULEN* parameterSize, SQLSMALLINT* decimalDigits, SQLSMALLINT* nullable) {
+	if(!prepared || parameter < 1 || parameter > spec.parameters.size()) {
+		return addDiagnostic(SQL_ERROR, "07009", "Invalid descriptor index");
+	}
+
+	const ColumnSpec& parameterSpec = spec.parameters[parameter-1];
+	if(dataType) {
+		*dataType = parameterSpec.sqlType;
+	}
+	if(parameterSize) {
+		*parameterSize = parameterSpec.size;
+	}
+	if(decimalDigits) {
+		*decimalDigits = 0;
+	}
+	if(nullable) {
+		*nullable = SQL_NULLABLE;
+	}
+	return SQL_SUCCESS;
+}
+
+SQLRETURN Statement::bindParameter(SQLUSMALLINT parameter, SQLSMALLINT cType, SQLSMALLINT /*sqlType*/, SQLPOINTER value, SQLLEN bufferLength, SQLLEN* indicator) {
+	if(parameter < 1) {
+		return addDiagnostic(SQL_ERROR, "07009", "Invalid descriptor index");
+	}
+	if(parameters.size() < parameter) {
+		parameters.resize(parameter);
+	}
+
+	Parameter& binding = parameters[parameter-1];
+	binding.bound = true;
+	binding.cType = cType;
+	binding.value = value;
+	binding.bufferLength = bufferLength;
+	binding.indicator = indicator;
+	return SQL_SUCCESS;
+}
+
+SQLRETURN Statement::bindCol(SQLUSMALLINT column, SQLSMALLINT cType, SQLPOINTER value, SQLLEN bufferLength, SQLLEN* indicator) {
+	if(column < 1) {
+		return addDiagnostic(SQL_ERROR, "07009", "Invalid descriptor index");
+	}
+	if(columnBindings.size() < column) {
+		columnBindings.resize(column);
+	}
+
+	ColumnBinding& binding = columnBindings[column-1];
+	binding.bound = value != nullptr || indicator != nullptr;
+	binding.cType = cType;
+	binding.value = value;
+	binding.bufferLength = bufferLength;
+	binding.indicator = indicator;
+	return SQL_SUCCESS;
+}
+
+void Statement::generate(std::size_t column, std::size_t row) {
+	const ResultSpec& resultSpec = spec.results[result];
+	const ColumnSpec& columnSpec = resultSpec.columns[column];
+
+	value.null = resultSpec.nulls && row % 2 == 1;
+	value.character = columnSpec.isCharacter();
+	value.floatingPoint = columnSpec.sqlType == SQL_DOUBLE;
+	if(value.null) {
+		return;
+	}
+
+	if(resultSpec.echo) {
+		const std::string& echoValue = echoValues[row];
+		value.integer = std::strtoll(echoValue.c_str(), nullptr, 10);
+		value.real = std::strtod(echoValue.c_str(), nullptr);
+		value.text.assign(echoValue);
+		return;
+	}
+
+	if(resultSpec.boundParameters) {
+		value.integer = 0;
+		for(const Parameter& parameter : parameters) {
+			value.integer += parameter.bound ? 1 : 0;
+		}
+		value.real = static_cast<double>(value.integer);
+		value.character = false;
+		value.floatingPoint = false;
+		return;
+	}
+
+	value.integer = static_cast<std::int64_t>(row);
+	value.real = static_cast<double>(row) + 0.5;
+	if(value.character) {
+		int length = std::snprintf(numberBuffer, sizeof(numberBuffer), "%lu", static_cast<unsigned long>(row));
+		value.text.assign(numberBuffer, static_cast<std::size_t>(length));
+		if(value.text.size() < columnSpec.length) {
+			value.text.append(columnSpec.length - value.text.size(), static_cast<char>('a' + column % 26));
+		}
+	}
+}
+
+SQLRETURN Statement::write(SQLSMALLINT cType, char* target, SQLLEN bufferLength, SQLLEN* indicator, std::size_t& offset, bool& truncated) {
+	if(value.null) {
+		if(offset > 0) {
+			return SQL_NO_DATA;
+		}
+		offset = 1;
+		if(indicator == nullptr) {
+			return addDiagnostic(SQL_ERROR, "22002", "Indicator variable required but not supplied");
+		}
+		*indicator = SQL_NULL_DATA;
+		return SQL_SUCCESS;
+	}
+
+	std::size_t fixedSize = getFixedSize(cType);
+	if(fixedSize > 0) {
+		if(offset > 0) {
+			return SQL_NO_DATA;
+		}
+		offset = 1;
+
+		std::int64_t integer = value.integer;
+		double real = value.floatingPoint ? value.real : static_cast<double>(value.integer);
+		if(value.character) {
+			char* end = nullptr;
+			integer = std::strtoll(value.text.c_str(), &end, 10);
+			if(value.text.empty() || *end != 0) {
+				real = std::strtod(value.text.c_str(), &end);
+				if(value.text.empty() || *end != 0) {
+					return addDiagnostic(SQL_ERROR, "22018", "Invalid character value for cast specification");
+				}
+				integer = static_cast<std::int64_t>(real);
+			}
+			else {
+				real = static_cast<double>(integer);
+			}
+		}
+		else if(value.floatingPoint) {
+			integer = static_cast<std::int64_t>(value.real);
+		}
+
+		if(target) {
+			switch(cType) {
+			case SQL_C_DOUBLE:
+				std::memcpy(target, &real, sizeof(real));
+				break;
+			case SQL_C_LONG:
+			case SQL_C_SLONG: {
+				SQLINTEGER i = static_cast<SQLINTEGER>(integer);
+				std::memcpy(target, &i, sizeof(i));
+				break;
+			}
+			case SQL_C_SHORT:
+			case SQL_C_SSHORT: {
+				SQLSMALLINT i = static_cast<SQLSMALLINT>(integer);
+				std::memcpy(target, &i, sizeof(i));
+				break;
+			}
+			default:
+				std::memcpy(target, &integer, sizeof(integer));
+				break;
+			}
+		}
+		if(indicator) {
+			*indicator = static_cast<SQLLEN>(fixedSize);
+		}
+		return SQL_SUCCESS;
+	}
+
+	if(cType != SQL_C_CHAR && cType != SQL_C_BINARY) {
+		return addDiagnostic(SQL_ERROR, "07006", "Restricted data type attribute violation");
+	}
+
+	const char* data;
+	std::size_t size;
+	if(value.character) {
+		data = value.text.data();
+		size = value.text.size();
+	}
+	else {
+		int length = value.floatingPoint
+				? std::snprintf(numberBuffer, sizeof(numberBuffer), "%.15g", value.real)
+				: std::snprintf(numberBuffer, sizeof(numberBuffer), "%lld", static_cast<long long>(value.integer));
+		data = numberBuffer;
+		size = static_cast<std::size_t>(length);
+	}
+	if(maxLength > 0 && size > maxLength) {
+		size = maxLength;
+	}
+
+	/* SQLGetData returns SQL_NO_DATA after the value has been read completely, but an empty value is returned once */
+	if(offset > 0 && offset >= size) {
+		return SQL_NO_DATA;
+	}
+
+	std::size_t remaining = size - std::min(offset, size);
+	if(indicator) {
+		*indicator = static_cast<SQLLEN>(remaining);
+	}
+
+	std::size_t terminatorSize = cType == SQL_C_CHAR ? 1 : 0;
+	std::size_t copied = 0;
+	if(target && bufferLength > static_cast<SQLLEN>(terminatorSize)) {
+		copied = std::min(remaining, static_cast<std::size_t>(bufferLength) - terminatorSize);
+		std::memcpy(target, data + offset, copied);
+		if(terminatorSize) {
+			target[copied] = 0;
+		}
+	}
+	else if(target && bufferLength == 1 && terminatorSize) {
+		target[0] = 0;
+	}
+
+	offset += copied;
+	if(copied < remaining) {
+		truncated = true;
+	}
+	else if(copied == 0) {
+		/* empty value has been returned */
+		offset = std::max<std::size_t>(offset, 1);
+	}
+	return SQL_SUCCESS;
+}
+
+SQLRETURN Statement::fetch() {
+	const std::vector<ColumnSpec>* columns = executed ? getColumns() : nullptr;
+	if(columns == nullptr || columns->empty()) {
+		return addDiagnostic(SQL_ERROR, "24000", "Invalid cursor state");
+	}
+	if(cancelled) {
+		return addDiagnostic(SQL_ERROR, "HY008", "Operation canceled");
+	}
+
+	std::size_t rowCount = getRowCount();
+	std::size_t fetchedRows = std::min<std::size_t>(rowArraySize, rowCount - std::min(nextRow, rowCount));
+
+	if(rowsFetched) {
+		*rowsFetched = fetchedRows;
+	}
+	if(rowStatus) {
+		for(std::size_t i = 0; i < rowArraySize; ++i) {
+			rowStatus[i] = i < fetchedRows ? SQL_ROW_SUCCESS : SQL_ROW_NOROW;
+		}
+	}
+	getDataColumn = 0;
+	if(fetchedRows == 0) {
+		positioned = false;
+		return SQL_NO_DATA;
+	}
+
+	SQLLEN bindOffset = rowBindOffset ? *rowBindOffset : 0;
+	bool truncated = false;
+	for(std::size_t column = 0; column < columns->size() && column < columnBindings.size(); ++column) {
+		const ColumnBinding& binding = columnBindings[column];
+		if(!binding.bound) {
+			continue;
+		}
+
+		std::size_t elementSize = getFixedSize(binding.cType);
+		if(elementSize == 0) {
+			elementSize = static_cast<std::size_t>(binding.bufferLength);
+		}
+
+		for(std::size_t i = 0; i < fetchedRows; ++i) {
+			char* target = binding.value ? static_cast<char*>(binding.value) + bindOffset : nullptr;
+			char* indicator = binding.indicator ? reinterpret_cast<char*>(binding.indicator) + bindOffset : nullptr;
+			if(rowBindType == SQL_BIND_BY_COLUMN) {
+				target = target ? target + i * elementSize : nullptr;
+				indicator = indicator ? indicator + i * sizeof(SQLLEN) : nullptr;
+			}
+			else {
+				target = target ? target + i * rowBindType : nullptr;
+				indicator = indicator ? indicator + i * rowBindType : nullptr;
+			}
+
+			generate(column, nextRow + i);
+			std::size_t offset = 0;
+			SQLRETURN rc = write(binding.cType, target, binding.bufferLength, reinterpret_cast<SQLLEN*>(indicator), offset, truncated);
+			if(rc == SQL_ERROR) {
+				return rc;
+			}
+		}
+	}
+
+	currentRow = nextRow;
+	nextRow += fetchedRows;
+	positioned = true;
+
+	if(truncated) {
+		return addDiagnostic(SQL_SUCCESS_WITH_INFO, "01004", "String data, right truncated");
+	}
+	return SQL_SUCCESS;
+}
+
+SQLRETURN Statement::getData(SQLUSMALLINT column, SQLSMALLINT cType, SQLPOINTER target, SQLLEN bufferLength, SQLLEN* indicator) {
+	const std::vector<ColumnSpec>* columns = executed ? getColumns() : nullptr;
+	if(columns == nullptr || !positioned) {
+		return addDiagnostic(SQL_ERROR, "24000", "Invalid cursor state");
+	}
+	if(column < 1 || column > columns->size()) {
+		return addDiagnostic(SQL_ERROR, "07009", "Invalid descriptor index");
+	}
+
+	if(getDataColumn != column) {
+		getDataColumn = column;
+		getDataOffset = 0;
+	}
+
+	generate(column-1, currentRow);
+	bool truncated = false;
+	SQLRETURN rc = write(cType, static_cast<char*>(target), bufferLength, indicator, getDataOffset, truncated);
+	if(rc == SQL_SUCCESS && truncated) {
+		return addDiagnostic(SQL_SUCCESS_WITH_INFO, "01004", "String data, right truncated");
+	}
+	return rc;
+}
+
+SQLRETURN Statement::moreResults() {
+	if(!executed) {
+		return SQL_NO_DATA;
+	}
+
+	positioned = false;
+	getDataColumn = 0;
+	if(result + 1 >= spec.results.size()) {
+		executed = false;
+		return SQL_NO_DATA;
+	}
+
+	++result;
+	nextRow = 0;
+	return SQL_SUCCESS;
+}
+
+SQLRETURN Statement::rowCount(SQLLEN* count) {
+	if(!executed) {
+		return addDiagnostic(SQL_ERROR, "HY010", "Function sequence error");
+	}
+	if(count) {
+		*count = spec.results[result].rowCount;
+	}
+	return SQL_SUCCESS;
+}
+
+SQLRETURN Statement::freeStmt(SQLUSMALLINT option) {
+	switch(option) {
+	case SQL_CLOSE:
+		executed = false;
+		positioned = false;
+		return SQL_SUCCESS;
+	case SQL_UNBIND:
+		for(ColumnBinding& binding : columnBindings) {
+			binding = ColumnBinding();
+		}
+		return SQL_SUCCESS;
+	case SQL_RESET_PARAMS:
+		for(Parameter& parameter : parameters) {
+			parameter = Parameter();
+		}
+		return SQL_SUCCESS;
+	default:
+		break;
+	}
+	return addDiagnostic(SQL_ERROR, "HY092", "Invalid attribute/option identifier");
+}
+
+SQLRETURN Statement::closeCursor() {
+	if(!executed) {
+		return addDiagnostic(SQL_ERROR, "24000", "Invalid cursor state");
+	}
+	executed = false;
+	positioned = false;
+	return SQL_SUCCESS;
+}
+
+SQLRETURN Statement::setAttr(SQLINTEGER attribute, SQLPOINTER attributeValue) {
+	SQLULEN number = static_cast<SQLULEN>(reinterpret_cast<std::uintptr_t>(attributeValue));
+	switch(attribute) {
+	case SQL_ATTR_QUERY_TIMEOUT:
+		queryTimeout = number;
+		return SQL_SUCCESS;
+	case SQL_ATTR_MAX_LENGTH:
+		maxLength = number;
+		return SQL_SUCCESS;
+	case SQL_ATTR_ROW_ARRAY_SIZE:
+		if(number == 0) {
+			return addDiagnostic(SQL_ERROR, "HY024", "Invalid attribute value");
+		}
+		rowArraySize = number;
+		return SQL_SUCCESS;
+	case SQL_ATTR_ROW_BIND_TYPE:
+		rowBindType = number;
+		return SQL_SUCCESS;
+	case SQL_ATTR_ROWS_FETCHED_PTR:
+		rowsFetched = static_cast<SQLULEN*>(attributeValue);
+		return SQL_SUCCESS;
+	case SQL_ATTR_ROW_STATUS_PTR:
+		rowStatus = static_cast<SQLUSMALLINT*>(attributeValue);
+		return SQL_SUCCESS;
+	case SQL_ATTR_ROW_BIND_OFFSET_PTR:
+		rowBindOffset = static_cast<SQLLEN*>(attributeValue);
+		return SQL_SUCCESS;
+	default:
+		break;
+	}
+	return SQL_SUCCESS;
+}
+
+SQLRETURN Statement::getAttr(SQLINTEGER attribute, SQLPOINTER attributeValue) {
+	if(attributeValue == nullptr) {
+		return SQL_SUCCESS;
+	}
+
+	switch(attribute) {
+	case SQL_ATTR_APP_ROW_DESC:
+	case SQL_ATTR_APP_PARAM_DESC:
+	case SQL_ATTR_IMP_ROW_DESC:
+	case SQL_ATTR_IMP_PARAM_DESC:
+		*static_cast<SQLHANDLE*>(attributeValue) = &descriptors[attribute - SQL_ATTR_APP_ROW_DESC];
+		return SQL_SUCCESS;
+	case SQL_ATTR_QUERY_TIMEOUT:
+		*static_cast<SQLULEN*>(attributeValue) = queryTimeout;
+		return SQL_SUCCESS;
+	case SQL_ATTR_MAX_LENGTH:
+		*static_cast<SQLULEN*>(attributeValue) = maxLength;
+		return SQL_SUCCESS;
+	case SQL_ATTR_ROW_ARRAY_SIZE:
+		*static_cast<SQLULEN*>(attributeValue) = rowArraySize;
+		return SQL_SUCCESS;
+	case SQL_ATTR_ROW_BIND_TYPE:
+		*static_cast<SQLULEN*>(attributeValue) = rowBindType;
+		return SQL_SUCCESS;
+	case SQL_ATTR_ROWS_FETCHED_PTR:
+		*static_cast<SQLULEN**>(attributeValue) = rowsFetched;
+		return SQL_SUCCESS;
+	case SQL_ATTR_ROW_STATUS_PTR:
+		*static_cast<SQLUSMALLINT**>(attributeValue) = rowStatus;
+		return SQL_SUCCESS;
+	case SQL_ATTR_ROW_BIND_OFFSET_PTR:
+		*static_cast<SQLLEN**>(attributeValue) = rowBindOffset;
+		return SQL_SUCCESS;
+	default:
+		break;
+	}
+	*static_cast<SQLULEN*>(attributeValue) = 0;
+	return SQL_SUCCESS;
+}
+
+void Statement::cancel() noexcept {
+	cancelled = true;
+}
+
+} /* namespace mockdriver */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
@@ -0,0 +1,199 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ODBC4ESL_MOCKDRIVER_HANDLES_H_
+#define ODBC4ESL_MOCKDRIVER_HANDLES_H_
+
+#include <odbc4esl/mockdriver/Spec.h>
+
+#include <sqlext.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace mockdriver {
+
+class Connection;
+
+/* Base of all handles of the mock driver. Diagnostics are kept in fixed size records, so adding one does not allocate. */
+class Handle {
+public:
+	enum class Type {
+		environment,
+		connection,
+		statement,
+		descriptor
+	};
+
+	Handle(Type type);
+	virtual ~Handle();
+
+	Handle(const Handle&) = delete;
+	Handle& operator=(const Handle&) = delete;
+
+	/* Returns the handle if it has been allocated by the mock driver, is not freed yet and has the given type */
+	static Handle* get(SQLHANDLE handle, Type type);
+
+	void clearDiagnostics() noexcept;
+
+	/* message has to be a string literal. Returns rc. */
+	SQLRETURN addDiagnostic(SQLRETURN rc, const char* state, const char* message) noexcept;
+
+	SQLRETURN getDiagRec(SQLSMALLINT record, SQLCHAR* state, SQLINTEGER* nativeError, SQLCHAR* message, SQLSMALLINT bufferLength, SQLSMALLINT* textLength) const noexcept;
+	SQLRETURN getDiagField(SQLSMALLINT record, SQLSMALLINT identifier, SQLPOINTER value, SQLSMALLINT bufferLength, SQLSMALLINT* stringLength) const noexcept;
+
+	const Type type;
+
+private:
+	struct Diagnostic {
+		char state[SQL_SQLSTATE_SIZE + 1];
+		const char* message;
+	};
+
+	std::vector<Diagnostic> diagnostics;
+};
+
+class Environment : public Handle {
+public:
+	Environment();
+
+	SQLINTEGER odbcVersion = SQL_OV_ODBC3;
+};
+
+class Descriptor : public Handle {
+public:
+	Descriptor();
+};
+
+class Statement : public Handle {
+public:
+	Statement(Connection& connection);
+
+	SQLRETURN prepare(const std::string& sql);
+	SQLRETURN execute();
+	SQLRETURN numResultCols(SQLSMALLINT* columnCount);
+	SQLRETURN describeCol(SQLUSMALLINT column, SQLCHAR* name, SQLSMALLINT bufferLength, SQLSMALLINT* nameLength, SQLSMALLINT* dataType, SQLULEN* columnSize, SQLSMALLINT* decimalDigits, SQLSMALLINT* nullable);
+	SQLRETURN colAttribute(SQLUSMALLINT column, SQLUSMALLINT field, SQLPOINTER characterAttribute, SQLSMALLINT bufferLength, SQLSMALLINT* stringLength, SQLLEN* numericAttribute);
+	SQLRETURN numParams(SQLSMALLINT* parameterCount);
+	SQLRETURN describeParam(SQLUSMALLINT parameter, SQLSMALLINT* dataType, SQLULEN* parameterSize, SQLSMALLINT* decimalDigits, SQLSMALLINT* nullable);
+	SQLRETURN bindParameter(SQLUSMALLINT parameter, SQLSMALLINT cType, SQLSMALLINT sqlType, SQLPOINTER value, SQLLEN bufferLength, SQLLEN* indicator);
+	SQLRETURN bindCol(SQLUSMALLINT column, SQLSMALLINT cType, SQLPOINTER value, SQLLEN bufferLength, SQLLEN* indicator);
+	SQLRETURN fetch();
+	SQLRETURN getData(SQLUSMALLINT column, SQLSMALLINT cType, SQLPOINTER value, SQLLEN bufferLength, SQLLEN* indicator);
+	SQLRETURN moreResults();
+	SQLRETURN rowCount(SQLLEN* count);
+	SQLRETURN freeStmt(SQLUSMALLINT option);
+	SQLRETURN closeCursor();
+	SQLRETURN setAttr(SQLINTEGER attribute, SQLPOINTER value);
+	SQLRETURN getAttr(SQLINTEGER attribute, SQLPOINTER value);
+
+	/* called by another thread while execute() sleeps or between fetches */
+	void cancel() noexcept;
+
+	Connection& connection;
+
+private:
+	struct Parameter {
+		bool bound = false;
+		SQLSMALLINT cType = 0;
+		SQLPOINTER value = nullptr;
+		SQLLEN bufferLength = 0;
+		SQLLEN* indicator = nullptr;
+	};
+
+	struct ColumnBinding {
+		bool bound = false;
+		SQLSMALLINT cType = 0;
+		SQLPOINTER value = nullptr;
+		SQLLEN bufferLength = 0;
+		SQLLEN* indicator = nullptr;
+	};
+
+	/* generated value of a column, reused for every value to avoid allocations */
+	struct Value {
+		bool null = false;
+		bool character = false;
+		bool floatingPoint = false;
+		std::int64_t integer = 0;
+		double real = 0.0;
+		std::string text;
+	};
+
+	const std::vector<ColumnSpec>* getColumns() const noexcept;
+	std::size_t getRowCount() const noexcept;
+	SQLRETURN readParameters();
+	void generate(std::size_t column, std::size_t row);
+	SQLRETURN write(SQLSMALLINT cType, char* target, SQLLEN bufferLength, SQLLEN* indicator, std::size_t& offset, bool& truncated);
+
+	Descriptor descriptors[4];
+
+	StatementSpec spec;
+	bool prepared = false;
+	std::vector<Parameter> parameters;
+	std::vector<ColumnBinding> columnBindings;
+	std::vector<std::string> echoValues;
+
+	SQLULEN queryTimeout = 0;
+	SQLULEN maxLength = 0;
+	SQLULEN rowArraySize = 1;
+	SQLULEN rowBindType = SQL_BIND_BY_COLUMN;
+	SQLULEN* rowsFetched = nullptr;
+	SQLUSMALLINT* rowStatus = nullptr;
+	SQLLEN* rowBindOffset = nullptr;
+
+	/* cursor */
+	bool executed = false;
+	std::size_t result = 0;
+	std::size_t nextRow = 0;
+	std::size_t currentRow = 0;
+	bool positioned = false;
+
+	/* state of SQLGetData for reading a value in parts */
+	SQLUSMALLINT getDataColumn = 0;
+	std::size_t getDataOffset = 0;
+
+	Value value;
+	char numberBuffer[32];
+	std::atomic<bool> cancelled;
+};
+
+class Connection : public Handle {
+public:
+	Connection(Environment& environment);
+	~Connection();
+
+	/* frees all statements as the driver manager does on SQLDisconnect */
+	void freeStatements();
+
+	Environment& environment;
+	bool connected = false;
+	SQLULEN autocommit = SQL_AUTOCOMMIT_ON;
+	std::set<Statement*> statements;
+};
+
+} /* namespace mockdriver */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
+
+#endif /* ODBC4ESL_MOCKDRIVER_HANDLES_H_ */
@@ -0,0 +1,444 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* ODBC entry points of the mock driver. The shared library is loaded by the driver manager with a connection
+ * string like "DRIVER=/path/to/libodbc4esl-mockdriver.so", see Spec.h for the statements it understands.
+ * Entry points never call each other, because the driver manager exports functions with the same names. */
+
+#include <odbc4esl/mockdriver/Handles.h>
+
+#include <sqlext.h>
+
+#include <cstring>
+#include <exception>
+#include <new>
+#include <string>
+
+using odbc4esl::mockdriver::Connection;
+using odbc4esl::mockdriver::Descriptor;
+using odbc4esl::mockdriver::Environment;
+using odbc4esl::mockdriver::Handle;
+using odbc4esl::mockdriver::Statement;
+
+namespace {
+bool toType(SQLSMALLINT handleType, Handle::Type& type) {
+	switch(handleType) {
+	case SQL_HANDLE_ENV:
+		type = Handle::Type::environment;
+		return true;
+	case SQL_HANDLE_DBC:
+		type = Handle::Type::connection;
+		return true;
+	case SQL_HANDLE_STMT:
+		type = Handle::Type::statement;
+		return true;
+	case SQL_HANDLE_DESC:
+		type = Handle::Type::descriptor;
+		return true;
+	default:
+		break;
+	}
+	return false;
+}
+
+std::string toString(SQLCHAR* str, SQLINTEGER length) {
+	if(str == nullptr) {
+		return std::string();
+	}
+	if(length == SQL_NTS) {
+		return std::string(reinterpret_cast<const char*>(str));
+	}
+	return std::string(reinterpret_cast<const char*>(str), static_cast<std::size_t>(length));
+}
+
+/* Validates the handle, clears its diagnostics and calls the function. Exceptions must not leave the driver. */
+template<typename T, typename Function>
+SQLRETURN call(SQLHANDLE sqlHandle, Handle::Type type, Function function) {
+	Handle* handle = Handle::get(sqlHandle, type);
+	if(handle == nullptr) {
+		return SQL_INVALID_HANDLE;
+	}
+	handle->clearDiagnostics();
+
+	try {
+		return function(static_cast<T&>(*handle));
+	}
+	catch(const std::bad_alloc&) {
+		return handle->addDiagnostic(SQL_ERROR, "HY001", "Memory allocation error");
+	}
+	catch(const std::exception&) {
+		return handle->addDiagnostic(SQL_ERROR, "HY000", "General error");
+	}
+}
+
+SQLRETURN freeHandle(SQLSMALLINT handleType, SQLHANDLE sqlHandle) {
+	Handle::Type type;
+	if(!toType(handleType, type)) {
+		return SQL_ERROR;
+	}
+	Handle* handle = Handle::get(sqlHandle, type);
+	if(handle == nullptr) {
+		return SQL_INVALID_HANDLE;
+	}
+
+	if(type == Handle::Type::statement) {
+		Statement* statement = static_cast<Statement*>(handle);
+		statement->connection.statements.erase(statement);
+	}
+	delete handle;
+	return SQL_SUCCESS;
+}
+
+SQLRETURN writeInfoString(const char* str, SQLPOINTER value, SQLSMALLINT bufferLength, SQLSMALLINT* stringLength) {
+	std::size_t size = std::strlen(str);
+	if(stringLength) {
+		*stringLength = static_cast<SQLSMALLINT>(size);
+	}
+	if(value && bufferLength > 0) {
+		std::size_t n = std::min(size, static_cast<std::size_t>(bufferLength - 1));
+		std::memcpy(value, str, n);
+		static_cast<char*>(value)[n] = 0;
+		if(n < size) {
+			return SQL_SUCCESS_WITH_INFO;
+		}
+	}
+	return SQL_SUCCESS;
+}
+
+template<typename T>
+SQLRETURN writeInfoNumber(T number, SQLPOINTER value, SQLSMALLINT* stringLength) {
+	if(value) {
+		*static_cast<T*>(value) = number;
+	}
+	if(stringLength) {
+		*stringLength = sizeof(T);
+	}
+	return SQL_SUCCESS;
+}
+}
+
+extern "C" {
+
+SQLRETURN SQL_API SQLAllocHandle(SQLSMALLINT handleType, SQLHANDLE inputHandle, SQLHANDLE* outputHandle) {
+	if(outputHandle == nullptr) {
+		return SQL_ERROR;
+	}
+	*outputHandle = SQL_NULL_HANDLE;
+
+	try {
+		switch(handleType) {
+		case SQL_HANDLE_ENV:
+			*outputHandle = new Environment;
+			return SQL_SUCCESS;
+		case SQL_HANDLE_DBC:
+			return call<Environment>(inputHandle, Handle::Type::environment, [outputHandle](Environment& environment) -> SQLRETURN {
+				*outputHandle = new Connection(environment);
+				return SQL_SUCCESS;
+			});
+		case SQL_HANDLE_STMT:
+			return call<Connection>(inputHandle, Handle::Type::connection, [outputHandle](Connection& connection) -> SQLRETURN {
+				if(!connection.connected) {
+					return connection.addDiagnostic(SQL_ERROR, "08003", "Connection not open");
+				}
+				Statement* statement = new Statement(connection);
+				connection.statements.insert(statement);
+				*outputHandle = statement;
+				return SQL_SUCCESS;
+			});
+		case SQL_HANDLE_DESC:
+			return call<Connection>(inputHandle, Handle::Type::connection, [outputHandle](Connection&) -> SQLRETURN {
+				*outputHandle = new Descriptor;
+				return SQL_SUCCESS;
+			});
+		default:
+			break;
+		}
+	}
+	catch(const std::exception&) {
+	}
+	return SQL_ERROR;
+}
+
+SQLRETURN SQL_API SQLFreeHandle(SQLSMALLINT handleType, SQLHANDLE sqlHandle) {
+	return freeHandle(handleType, sqlHandle);
+}
+
+SQLRETURN SQL_API SQLFreeStmt(SQLHSTMT statementHandle, SQLUSMALLINT option) {
+	if(option == SQL_DROP) {
+		return freeHandle(SQL_HANDLE_STMT, statementHandle);
+	}
+	return call<Statement>(statementHandle, Handle::Type::statement, [option](Statement& statement) -> SQLRETURN {
+		return statement.freeStmt(option);
+	});
+}
+
+SQLRETURN SQL_API SQLSetEnvAttr(SQLHENV environmentHandle, SQLINTEGER attribute, SQLPOINTER value, SQLINTEGER /*stringLength*/) {
+	return call<Environment>(environmentHandle, Handle::Type::environment, [attribute, value](Environment& environment) -> SQLRETURN {
+		if(attribute == SQL_ATTR_ODBC_VERSION) {
+			environment.odbcVersion = static_cast<SQLINTEGER>(reinterpret_cast<std::uintptr_t>(value));
+		}
+		return SQL_SUCCESS;
+	});
+}
+
+SQLRETURN SQL_API SQLGetEnvAttr(SQLHENV environmentHandle, SQLINTEGER attribute, SQLPOINTER value, SQLINTEGER /*bufferLength*/, SQLINTEGER* stringLength) {
+	return call<Environment>(environmentHandle, Handle::Type::environment, [attribute, value, stringLength](Environment& environment) -> SQLRETURN {
+		if(value) {
+			*static_cast<SQLINTEGER*>(value) = attribute == SQL_ATTR_ODBC_VERSION ? environment.odbcVersion : 0;
+		}
+		if(stringLength) {
+			*stringLength = sizeof(SQLINTEGER);
+		}
+		return SQL_SUCCESS;
+	});
+}
+
+SQLRETURN SQL_API SQLSetConnectAttr(SQLHDBC connectionHandle, SQLINTEGER attribute, SQLPOINTER value, SQLINTEGER /*stringLength*/) {
+	return call<Connection>(connectionHandle, Handle::Type::connection, [attribute, value](Connection& connection) -> SQLRETURN {
+		if(attribute == SQL_ATTR_AUTOCOMMIT) {
+			connection.autocommit = static_cast<SQLULEN>(reinterpret_cast<std::uintptr_t>(value));
+		}
+		return SQL_SUCCESS;
+	});
+}
+
+SQLRETURN SQL_API SQLGetConnectAttr(SQLHDBC connectionHandle, SQLINTEGER attribute, SQLPOINTER value, SQLINTEGER /*bufferLength*/, SQLINTEGER* stringLength) {
+	return call<Connection>(connectionHandle, Handle::Type::connection, [attribute, value, stringLength](Connection& connection) -> SQLRETURN {
+		if(value) {
+			*static_cast<SQLUINTEGER*>(value) = attribute == SQL_ATTR_AUTOCOMMIT ? static_cast<SQLUINTEGER>(connection.autocommit) : 0;
+		}
+		if(stringLength) {
+			*stringLength = sizeof(SQLUINTEGER);
+		}
+		return SQL_SUCCESS;
+	});
+}
+
+SQLRETURN SQL_API SQLDriverConnect(SQLHDBC connectionHandle, SQLHWND /*windowHandle*/, SQLCHAR* inConnectionString, SQLSMALLINT inLength,
+		SQLCHAR* outConnectionString, SQLSMALLINT outBufferLength, SQLSMALLINT* outLength, SQLUSMALLINT /*driverCompletion*/) {
+	return call<Connection>(connectionHandle, Handle::Type::connection,
+			[inConnectionString, inLength, outConnectionString, outBufferLength, outLength](Connection& connection) -> SQLRETURN {
+		if(connection.connected) {
+			return connection.addDiagnostic(SQL_ERROR, "08002", "Connection name in use");
+		}
+		std::string connectionString = toString(inConnectionString, inLength);
+		connection.connected = true;
+		return writeInfoString(connectionString.c_str(), outConnectionString, outBufferLength, outLength);
+	});
+}
+
+SQLRETURN SQL_API SQLDisconnect(SQLHDBC connectionHandle) {
+	return call<Connection>(connectionHandle, Handle::Type::connection, [](Connection& connection) -> SQLRETURN {
+		if(!connection.connected) {
+			return connection.addDiagnostic(SQL_ERROR, "08003", "Connection not open");
+		}
+		connection.freeStatements();
+		connection.connected = false;
+		return SQL_SUCCESS;
+	});
+}
+
+SQLRETURN SQL_API SQLEndTran(SQLSMALLINT handleType, SQLHANDLE sqlHandle, SQLSMALLINT /*completionType*/) {
+	Handle::Type type;
+	if(!toType(handleType, type) || Handle::get(sqlHandle, type) == nullptr) {
+		return SQL_INVALID_HANDLE;
+	}
+	return SQL_SUCCESS;
+}
+
+SQLRETURN SQL_API SQLGetInfo(SQLHDBC connectionHandle, SQLUSMALLINT infoType, SQLPOINTER value, SQLSMALLINT bufferLength, SQLSMALLINT* stringLength) {
+	return call<Connection>(connectionHandle, Handle::Type::connection, [=](Connection& connection) -> SQLRETURN {
+		switch(infoType) {
+		case SQL_DRIVER_ODBC_VER:
+			return writeInfoString("03.80", value, bufferLength, stringLength);
+		case SQL_DRIVER_NAME:
+			return writeInfoString("libodbc4esl-mockdriver.so", value, bufferLength, stringLength);
+		case SQL_DRIVER_VER:
+			return writeInfoString("01.06.0000", value, bufferLength, stringLength);
+		case SQL_DBMS_NAME:
+			return writeInfoString("odbc4esl mock", value, bufferLength, stringLength);
+		case SQL_DBMS_VER:
+			return writeInfoString("01.06.0000", value, bufferLength, stringLength);
+		case SQL_CURSOR_COMMIT_BEHAVIOR:
+		case SQL_CURSOR_ROLLBACK_BEHAVIOR:
+			return writeInfoNumber<SQLUSMALLINT>(SQL_CB_PRESERVE, value, stringLength);
+		case SQL_GETDATA_EXTENSIONS:
+			return writeInfoNumber<SQLUINTEGER>(SQL_GD_ANY_COLUMN | SQL_GD_ANY_ORDER | SQL_GD_BOUND, value, stringLength);
+		default:
+			break;
+		}
+		return connection.addDiagnostic(SQL_ERROR, "HY096", "Information type out of range");
+	});
+}
+
+SQLRETURN SQL_API SQLGetDiagRec(SQLSMALLINT handleType, SQLHANDLE sqlHandle, SQLSMALLINT record, SQLCHAR* state, SQLINTEGER* nativeError,
+		SQLCHAR* message, SQLSMALLINT bufferLength, SQLSMALLINT* textLength) {
+	Handle::Type type;
+	if(!toType(handleType, type)) {
+		return SQL_ERROR;
+	}
+	Handle* handle = Handle::get(sqlHandle, type);
+	if(handle == nullptr) {
+		return SQL_INVALID_HANDLE;
+	}
+	return handle->getDiagRec(record, state, nativeError, message, bufferLength, textLength);
+}
+
+SQLRETURN SQL_API SQLGetDiagField(SQLSMALLINT handleType, SQLHANDLE sqlHandle, SQLSMALLINT record, SQLSMALLINT identifier,
+		SQLPOINTER value, SQLSMALLINT bufferLength, SQLSMALLINT* stringLength) {
+	Handle::Type type;
+	if(!toType(handleType, type)) {
+		return SQL_ERROR;
+	}
+	Handle* handle = Handle::get(sqlHandle, type);
+	if(handle == nullptr) {
+		return SQL_INVALID_HANDLE;
+	}
+	return handle->getDiagField(record, identifier, value, bufferLength, stringLength);
+}
+
+SQLRETURN SQL_API SQLPrepare(SQLHSTMT statementHandle, SQLCHAR* statementText, SQLINTEGER textLength) {
+	return call<Statement>(statementHandle, Handle::Type::statement, [statementText, textLength](Statement& statement) -> SQLRETURN {
+		return statement.prepare(toString(statementText, textLength));
+	});
+}
+
+SQLRETURN SQL_API SQLExecute(SQLHSTMT statementHandle) {
+	return call<Statement>(statementHandle, Handle::Type::statement, [](Statement& statement) -> SQLRETURN {
+		return statement.execute();
+	});
+}
+
+SQLRETURN SQL_API SQLExecDirect(SQLHSTMT statementHandle, SQLCHAR* statementText, SQLINTEGER textLength) {
+	return call<Statement>(statementHandle, Handle::Type::statement, [statementText, textLength](Statement& statement) -> SQLRETURN {
+		SQLRETURN rc = statement.prepare(toString(statementText, textLength));
+		if(rc != SQL_SUCCESS) {
+			return rc;
+		}
+		return statement.execute();
+	});
+}
+
+SQLRETURN SQL_API SQLNumResultCols(SQLHSTMT statementHandle, SQLSMALLINT* columnCount) {
+	return call<Statement>(statementHandle, Handle::Type::statement, [columnCount](Statement& statement) -> SQLRETURN {
+		return statement.numResultCols(columnCount);
+	});
+}
+
+SQLRETURN SQL_API SQLNumParams(SQLHSTMT statementHandle, SQLSMALLINT* parameterCount) {
+	return call<Statement>(statementHandle, Handle::Type::statement, [parameterCount](Statement& statement) -> SQLRETURN {
+		return statement.numParams(parameterCount);
+	});
+}
+
+SQLRETURN SQL_API SQLDescribeCol(SQLHSTMT statementHandle, SQLUSMALLINT column, SQLCHAR* name, SQLSMALLINT bufferLength, SQLSMALLINT* nameLength,
+		SQLSMALLINT* dataType, SQLULEN* columnSize, SQLSMALLINT* decimalDigits, SQLSMALLINT* nullable) {
+	return call<Statement>(statementHandle, Handle::Type::statement, [=](Statement& statement) -> SQLRETURN {
+		return statement.describeCol(column, name, bufferLength, nameLength, dataType, columnSize, decimalDigits, nullable);
+	});
+}
+
+SQLRETURN SQL_API SQLColAttribute(SQLHSTMT statementHandle, SQLUSMALLINT column, SQLUSMALLINT field, SQLPOINTER characterAttribute,
+		SQLSMALLINT bufferLength, SQLSMALLINT* stringLength, SQLLEN* numericAttribute) {
+	return call<Statement>(statementHandle, Handle::Type::statement, [=](Statement& statement) -> SQLRETURN {
+		return statement.colAttribute(column, field, characterAttribute, bufferLength, stringLength, numericAttribute);
+	});
+}
+
+SQLRETURN SQL_API SQLDescribeParam(SQLHSTMT statementHandle, SQLUSMALLINT parameter, SQLSMALLINT* dataType, SQLULEN* parameterSize,
+		SQLSMALLINT* decimalDigits, SQLSMALLINT* nullable) {
+	return call<Statement>(statementHandle, Handle::Type::statement, [=](Statement& statement) -> SQLRETURN {
+		return statement.describeParam(parameter, dataType, parameterSize, decimalDigits, nullable);
+	});
+}
+
+SQLRETURN SQL_API SQLBindParameter(SQLHSTMT statementHandle, SQLUSMALLINT parameter, SQLSMALLINT /*inputOutputType*/, SQLSMALLINT cType,
+		SQLSMALLINT sqlType, SQLULEN /*columnSize*/, SQLSMALLINT /*decimalDigits*/, SQLPOINTER value, SQLLEN bufferLength, SQLLEN* indicator) {
+	return call<Statement>(statementHandle, Handle::Type::statement, [=](Statement& statement) -> SQLRETURN {
+		return statement.bindParameter(parameter, cType, sqlType, value, bufferLength, indicator);
+	});
+}
+
+SQLRETURN SQL_API SQLBindCol(SQLHSTMT statementHandle, SQLUSMALLINT column, SQLSMALLINT cType, SQLPOINTER value, SQLLEN bufferLength, SQLLEN* indicator) {
+	return call<Statement>(statementHandle, Handle::Type::statement, [=](Statement& statement) -> SQLRETURN {
+		return statement.bindCol(column, cType, value, bufferLength, indicator);
+	});
+}
+
+SQLRETURN SQL_API SQLFetch(SQLHSTMT statementHandle) {
+	return call<Statement>(statementHandle, Handle::Type::statement, [](Statement& statement) -> SQLRETURN {
+		return statement.fetch();
+	});
+}
+
+SQLRETURN SQL_API SQLFetchScroll(SQLHSTMT statementHandle, SQLSMALLINT fetchOrientation, SQLLEN /*fetchOffset*/) {
+	return call<Statement>(statementHandle, Handle::Type::statement, [fetchOrientation](Statement& statement) -> SQLRETURN {
+		if(fetchOrientation != SQL_FETCH_NEXT) {
+			return statement.addDiagnostic(SQL_ERROR, "HY106", "Fetch type out of range");
+		}
+		return statement.fetch();
+	});
+}
+
+SQLRETURN SQL_API SQLGetData(SQLHSTMT statementHandle, SQLUSMALLINT column, SQLSMALLINT cType, SQLPOINTER value, SQLLEN bufferLength, SQLLEN* indicator) {
+	return call<Statement>(statementHandle, Handle::Type::statement, [=](Statement& statement) -> SQLRETURN {
+		return statement.getData(column, cType, value, bufferLength, indicator);
+	});
+}
+
+SQLRETURN SQL_API SQLMoreResults(SQLHSTMT statementHandle) {
+	return call<Statement>(statementHandle, Handle::Type::statement, [](Statement& statement) -> SQLRETURN {
+		return statement.moreResults();
+	});
+}
+
+SQLRETURN SQL_API SQLRowCount(SQLHSTMT statementHandle, SQLLEN* count) {
+	return call<Statement>(statementHandle, Handle::Type::statement, [count](Statement& statement) -> SQLRETURN {
+		return statement.rowCount(count);
+	});
+}
+
+SQLRETURN SQL_API SQLCloseCursor(SQLHSTMT statementHandle) {
+	return call<Statement>(statementHandle, Handle::Type::statement, [](Statement& statement) -> SQLRETURN {
+		return statement.closeCursor();
+	});
+}
+
+SQLRETURN SQL_API SQLSetStmtAttr(SQLHSTMT statementHandle, SQLINTEGER attribute, SQLPOINTER value, SQLINTEGER /*stringLength*/) {
+	return call<Statement>(statementHandle, Handle::Type::statement, [attribute, value](Statement& statement) -> SQLRETURN {
+		return statement.setAttr(attribute, value);
+	});
+}
+
+SQLRETURN SQL_API SQLGetStmtAttr(SQLHSTMT statementHandle, SQLINTEGER attribute, SQLPOINTER value, SQLINTEGER /*bufferLength*/, SQLINTEGER* /*stringLength*/) {
+	return call<Statement>(statementHandle, Handle::Type::statement, [attribute, value](Statement& statement) -> SQLRETURN {
+		return statement.getAttr(attribute, value);
+	});
+}
+
+/* SQLCancel is called from another thread while the statement executes, so its diagnostics are not touched */
+SQLRETURN SQL_API SQLCancel(SQLHSTMT statementHandle) {
+	Handle* handle = Handle::get(statementHandle, Handle::Type::statement);
+	if(handle == nullptr) {
+		return SQL_INVALID_HANDLE;
+	}
+	static_cast<Statement*>(handle)->cancel();
+	return SQL_SUCCESS;
+}
+
+} /* extern "C" */
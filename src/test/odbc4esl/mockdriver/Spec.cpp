@@ -0,0 +1,251 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <odbc4esl/mockdriver/Spec.h>
+
+#include <cstdlib>
+#include <stdexcept>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace mockdriver {
+
+namespace {
+std::vector<std::string> split(const std::string& str, char separator) {
+	std::vector<std::string> parts;
+	std::string::size_type begin = 0;
+	while(true) {
+		std::string::size_type end = str.find(separator, begin);
+		parts.push_back(str.substr(begin, end == std::string::npos ? std::string::npos : end - begin));
+		if(end == std::string::npos) {
+			break;
+		}
+		begin = end + 1;
+	}
+	return parts;
+}
+
+std::vector<std::string> tokenize(const std::string& str) {
+	std::vector<std::string> tokens;
+	std::string token;
+	for(char c : str) {
+		if(c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+			if(!token.empty()) {
+				tokens.push_back(token);
+				token.clear();
+			}
+		}
+		else {
+			token += c;
+		}
+	}
+	if(!token.empty()) {
+		tokens.push_back(token);
+	}
+	return tokens;
+}
+
+std::size_t toSize(const std::string& str) {
+	char* end = nullptr;
+	unsigned long long value = std::strtoull(str.c_str(), &end, 10);
+	if(str.empty() || *end != 0) {
+		throw std::runtime_error("invalid number \"" + str + "\"");
+	}
+	return static_cast<std::size_t>(value);
+}
+
+/* type[(size)][*length] */
+ColumnSpec parseColumn(const std::string& str) {
+	std::string type = str;
+	std::size_t length = 0;
+	bool hasLength = false;
+	SQLULEN size = 0;
+	bool hasSize = false;
+
+	std::string::size_type pos = type.find('*');
+	if(pos != std::string::npos) {
+		length = toSize(type.substr(pos + 1));
+		hasLength = true;
+		type = type.substr(0, pos);
+	}
+	pos = type.find('(');
+	if(pos != std::string::npos && type.back() == ')') {
+		size = static_cast<SQLULEN>(toSize(type.substr(pos + 1, type.size() - pos - 2)));
+		hasSize = true;
+		type = type.substr(0, pos);
+	}
+
+	ColumnSpec column;
+	if(type == "integer") {
+		column = ColumnSpec{SQL_INTEGER, 10, 0};
+	}
+	else if(type == "bigint") {
+		column = ColumnSpec{SQL_BIGINT, 19, 0};
+	}
+	else if(type == "smallint") {
+		column = ColumnSpec{SQL_SMALLINT, 5, 0};
+	}
+	else if(type == "double") {
+		column = ColumnSpec{SQL_DOUBLE, 15, 0};
+	}
+	else if(type == "varchar") {
+		column = ColumnSpec{SQL_VARCHAR, hasSize ? size : 255, 0};
+	}
+	else if(type == "longvarchar") {
+		column = ColumnSpec{SQL_LONGVARCHAR, hasSize ? size : 1048576, 0};
+	}
+	else if(type == "binary") {
+		column = ColumnSpec{SQL_BINARY, hasSize ? size : 16, 0};
+	}
+	else {
+		throw std::runtime_error("unknown type \"" + type + "\"");
+	}
+
+	if(hasLength) {
+		column.length = length;
+	}
+	return column;
+}
+
+std::vector<ColumnSpec> parseColumns(const std::string& str) {
+	/* split at ',' that are not inside of parentheses */
+	std::vector<ColumnSpec> columns;
+	std::string column;
+	int depth = 0;
+	for(char c : str) {
+		if(c == ',' && depth == 0) {
+			columns.push_back(parseColumn(column));
+			column.clear();
+			continue;
+		}
+		if(c == '(') {
+			++depth;
+		}
+		else if(c == ')') {
+			--depth;
+		}
+		column += c;
+	}
+	if(!column.empty()) {
+		columns.push_back(parseColumn(column));
+	}
+	return columns;
+}
+}
+
+bool ColumnSpec::isCharacter() const noexcept {
+	return sqlType == SQL_VARCHAR || sqlType == SQL_LONGVARCHAR || sqlType == SQL_BINARY;
+}
+
+SQLLEN ColumnSpec::getDisplaySize() const noexcept {
+	switch(sqlType) {
+	case SQL_INTEGER:
+		return 11;
+	case SQL_BIGINT:
+		return 20;
+	case SQL_SMALLINT:
+		return 6;
+	case SQL_DOUBLE:
+		return 24;
+	case SQL_BINARY:
+		return static_cast<SQLLEN>(size * 2);
+	default:
+		break;
+	}
+	return static_cast<SQLLEN>(size);
+}
+
+StatementSpec StatementSpec::parse(const std::string& sql) {
+	StatementSpec spec;
+
+	std::size_t parameterCount = 0;
+	for(char c : sql) {
+		if(c == '?') {
+			++parameterCount;
+		}
+	}
+
+	for(const std::string& resultStr : split(sql, ';')) {
+		ResultSpec result;
+		bool hasColumns = false;
+
+		for(const std::string& token : tokenize(resultStr)) {
+			std::string::size_type pos = token.find('=');
+			std::string key = token.substr(0, pos);
+			std::string value = pos == std::string::npos ? std::string() : token.substr(pos + 1);
+
+			if(key == "rows" && pos != std::string::npos) {
+				result.rows = toSize(value);
+			}
+			else if(key == "columns" && pos != std::string::npos) {
+				result.columns = parseColumns(value);
+				hasColumns = true;
+			}
+			else if(key == "update" && pos != std::string::npos) {
+				result.rowCount = static_cast<SQLLEN>(toSize(value));
+			}
+			else if(key == "echo") {
+				result.echo = true;
+			}
+			else if(key == "boundparams") {
+				result.boundParameters = true;
+				result.rows = 1;
+			}
+			else if(key == "nulls") {
+				result.nulls = true;
+			}
+			else if(key == "params" && pos != std::string::npos) {
+				spec.parameters = parseColumns(value);
+			}
+			else if(key == "sleep" && pos != std::string::npos) {
+				spec.sleep = std::chrono::milliseconds(toSize(value));
+			}
+			else if(key == "error" && pos != std::string::npos) {
+				spec.error = value;
+			}
+			else if(key == "info" && pos != std::string::npos) {
+				spec.info = value;
+			}
+			else if(key == "nodescribe") {
+				spec.describeBeforeExecute = false;
+			}
+		}
+
+		if(!hasColumns) {
+			if(result.echo || result.boundParameters || result.rows > 0) {
+				result.columns.push_back(ColumnSpec{SQL_BIGINT, 19, 0});
+			}
+			else if(result.rowCount < 0) {
+				/* nothing after the last ';' */
+				if(!spec.results.empty() && resultStr.find_first_not_of(" \t\r\n") == std::string::npos) {
+					continue;
+				}
+				result.rowCount = 0;
+			}
+		}
+		spec.results.push_back(result);
+	}
+
+	spec.parameters.resize(parameterCount, ColumnSpec{SQL_VARCHAR, 255, 0});
+
+	return spec;
+}
+
+} /* namespace mockdriver */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
@@ -0,0 +1,97 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ODBC4ESL_MOCKDRIVER_SPEC_H_
+#define ODBC4ESL_MOCKDRIVER_SPEC_H_
+
+#include <sqlext.h>
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace mockdriver {
+
+/* The mock driver has no data. The SQL text of a statement specifies the shape of its results instead, e.g.
+ *
+ *     rows=1000 columns=bigint,double,varchar(64)*16 ; update=3
+ *
+ * Results are separated by ';'. Every result consists of "key=value" tokens, other tokens are ignored,
+ * so a specification can be embedded into real SQL like "SELECT echo columns=bigint FROM t WHERE id IN (?)".
+ *
+ *   rows=N          number of rows of the result (default 0)
+ *   columns=T,...   column types: integer, bigint, smallint, double, varchar, longvarchar, binary.
+ *                   varchar(S)*L has column size S and values of at least L characters.
+ *                   Columns are named c0, c1, ... Value of row r is r for integer types, r+0.5 for double
+ *                   and the decimal digits of r padded by 'a'+column for character types.
+ *   update=N        result without columns and N as row count
+ *   echo            one row per distinct non-NULL parameter value of the execution, every column has this value
+ *   boundparams     one bigint row with the number of parameters bound to the statement at the time of the fetch
+ *   nulls           every second row has NULL in all columns
+ *
+ * Tokens for the whole statement:
+ *
+ *   params=T,...    types of the parameters as for columns. Every '?' is a parameter, default type is varchar(255).
+ *   sleep=MS        SQLExecute and SQLExecDirect take MS milliseconds. They fail with HY008 if they are cancelled
+ *                   and with HYT00 if the query timeout expires.
+ *                   Independent of sleep, SQLFetch fails with HY008 after SQLCancel until the next execution.
+ *   error=STATE     SQLExecute and SQLExecDirect fail with the given SQLSTATE
+ *   info=STATE      SQLExecute and SQLExecDirect return SQL_SUCCESS_WITH_INFO with the given SQLSTATE
+ *   nodescribe      result columns are described only after execution
+ */
+struct ColumnSpec {
+	SQLSMALLINT sqlType;
+
+	/* column size reported by SQLDescribeCol */
+	SQLULEN size;
+
+	/* minimum length of generated character values */
+	std::size_t length;
+
+	bool isCharacter() const noexcept;
+	SQLLEN getDisplaySize() const noexcept;
+};
+
+struct ResultSpec {
+	std::vector<ColumnSpec> columns;
+	std::size_t rows = 0;
+	SQLLEN rowCount = -1;
+	bool echo = false;
+	bool boundParameters = false;
+	bool nulls = false;
+};
+
+struct StatementSpec {
+	static StatementSpec parse(const std::string& sql);
+
+	std::vector<ResultSpec> results;
+	std::vector<ColumnSpec> parameters;
+	std::chrono::milliseconds sleep = std::chrono::milliseconds::zero();
+	std::string error;
+	std::string info;
+	bool describeBeforeExecute = true;
+};
+
+} /* namespace mockdriver */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
+
+#endif /* ODBC4ESL_MOCKDRIVER_SPEC_H_ */
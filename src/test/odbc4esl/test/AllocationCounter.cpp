@@ -0,0 +1,104 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <odbc4esl/test/AllocationCounter.h>
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+/* trivial type, so it needs no dynamic initialization and can be used by operator new of any thread at any time */
+thread_local std::uint64_t threadAllocations = 0;
+
+void* allocate(std::size_t size) {
+	++threadAllocations;
+	void* memory = std::malloc(size == 0 ? 1 : size);
+	if(memory == nullptr) {
+		throw std::bad_alloc();
+	}
+	return memory;
+}
+}
+
+void* operator new(std::size_t size) {
+	return allocate(size);
+}
+
+void* operator new[](std::size_t size) {
+	return allocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+	++threadAllocations;
+	return std::malloc(size == 0 ? 1 : size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+	++threadAllocations;
+	return std::malloc(size == 0 ? 1 : size);
+}
+
+void operator delete(void* memory) noexcept {
+	std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+	std::free(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept {
+	std::free(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept {
+	std::free(memory);
+}
+
+/* The sized overloads are replaced even if this file is compiled without sized deallocation (e.g. C++11),
+ * because the standard library and gtest may be compiled with it and call them for memory of operator new above. */
+void operator delete(void* memory, std::size_t) noexcept {
+	std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept {
+	std::free(memory);
+}
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace test {
+
+AllocationCounter::AllocationCounter() noexcept
+: start(threadAllocations)
+{ }
+
+std::uint64_t AllocationCounter::getAllocations() const noexcept {
+	return threadAllocations - start;
+}
+
+void AllocationCounter::reset() noexcept {
+	start = threadAllocations;
+}
+
+std::uint64_t AllocationCounter::getThreadAllocations() noexcept {
+	return threadAllocations;
+}
+
+} /* namespace test */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
@@ -0,0 +1,48 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ODBC4ESL_TEST_ALLOCATIONCOUNTER_H_
+#define ODBC4ESL_TEST_ALLOCATIONCOUNTER_H_
+
+#include <cstdint>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace test {
+
+/* Counts calls of the global operator new by the current thread since construction.
+ * AllocationCounter.cpp replaces the global operator new, so it has to be linked into the executable. */
+class AllocationCounter {
+public:
+	AllocationCounter() noexcept;
+
+	std::uint64_t getAllocations() const noexcept;
+	void reset() noexcept;
+
+	/* allocations of the current thread since it has been started */
+	static std::uint64_t getThreadAllocations() noexcept;
+
+private:
+	std::uint64_t start;
+};
+
+} /* namespace test */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
+
+#endif /* ODBC4ESL_TEST_ALLOCATIONCOUNTER_H_ */
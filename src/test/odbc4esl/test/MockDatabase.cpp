@@ -0,0 +1,73 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <odbc4esl/test/MockDatabase.h>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace test {
+
+namespace {
+MockDatabase::Settings createSettings(const MockDatabase::Settings& settings) {
+	MockDatabase::Settings result;
+	if(MockDatabase::isAvailable()) {
+		result.emplace_back("connection-string", MockDatabase::getConnectionString());
+	}
+	bool hasMetrics = false;
+	for(const auto& setting : settings) {
+		hasMetrics = hasMetrics || setting.first == "metrics";
+	}
+	if(!hasMetrics) {
+		result.emplace_back("metrics", "false");
+	}
+	result.insert(result.end(), settings.begin(), settings.end());
+	return result;
+}
+}
+
+MockDatabase::MockDatabase(const Settings& settings)
+: connectionFactory(esl::database::ODBCConnectionFactory::Settings(createSettings(settings)))
+{ }
+
+bool MockDatabase::isAvailable() noexcept {
+#ifdef ODBC4ESL_MOCK_DRIVER
+	return true;
+#else
+	return false;
+#endif
+}
+
+std::string MockDatabase::getConnectionString() {
+#ifdef ODBC4ESL_MOCK_DRIVER
+	return "DRIVER=" ODBC4ESL_MOCK_DRIVER;
+#else
+	return "";
+#endif
+}
+
+std::unique_ptr<esl::database::ODBCConnection> MockDatabase::createConnection() {
+	return connectionFactory.createODBCConnection();
+}
+
+esl::database::ODBCConnectionFactory& MockDatabase::getConnectionFactory() noexcept {
+	return connectionFactory;
+}
+
+} /* namespace test */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
@@ -0,0 +1,62 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ODBC4ESL_TEST_MOCKDATABASE_H_
+#define ODBC4ESL_TEST_MOCKDATABASE_H_
+
+#include <esl/database/ODBCConnection.h>
+#include <esl/database/ODBCConnectionFactory.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace test {
+
+/* Connection factory for the mock driver of src/test/odbc4esl/mockdriver, see its Spec.h for the SQL it understands.
+ * Metrics are disabled unless settings enable them, so tests do not depend on the global statement map. */
+class MockDatabase {
+public:
+	using Settings = std::vector<std::pair<std::string, std::string>>;
+
+	/* settings are added to the settings of the connection factory, e.g. buffer sizes */
+	explicit MockDatabase(const Settings& settings = Settings());
+
+	/* false if the mock driver is not built for this platform. Tests are skipped in this case. */
+	static bool isAvailable() noexcept;
+
+	/* "DRIVER=..." of the mock driver, e.g. for a connection factory without the defaults of MockDatabase */
+	static std::string getConnectionString();
+
+	std::unique_ptr<esl::database::ODBCConnection> createConnection();
+
+	/* e.g. for an ODBCExecutor that creates the connections of its workers */
+	esl::database::ODBCConnectionFactory& getConnectionFactory() noexcept;
+
+private:
+	esl::database::ODBCConnectionFactory connectionFactory;
+};
+
+} /* namespace test */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
+
+#endif /* ODBC4ESL_TEST_MOCKDATABASE_H_ */
@@ -0,0 +1,39 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <odbc4esl/test/MockDatabaseTest.h>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace test {
+
+MockDatabaseTest::MockDatabaseTest(const MockDatabase::Settings& aSettings)
+: settings(aSettings)
+{ }
+
+void MockDatabaseTest::SetUp() {
+	if(!MockDatabase::isAvailable()) {
+		GTEST_SKIP() << "mock driver is not available";
+	}
+	database.reset(new MockDatabase(settings));
+	connection = database->createConnection();
+}
+
+} /* namespace test */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
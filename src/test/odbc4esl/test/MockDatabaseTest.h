@@ -0,0 +1,53 @@
+/*
+ * This file is part of odbc4esl.
+ * Copyright (C) 2020-2023 Sven Lukas
+ *
+ * Odbc4esl is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Odbc4esl is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser Public License
+ * along with mhd4esl.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ODBC4ESL_TEST_MOCKDATABASETEST_H_
+#define ODBC4ESL_TEST_MOCKDATABASETEST_H_
+
+#include <odbc4esl/test/MockDatabase.h>
+
+#include <esl/database/ODBCConnection.h>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+namespace odbc4esl {
+inline namespace v1_6 {
+namespace test {
+
+/* Fixture of tests against the mock driver, they are skipped if the mock driver is not available.
+ * Fixtures with their own SetUp() call MockDatabaseTest::SetUp() first and return if IsSkipped(). */
+class MockDatabaseTest : public ::testing::Test {
+protected:
+	explicit MockDatabaseTest(const MockDatabase::Settings& settings = MockDatabase::Settings());
+
+	void SetUp() override;
+
+	std::unique_ptr<MockDatabase> database;
+	std::unique_ptr<esl::database::ODBCConnection> connection;
+
+private:
+	MockDatabase::Settings settings;
+};
+
+} /* namespace test */
+} /* inline namespace v1_6 */
+} /* namespace odbc4esl */
+
+#endif /* ODBC4ESL_TEST_MOCKDATABASETEST_H_ */